@@ -0,0 +1,154 @@
+#include "BarAggregator.h"
+#include <cstdlib>
+
+bool BarSpec::parse(const std::string& text, BarSpec& out)
+{
+    char* unit = nullptr;
+    const double value = std::strtod(text.c_str(), &unit);
+    if (unit == text.c_str() || !(value > 0.0)) {
+        return false;
+    }
+    const std::string suffix(unit);
+    if (suffix == "ms" || suffix == "s" || suffix == "m" || suffix == "h") {
+        const double scale = suffix == "ms" ? 1.0 : suffix == "s" ? 1000.0 : suffix == "m" ? 60000.0 : 3600000.0;
+        out.type = BarType::TIME;
+        out.size = value * scale;
+        if (out.size < 1.0) {
+            return false;
+        }
+    } else if (suffix == "t") {
+        out.type = BarType::TICK;
+        out.size = value;
+    } else if (suffix == "v") {
+        out.type = BarType::VOLUME;
+        out.size = value;
+    } else {
+        return false;
+    }
+    out.name = text;
+    return true;
+}
+
+BarSeries::BarSeries(const BarSpec& spec, size_t history)
+    : spec_(&spec),
+      closed_(history),
+      intervalMs_(static_cast<long long>(spec.size))
+{
+}
+
+void BarSeries::start(const TradeData& tick)
+{
+    open_.openTimeMs = spec_->type == BarType::TIME
+        ? tick.timestamp_ms_ - ((tick.timestamp_ms_ % intervalMs_) + intervalMs_) % intervalMs_
+        : tick.timestamp_ms_;
+    open_.closeTimeMs = tick.timestamp_ms_;
+    open_.open = open_.high = open_.low = open_.close = tick.price_;
+    open_.volume = tick.volume_;
+    open_.ticks = 1;
+}
+
+bool BarSeries::update(const TradeData& tick)
+{
+    if (!hasOpen()) {
+        start(tick);
+    } else if (spec_->type == BarType::TIME && tick.timestamp_ms_ >= open_.openTimeMs + intervalMs_) {
+        // First tick of a later interval: it completes the open bar and starts the next one.
+        // Late ticks (earlier timestamps) stay in the open bar.
+        closed_.push_back(open_);
+        start(tick);
+        return true;
+    } else {
+        open_.high = tick.price_ > open_.high ? tick.price_ : open_.high;
+        open_.low = tick.price_ < open_.low ? tick.price_ : open_.low;
+        open_.close = tick.price_;
+        open_.closeTimeMs = tick.timestamp_ms_;
+        open_.volume += tick.volume_;
+        ++open_.ticks;
+    }
+
+    if ((spec_->type == BarType::TICK && open_.ticks >= spec_->size) ||
+        (spec_->type == BarType::VOLUME && open_.volume >= spec_->size))
+    {
+        closed_.push_back(open_);
+        open_.ticks = 0;
+        return true;
+    }
+    return false;
+}
+
+void BarAggregator::configure(const std::vector<BarSpec>& specs, size_t history)
+{
+    specs_ = specs;
+    history_ = history;
+    symbols_.assign(MAX_SYMBOLS, {});
+    handlers_.assign(specs_.size(), {});
+}
+
+int BarAggregator::find(const std::string& name) const
+{
+    for (size_t i = 0; i < specs_.size(); ++i) {
+        if (specs_[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+size_t BarAggregator::add(const BarSpec& spec)
+{
+    const int existing = find(spec.name);
+    if (existing >= 0) {
+        return static_cast<size_t>(existing);
+    }
+    specs_.push_back(spec);
+    handlers_.emplace_back();
+    return specs_.size() - 1;
+}
+
+void BarAggregator::subscribe(size_t series, BarHandler handler)
+{
+    if (series < handlers_.size()) {
+        handlers_[series].push_back(std::move(handler));
+    }
+}
+
+size_t BarAggregator::onTick(const TradeData& tick)
+{
+    if (specs_.empty() || tick.symbol_ >= MAX_SYMBOLS) {
+        return 0;
+    }
+    std::vector<BarSeries>& series = symbols_[tick.symbol_];
+    if (series.empty()) {
+        series.reserve(specs_.size());
+        for (const BarSpec& spec : specs_) {
+            series.emplace_back(spec, history_);
+        }
+    }
+    size_t completed = 0;
+    for (size_t i = 0; i < series.size(); ++i) {
+        if (series[i].update(tick)) {
+            ++completed;
+            for (const BarHandler& handler : handlers_[i]) {
+                handler(tick.symbol_, series[i]);
+            }
+        }
+    }
+    return completed;
+}
+
+void BarAggregator::discardOpen(SymbolId symbol)
+{
+    if (symbol < symbols_.size()) {
+        for (BarSeries& series : symbols_[symbol]) {
+            series.discardOpen();
+        }
+    }
+}
+
+const BarSeries* BarAggregator::series(SymbolId symbol, size_t index) const
+{
+    if (symbol >= symbols_.size() || index >= symbols_[symbol].size()) {
+        return nullptr;
+    }
+    return &symbols_[symbol][index];
+}
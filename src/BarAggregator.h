@@ -0,0 +1,103 @@
+#ifndef BAR_AGGREGATOR_H
+#define BAR_AGGREGATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Types.h"
+
+enum class BarType : uint8_t
+{
+    TIME,       // Fixed interval of tick time, aligned to the epoch
+    TICK,       // Fixed number of ticks
+    VOLUME      // Closes on the tick that brings the volume to the threshold
+};
+
+struct BarSpec
+{
+    BarType type = BarType::TIME;
+    double size = 60000.0;      // Milliseconds, ticks or volume, by type
+    std::string name;           // As configured: "1s", "5m", "100t", "2.5v"
+
+    // "<n>ms", "<n>s", "<n>m", "<n>h" (time), "<n>t" (ticks) or "<n>v" (volume)
+    static bool parse(const std::string& text, BarSpec& out);
+};
+
+/**
+ * @class BarSeries
+ * @brief One symbol's bars of one BarSpec: the open bar plus a ring of completed ones.
+ *
+ * update() is O(1) per tick. A time bar closes when the first tick of a later interval
+ * arrives (intervals without ticks produce no bar); tick and volume bars close on the
+ * tick that completes them.
+ */
+class BarSeries
+{
+public:
+    BarSeries(const BarSpec& spec, size_t history);
+
+    // Returns true if a bar was completed; it is then closed().back()
+    bool update(const TradeData& tick);
+
+    // Drops the open bar, e.g. when ticks were lost; completed bars are kept
+    void discardOpen() { open_.ticks = 0; }
+
+    const BarSpec& spec() const { return *spec_; }
+    const BarWindow& closed() const { return closed_; }
+    // Only meaningful while hasOpen()
+    const Bar& open() const { return open_; }
+    bool hasOpen() const { return open_.ticks > 0; }
+
+private:
+    void start(const TradeData& tick);
+
+    const BarSpec* spec_;
+    BarWindow closed_;
+    Bar open_;
+    long long intervalMs_;      // TIME only
+};
+
+/**
+ * @class BarAggregator
+ * @brief Builds every configured bar series from the same tick input, per symbol.
+ *
+ * Fed with every tick on the feed thread. Series of a symbol are allocated on its first
+ * tick; after that the tick path does not allocate. Subscribers are called on the
+ * feeding thread for each completed bar, after it has been appended to the series.
+ */
+class BarAggregator
+{
+public:
+    using BarHandler = std::function<void(SymbolId symbol, const BarSeries& series)>;
+
+    BarAggregator() : symbols_(MAX_SYMBOLS) {}
+
+    // Startup only; drops all bars and subscriptions
+    void configure(const std::vector<BarSpec>& specs, size_t history);
+    bool enabled() const { return !specs_.empty(); }
+
+    // Index of the series with this name, or -1
+    int find(const std::string& name) const;
+    // Adds a series unless one with the same name exists; returns its index.
+    // Startup only, before the first tick: series point into specs()
+    size_t add(const BarSpec& spec);
+    const std::vector<BarSpec>& specs() const { return specs_; }
+
+    void subscribe(size_t series, BarHandler handler);
+
+    // Returns the number of bars the tick completed
+    size_t onTick(const TradeData& tick);
+    void discardOpen(SymbolId symbol);
+
+    // nullptr until the symbol's first tick
+    const BarSeries* series(SymbolId symbol, size_t index) const;
+
+private:
+    std::vector<BarSpec> specs_;
+    size_t history_ = 0;
+    std::vector<std::vector<BarSeries>> symbols_;       // [SymbolId][series]
+    std::vector<std::vector<BarHandler>> handlers_;     // [series]
+};
+
+#endif // BAR_AGGREGATOR_H
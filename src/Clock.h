@@ -0,0 +1,84 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/**
+ * @class IClock
+ * @brief Source of "now" for the engine, executor and risk gate.
+ *
+ * Live trading uses the wall clock. Replays drive time from the tick timestamps instead,
+ * so a run is a pure function of its input: the feed thread calls advanceTo() with each
+ * tick before it is processed, and everything stamped during that tick sees the same time.
+ */
+class IClock
+{
+public:
+    virtual ~IClock() = default;
+
+    // Epoch milliseconds
+    virtual long long nowMs() const = 0;
+
+    // Feed thread, once per tick; wall-clock implementations ignore it
+    virtual void advanceTo(long long tickMs) { (void) tickMs; }
+
+    // False when time comes from the feed: threads must not wait on wall-time timeouts
+    virtual bool realTime() const { return false; }
+};
+
+class RealClock : public IClock
+{
+public:
+    long long nowMs() const override
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    bool realTime() const override { return true; }
+};
+
+// Time is the latest tick timestamp; a replay runs as fast as the CPU allows
+class SimulatedClock : public IClock
+{
+public:
+    long long nowMs() const override { return now_.load(std::memory_order_acquire); }
+
+    void advanceTo(long long tickMs) override
+    {
+        // Never backwards: out-of-order ticks keep the previous time
+        if (tickMs > now_.load(std::memory_order_relaxed)) {
+            now_.store(tickMs, std::memory_order_release);
+        }
+    }
+
+private:
+    std::atomic<long long> now_{0};
+};
+
+// Simulated time, paced to 'speed' times the recorded rate (speed 60: an hour of ticks per minute)
+class AcceleratedClock : public SimulatedClock
+{
+public:
+    explicit AcceleratedClock(double speed) : speed_(speed > 0.0 ? speed : 1.0) {}
+
+    void advanceTo(long long tickMs) override
+    {
+        if (firstTickMs_ < 0) {
+            firstTickMs_ = tickMs;
+            start_ = std::chrono::steady_clock::now();
+        }
+        const auto due = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                      std::chrono::duration<double, std::milli>((tickMs - firstTickMs_) / speed_));
+        std::this_thread::sleep_until(due);
+        SimulatedClock::advanceTo(tickMs);
+    }
+
+private:
+    const double speed_;
+    long long firstTickMs_ = -1;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#endif // CLOCK_H
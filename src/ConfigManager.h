@@ -10,21 +10,41 @@ public:
         return inst;
     }
 
-    void load(const std::string& path) {
+    // Overlays the file's KEY=value lines; '#' lines are comments. False if it cannot be read
+    bool load(const std::string& path) {
         std::ifstream f(path);
+        if (!f) {
+            return false;
+        }
         std::string line;
         while (std::getline(f, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
             auto pos = line.find('=');
-            if (pos != std::string::npos) 
+            if (pos != std::string::npos)
                 data[line.substr(0, pos)] = line.substr(pos + 1);
         }
+        return true;
+    }
+
+    // Unified conversion to double; cast to int when used, for simplicity.
+    // Throws std::invalid_argument on a value that is not a number
+    double get(const std::string& key, double def = 0) const {
+        auto it = data.find(key);
+        return it != data.end() ? std::stod(it->second) : def;
     }
 
-    // Unified conversion to double; cast to int when used, for simplicity
-    double get(const std::string& key, double def = 0) {
-        return data.count(key) ? std::stod(data[key]) : def;
+    std::string getString(const std::string& key, const std::string& def = "") const {
+        auto it = data.find(key);
+        return it != data.end() ? it->second : def;
     }
 
+    const std::map<std::string, std::string>& values() const { return data; }
+
 private:
     std::map<std::string, std::string> data;
-};
\ No newline at end of file
+};
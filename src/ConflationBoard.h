@@ -0,0 +1,81 @@
+#ifndef CONFLATION_BOARD_H
+#define CONFLATION_BOARD_H
+
+#include <atomic>
+#include <cstdint>
+#include "SeqLock.h"
+#include "Types.h"
+
+static_assert(MAX_SYMBOLS <= 64, "ConflationBoard keeps one dirty bit per symbol in a uint64_t");
+
+/**
+ * @class ConflationBoard
+ * @brief Latest unprocessed tick per symbol, from the ingest thread to the strategy thread.
+ *
+ * publish() overwrites the symbol's slot under its seqlock and sets a dirty bit, so the
+ * ingest thread never waits and a slow consumer only ever sees the newest tick of each
+ * symbol: its backlog is bounded by the number of symbols, not by the feed rate.
+ * Window resets travel inside the entries as a per-symbol count, so a reset is ordered
+ * with the ticks around it and survives conflation: the consumer clears the window
+ * before the first tick published after the request, and never drops a later one.
+ * Single producer, single consumer.
+ */
+class ConflationBoard
+{
+public:
+    struct Entry
+    {
+        TradeData tick;
+        uint64_t receivedNs;    // monotonicNs() at arrival, for the latency metrics
+        uint64_t resets;        // Reset requests of the symbol published before this tick
+    };
+
+    // Returns true if the board was clean, i.e. the consumer may need a wake-up.
+    // 'conflated' is set when an update the consumer had not taken yet was overwritten.
+    bool publish(const TradeData& tick, uint64_t receivedNs, bool& conflated)
+    {
+        SeqLock<Entry>& slot = slots_[tick.symbol_];
+        Entry& entry = slot.beginWrite();
+        entry.tick = tick;
+        entry.receivedNs = receivedNs;
+        entry.resets = resetRequests_[tick.symbol_];
+        slot.endWrite();
+        const uint64_t bit = uint64_t(1) << tick.symbol_;
+        const uint64_t before = dirty_.fetch_or(bit, std::memory_order_release);
+        conflated = (before & bit) != 0;
+        return before == 0;
+    }
+
+    // Producer side: the consumer clears the symbol's window before its next tick (feed gap)
+    void requestReset(SymbolId symbol) { ++resetRequests_[symbol]; }
+
+    bool pending() const { return dirty_.load(std::memory_order_acquire) != 0; }
+
+    // Consumer side: the dirty symbols since the last take()
+    uint64_t take() { return dirty_.exchange(0, std::memory_order_acquire); }
+
+    // Copies the symbol's entry; false if it is the one the consumer already read.
+    // A slot rewritten between take() and read() is then consumed at its newest value
+    // and its second dirty bit is skipped here instead of evaluating the tick twice.
+    // 'reset': a reset was requested since the last entry read; clear the window first.
+    bool read(SymbolId symbol, Entry& out, bool& reset)
+    {
+        const uint64_t version = slots_[symbol].version();
+        if (version == consumed_[symbol]) {
+            return false;
+        }
+        out = slots_[symbol].read(consumed_[symbol]);
+        reset = out.resets != consumedResets_[symbol];
+        consumedResets_[symbol] = out.resets;
+        return true;
+    }
+
+private:
+    SeqLock<Entry> slots_[MAX_SYMBOLS];
+    std::atomic<uint64_t> dirty_{0};
+    uint64_t resetRequests_[MAX_SYMBOLS] = {};   // Producer only
+    uint64_t consumed_[MAX_SYMBOLS] = {};        // Consumer only: slot version last read
+    uint64_t consumedResets_[MAX_SYMBOLS] = {};  // Consumer only: resets already applied
+};
+
+#endif // CONFLATION_BOARD_H
@@ -0,0 +1,105 @@
+#include "CsvTickSource.h"
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include "TickParser.h"
+#include "pch.h"
+
+bool CsvTickSource::open(const std::string& path)
+{
+    if (!file_.open(path, true)) {
+        LOG(ERROR) << "CSV: cannot open " << path;
+        return false;
+    }
+    cursor_ = file_.data();
+    end_ = cursor_ + file_.size();
+    rows_ = 0;
+    malformedRows_ = 0;
+    lastSymbol_ = nullptr;
+
+    // Skip a header row; any other first row is parsed, and counted if malformed
+    const char* lineEnd = static_cast<const char*>(std::memchr(cursor_, '\n', file_.size()));
+    if (lineEnd != nullptr && isHeader(cursor_, lineEnd)) {
+        cursor_ = lineEnd + 1;
+    }
+    return true;
+}
+
+bool CsvTickSource::isHeader(const char* begin, const char* end)
+{
+    // The price column is text ("price", "\"Price\""), not a number or a garbled one
+    const char* comma1 = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+    if (comma1 == nullptr) {
+        return false;
+    }
+    const char* price = comma1 + 1;
+    if (price < end && *price == '"') {
+        ++price;
+    }
+    double value = 0.0;
+    return price < end && std::isalpha(static_cast<unsigned char>(*price)) &&
+           std::from_chars(price, end, value).ec != std::errc();
+}
+
+bool CsvTickSource::parseRow(const char* begin, const char* end, TradeData& tick)
+{
+    if (end > begin && end[-1] == '\r') {
+        --end;
+    }
+    const char* comma1 = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+    if (comma1 == nullptr) {
+        return false;
+    }
+    const char* comma2 = static_cast<const char*>(std::memchr(comma1 + 1, ',', end - comma1 - 1));
+    if (comma2 == nullptr) {
+        return false;
+    }
+
+    double price = 0.0;
+    double timestamp = 0.0;
+    if (std::from_chars(comma1 + 1, comma2, price).ec != std::errc() || !TickParser::ValidPrice(price) ||
+        std::from_chars(comma2 + 1, end, timestamp).ec != std::errc() || !TickParser::ValidTimestamp(timestamp)) {
+        return false;
+    }
+
+    const char* symbol = begin;
+    size_t symbolLen = static_cast<size_t>(comma1 - begin);
+    if (symbolLen >= 2 && symbol[0] == '"' && symbol[symbolLen - 1] == '"') {
+        ++symbol;
+        symbolLen -= 2;
+    }
+    if (symbolLen != lastSymbolLen_ || lastSymbol_ == nullptr || std::memcmp(symbol, lastSymbol_, symbolLen) != 0) {
+        lastSymbolId_ = SymbolTable::instance().intern(symbol, symbolLen);
+        lastSymbol_ = symbol;
+        lastSymbolLen_ = symbolLen;
+    }
+    if (lastSymbolId_ == INVALID_SYMBOL_ID) {
+        return false;
+    }
+
+    tick.price_ = price;
+    tick.timestamp_ms_ = TickParser::ToEpochMs(timestamp);
+    tick.symbol_ = lastSymbolId_;
+    return true;
+}
+
+bool CsvTickSource::Next(TradeData& tick)
+{
+    while (cursor_ < end_) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor_, '\n', end_ - cursor_));
+        if (lineEnd == nullptr) {
+            lineEnd = end_;   // Last row without a newline
+        }
+        const char* line = cursor_;
+        cursor_ = (lineEnd < end_) ? lineEnd + 1 : end_;
+        if (lineEnd == line || (lineEnd == line + 1 && *line == '\r')) {
+            continue;
+        }
+        if (parseRow(line, lineEnd, tick)) {
+            ++rows_;
+            return true;
+        }
+        ++malformedRows_;
+    }
+    return false;
+}
@@ -0,0 +1,45 @@
+#ifndef CSV_TICK_SOURCE_H
+#define CSV_TICK_SOURCE_H
+
+#include <cstdint>
+#include <string>
+#include "FileUtils.h"
+#include "TickSource.h"
+
+/**
+ * @class CsvTickSource
+ * @brief Streams "symbol,price,timestamp" rows (market_data.csv, exchange dumps) from an mmap'd file.
+ *
+ * Rows are parsed in place: memchr finds the line end and the two commas (glibc's
+ * memchr is vectorized), std::from_chars reads the numbers, and nothing is copied
+ * or allocated. A header row, blank lines, CRLF endings and quoted symbols are
+ * accepted; malformed rows are skipped and counted.
+ */
+class CsvTickSource : public ITickSource
+{
+public:
+    bool open(const std::string& path);
+    bool Next(TradeData& tick) override;
+
+    uint64_t rows() const { return rows_; }
+    uint64_t malformedRows() const { return malformedRows_; }
+    size_t bytes() const { return file_.size(); }
+
+private:
+    bool parseRow(const char* begin, const char* end, TradeData& tick);
+    // A first row whose price column is text; it is skipped, not counted as malformed
+    static bool isHeader(const char* begin, const char* end);
+
+    MappedFile file_;
+    const char* cursor_ = nullptr;
+    const char* end_ = nullptr;
+    uint64_t rows_ = 0;
+    uint64_t malformedRows_ = 0;
+
+    // Consecutive rows are usually the same symbol: skip the intern lookup for them
+    const char* lastSymbol_ = nullptr;
+    size_t lastSymbolLen_ = 0;
+    SymbolId lastSymbolId_ = INVALID_SYMBOL_ID;
+};
+
+#endif // CSV_TICK_SOURCE_H
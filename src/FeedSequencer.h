@@ -0,0 +1,108 @@
+#ifndef FEED_SEQUENCER_H
+#define FEED_SEQUENCER_H
+
+#include <cstdint>
+#include "Types.h"
+
+enum class FeedGapPolicy : uint8_t
+{
+    REPLAY,     // Ask the feeder to resend from the first missing tick; rebuild if it cannot
+    REBUILD     // Discard the symbol's window and refill it from live ticks
+};
+
+struct FeedSequencerConfig
+{
+    FeedGapPolicy policy = FeedGapPolicy::REPLAY;
+    uint32_t replayTimeoutMs = 1000;    // Longest wait for a requested replay before rebuilding
+};
+
+enum class SequenceCheck : uint8_t
+{
+    ACCEPT,     // Next in sequence (or unsequenced): process normally
+    DISCARD,    // Duplicate, or held back while a replay is pending
+    REPLAY,     // Gap opened: send a replay request for [replayFrom(), tick.seq_] and discard
+    REBUILD     // Gap not recoverable or feed restarted: clear the window, then process
+};
+
+/**
+ * @class FeedSequencer
+ * @brief Per-symbol sequence check of the live feed, on the feed thread.
+ *
+ * Ticks carry a per-symbol sequence number starting at 1 (0 = unsequenced source, e.g.
+ * a replayed file, and never checked). The in-order case is one compare and store.
+ * Recovery is go-back-N: after a replay request every out-of-order tick of the symbol
+ * is discarded until the first missing one arrives, since the feeder resends everything
+ * from there on. A feeder that restarts at 1 starts a new session.
+ */
+class FeedSequencer
+{
+public:
+    explicit FeedSequencer(const FeedSequencerConfig& config = FeedSequencerConfig()) : config_(config) {}
+
+    SequenceCheck check(const TradeData& tick, uint64_t nowNs)
+    {
+        if (tick.seq_ == 0) {
+            return SequenceCheck::ACCEPT;
+        }
+        SymbolSequence& s = symbols_[tick.symbol_];
+        if (tick.seq_ == s.next || s.next == 0) {
+            s.next = tick.seq_ + 1;
+            s.replayDeadlineNs = 0;
+            return SequenceCheck::ACCEPT;
+        }
+        return outOfOrder(s, tick.seq_, nowNs);
+    }
+
+    // First missing sequence number of the symbol, for the replay request
+    uint32_t replayFrom(SymbolId symbol) const { return symbols_[symbol].next; }
+
+    // Missing ticks if the last check() opened a new gap, else 0
+    uint32_t lastGapSize() const { return lastGapSize_; }
+
+    // The replay request for 'tick' could not be sent: continue from it, as REBUILD would
+    void replayFailed(const TradeData& tick)
+    {
+        symbols_[tick.symbol_].next = tick.seq_ + 1;
+        symbols_[tick.symbol_].replayDeadlineNs = 0;
+    }
+
+private:
+    struct SymbolSequence
+    {
+        uint32_t next = 0;              // Expected sequence number; 0 = nothing seen yet
+        uint64_t replayDeadlineNs = 0;  // Non-zero while a replay is pending
+    };
+
+    SequenceCheck outOfOrder(SymbolSequence& s, uint32_t seq, uint64_t nowNs)
+    {
+        lastGapSize_ = 0;
+        if (seq == 1) {
+            // Feeder restarted: its old sequence space is gone
+            s.next = 2;
+            s.replayDeadlineNs = 0;
+            return SequenceCheck::REBUILD;
+        }
+        if (seq < s.next) {
+            return SequenceCheck::DISCARD;
+        }
+        if (s.replayDeadlineNs != 0 && nowNs < s.replayDeadlineNs) {
+            return SequenceCheck::DISCARD;
+        }
+        const bool newGap = s.replayDeadlineNs == 0;
+        lastGapSize_ = newGap ? seq - s.next : 0;
+        if (newGap && config_.policy == FeedGapPolicy::REPLAY) {
+            s.replayDeadlineNs = nowNs + uint64_t(config_.replayTimeoutMs) * 1000000;
+            return SequenceCheck::REPLAY;
+        }
+        // Rebuild policy, or the replay did not arrive in time: continue from this tick
+        s.next = seq + 1;
+        s.replayDeadlineNs = 0;
+        return SequenceCheck::REBUILD;
+    }
+
+    FeedSequencerConfig config_;
+    SymbolSequence symbols_[MAX_SYMBOLS];
+    uint32_t lastGapSize_ = 0;
+};
+
+#endif // FEED_SEQUENCER_H
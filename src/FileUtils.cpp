@@ -0,0 +1,185 @@
+#include "FileUtils.h"
+#include <array>
+#include <cerrno>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+    #include <direct.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace FileUtils
+{
+
+bool MakeDirectory(const std::string& path)
+{
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+bool SyncFile(std::FILE* file)
+{
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fdatasync(fileno(file)) == 0;
+#endif
+}
+
+bool TruncateFile(std::FILE* file, long long size)
+{
+#ifdef _WIN32
+    return _chsize_s(_fileno(file), size) == 0;
+#else
+    return ftruncate(fileno(file), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+bool SeekTo(std::FILE* file, long long offset, int origin)
+{
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+long long FileSize(std::FILE* file)
+{
+    SeekTo(file, 0, SEEK_END);
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return static_cast<long long>(ftello(file));
+#endif
+}
+
+bool WriteFileAtomic(const std::string& path, const void* header, size_t headerSize,
+                     const void* data, size_t size)
+{
+    const std::string tmpPath = path + ".tmp";
+    std::FILE* file = std::fopen(tmpPath.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    const bool ok = std::fwrite(header, 1, headerSize, file) == headerSize &&
+                    (size == 0 || std::fwrite(data, 1, size, file) == size) &&
+                    SyncFile(file);
+    std::fclose(file);
+    if (!ok) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());   // rename() does not replace on Windows
+#endif
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+// Slicing-by-8: eight table lookups per 8 input bytes instead of one per byte;
+// journal recovery is bound by checksumming the whole file
+uint32_t crc32(const void* data, size_t size)
+{
+    static const auto tables = [] {
+        std::array<std::array<uint32_t, 256>, 8> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (size_t slice = 1; slice < 8; ++slice) {
+                t[slice][i] = t[0][t[slice - 1][i] & 0xFF] ^ (t[slice - 1][i] >> 8);
+            }
+        }
+        return t;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (; size >= 8; size -= 8, bytes += 8) {
+        const uint32_t lo = crc ^ (uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 |
+                                   uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24);
+        crc = tables[7][lo & 0xFF] ^ tables[6][(lo >> 8) & 0xFF] ^
+              tables[5][(lo >> 16) & 0xFF] ^ tables[4][lo >> 24] ^
+              tables[3][bytes[4]] ^ tables[2][bytes[5]] ^
+              tables[1][bytes[6]] ^ tables[0][bytes[7]];
+    }
+    for (; size > 0; --size, ++bytes) {
+        crc = tables[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+} // namespace FileUtils
+
+bool MappedFile::open(const std::string& path, bool sequential)
+{
+    close();
+#ifdef _WIN32
+    (void) sequential;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    const long long size = FileUtils::FileSize(file);
+    FileUtils::SeekTo(file, 0);
+    copy_.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    const bool ok = copy_.empty() || std::fread(copy_.data(), 1, copy_.size(), file) == copy_.size();
+    std::fclose(file);
+    if (!ok) {
+        copy_.clear();
+        return false;
+    }
+    data_ = copy_.data();
+    size_ = copy_.size();
+    return true;
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        madvise(mapped, size_, sequential ? MADV_SEQUENTIAL : MADV_WILLNEED);
+        data_ = static_cast<const char*>(mapped);
+    }
+    ::close(fd);   // The mapping keeps its own reference
+    return true;
+#endif
+}
+
+void MappedFile::close()
+{
+#ifndef _WIN32
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    copy_.clear();
+    data_ = nullptr;
+    size_ = 0;
+}
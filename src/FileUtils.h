@@ -0,0 +1,57 @@
+#ifndef FILE_UTILS_H
+#define FILE_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Durable-file helpers shared by the journal and the checkpoints (POSIX with Windows fallbacks)
+namespace FileUtils
+{
+    bool MakeDirectory(const std::string& path);
+
+    // Data (not metadata) durability; the closest equivalent on Windows is _commit
+    bool SyncFile(std::FILE* file);
+
+    bool TruncateFile(std::FILE* file, long long size);
+
+    // 64-bit offsets: journals and tick logs outgrow a 32-bit long
+    bool SeekTo(std::FILE* file, long long offset, int origin = SEEK_SET);
+    long long FileSize(std::FILE* file);
+
+    // Writes header + data to path.tmp, syncs it and renames it over 'path'
+    bool WriteFileAtomic(const std::string& path, const void* header, size_t headerSize,
+                         const void* data, size_t size);
+
+    // CRC-32 (IEEE 802.3, the zlib polynomial)
+    uint32_t crc32(const void* data, size_t size);
+}
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file: mmap on POSIX, a heap copy on Windows.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Sequential hints the kernel to read ahead aggressively (streaming loaders)
+    bool open(const std::string& path, bool sequential = false);
+    void close();
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<char> copy_;   // Windows fallback storage
+};
+
+#endif // FILE_UTILS_H
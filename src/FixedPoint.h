@@ -0,0 +1,50 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cmath>
+#include <cstdint>
+
+// Integer price / quantity representation used by execution and accounting.
+// Strategies keep computing indicators in double; values are converted once at
+// the signal boundary and stay integral from there on, so fills are exact and
+// identical across builds.
+using PriceTicks = int64_t;   // Price in units of the instrument's tick (1 / priceScale)
+using QtyLots = int64_t;      // Quantity in units of the instrument's lot (1 / qtyScale)
+using CashUnits = int64_t;    // Quote-currency amount in units of 1 / CASH_SCALE
+
+// 128-bit intermediate for notional math (__extension__ keeps -pedantic quiet)
+__extension__ typedef __int128 WideInt;
+
+constexpr int64_t CASH_SCALE = 10000;  // Cash is kept to 1/10000 of the quote currency
+
+/**
+ * @struct InstrumentScale
+ * @brief Per-symbol tick and lot scales (units per 1.0 of price / quantity).
+ *
+ * Default: 0.01 price ticks and 1e-8 lots (satoshi-sized), which suits BTC quotes.
+ */
+struct InstrumentScale
+{
+    int64_t priceScale = 100;
+    int64_t qtyScale = 100000000;
+
+    PriceTicks toTicks(double price) const { return std::llround(price * priceScale); }
+    QtyLots toLots(double quantity) const { return std::llround(quantity * qtyScale); }
+    double fromTicks(PriceTicks ticks) const { return static_cast<double>(ticks) / priceScale; }
+    double fromLots(QtyLots lots) const { return static_cast<double>(lots) / qtyScale; }
+
+    // price * quantity in cash units, rounded half away from zero (128-bit intermediate)
+    CashUnits notional(PriceTicks price, QtyLots quantity) const
+    {
+        const WideInt numerator = static_cast<WideInt>(price) * quantity * CASH_SCALE;
+        const WideInt denominator = static_cast<WideInt>(priceScale) * qtyScale;
+        const WideInt half = denominator / 2;
+        return static_cast<CashUnits>(numerator >= 0 ? (numerator + half) / denominator
+                                                     : (numerator - half) / denominator);
+    }
+};
+
+inline CashUnits toCashUnits(double amount) { return std::llround(amount * CASH_SCALE); }
+inline double fromCashUnits(CashUnits units) { return static_cast<double>(units) / CASH_SCALE; }
+
+#endif // FIXED_POINT_H
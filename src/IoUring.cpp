@@ -0,0 +1,329 @@
+#include "IoUring.h"
+#include "pch.h"
+
+#if defined(USE_IO_URING) && defined(__linux__)
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+bool IoCompletion::hasBuffer() const { return (flags & IORING_CQE_F_BUFFER) != 0; }
+uint16_t IoCompletion::bufferId() const { return static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT); }
+bool IoCompletion::more() const { return (flags & IORING_CQE_F_MORE) != 0; }
+
+namespace {
+
+constexpr uint16_t BUFFER_GROUP = 0;
+
+// Ring indices are shared with the kernel: the owner writes with release, the other side's with acquire
+unsigned LoadAcquire(const unsigned* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+void StoreRelease(unsigned* p, unsigned v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+
+} // namespace
+
+struct IoUring::Rings
+{
+    int fd = -1;
+    void* ring = MAP_FAILED;        // SQ and CQ rings share one mapping (IORING_FEAT_SINGLE_MMAP)
+    size_t ringBytes = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqeBytes = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqQueued = 0;          // Local tail: queued, published to the kernel by submit()
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    // Provided buffers: the ring of free buffers the kernel picks from, and their memory
+    io_uring_buf* bufRing = static_cast<io_uring_buf*>(MAP_FAILED);
+    size_t bufRingBytes = 0;
+    uint16_t bufCount = 0;
+    uint16_t bufTail = 0;
+    uint32_t bufSize = 0;
+    std::vector<char> buffers;
+
+    ~Rings()
+    {
+        if (bufRing != MAP_FAILED) {
+            munmap(bufRing, bufRingBytes);
+        }
+        if (sqes != MAP_FAILED) {
+            munmap(sqes, sqeBytes);
+        }
+        if (ring != MAP_FAILED) {
+            munmap(ring, ringBytes);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    io_uring_sqe* nextSqe()
+    {
+        if (sqQueued - LoadAcquire(sqHead) >= sqEntries) {
+            return nullptr;
+        }
+        const unsigned index = sqQueued & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        ++sqQueued;
+        return sqe;
+    }
+
+    // The tail lives in the reserved field of the first entry (struct io_uring_buf_ring)
+    uint16_t* bufRingTail() { return &bufRing[0].resv; }
+
+    void addBuffer(uint16_t id)
+    {
+        io_uring_buf& entry = bufRing[bufTail & (bufCount - 1)];
+        entry.addr = reinterpret_cast<uint64_t>(&buffers[size_t(id) * bufSize]);
+        entry.len = bufSize;
+        entry.bid = id;
+        ++bufTail;
+    }
+};
+
+IoUring::IoUring() = default;
+
+IoUring::~IoUring()
+{
+    close();
+}
+
+bool IoUring::init(unsigned entries)
+{
+    close();
+    std::unique_ptr<Rings> r(new Rings);
+    io_uring_params params{};
+    r->fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (r->fd < 0) {
+        LOG(WARN) << "io_uring unavailable: " << std::strerror(errno);
+        return false;
+    }
+    // Single mapping (5.4) and timed waits through IORING_ENTER_EXT_ARG (5.11)
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 || (params.features & IORING_FEAT_EXT_ARG) == 0) {
+        LOG(WARN) << "io_uring unavailable: kernel too old";
+        return false;
+    }
+
+    const size_t sqBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    const size_t cqBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    r->ringBytes = sqBytes > cqBytes ? sqBytes : cqBytes;
+    r->ring = mmap(nullptr, r->ringBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQ_RING);
+    r->sqeBytes = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, r->sqeBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd, IORING_OFF_SQES);
+    r->sqes = static_cast<io_uring_sqe*>(sqes);
+    if (r->ring == MAP_FAILED || sqes == MAP_FAILED) {
+        LOG(WARN) << "io_uring unavailable: cannot map rings";
+        return false;
+    }
+
+    char* base = static_cast<char*>(r->ring);
+    r->sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    r->sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    r->sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    r->sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    r->sqEntries = params.sq_entries;
+    r->sqQueued = *r->sqTail;
+    r->cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    r->cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    r->cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+    r->cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+    rings_ = std::move(r);
+    return true;
+}
+
+void IoUring::close()
+{
+    rings_.reset();
+}
+
+bool IoUring::write(int fd, const void* data, uint32_t size, uint64_t offset, uint64_t userData, bool linkNext)
+{
+    io_uring_sqe* sqe = rings_ ? rings_->nextSqe() : nullptr;
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = size;
+    sqe->off = offset;
+    sqe->user_data = userData;
+    sqe->flags = linkNext ? IOSQE_IO_LINK : 0;
+    return true;
+}
+
+bool IoUring::fdatasync(int fd, uint64_t userData)
+{
+    io_uring_sqe* sqe = rings_ ? rings_->nextSqe() : nullptr;
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = fd;
+    sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::recvMultishot(int fd, uint64_t userData)
+{
+    io_uring_sqe* sqe = rings_ && rings_->bufCount > 0 ? rings_->nextSqe() : nullptr;
+    if (sqe == nullptr) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::submit(unsigned wait, int timeoutMs)
+{
+    if (!rings_) {
+        return false;
+    }
+    const unsigned toSubmit = rings_->sqQueued - *rings_->sqTail;
+    if (toSubmit == 0 && wait == 0) {
+        return true;
+    }
+    StoreRelease(rings_->sqTail, rings_->sqQueued);
+
+    unsigned flags = wait > 0 ? IORING_ENTER_GETEVENTS : 0;
+    long ret;
+    if (wait > 0 && timeoutMs >= 0) {
+        __kernel_timespec ts{};
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+        io_uring_getevents_arg arg{};
+        arg.ts = reinterpret_cast<uint64_t>(&ts);
+        flags |= IORING_ENTER_EXT_ARG;
+        ret = syscall(__NR_io_uring_enter, rings_->fd, toSubmit, wait, flags, &arg, sizeof(arg));
+    } else {
+        ret = syscall(__NR_io_uring_enter, rings_->fd, toSubmit, wait, flags, nullptr, 0);
+    }
+    // A timed-out or interrupted wait is not an error: the caller looks for completions
+    return ret >= 0 || errno == ETIME || errno == EINTR;
+}
+
+bool IoUring::peek(IoCompletion& out) const
+{
+    if (!rings_) {
+        return false;
+    }
+    const unsigned head = *rings_->cqHead;
+    if (head == LoadAcquire(rings_->cqTail)) {
+        return false;
+    }
+    const io_uring_cqe& cqe = rings_->cqes[head & rings_->cqMask];
+    out.userData = cqe.user_data;
+    out.result = cqe.res;
+    out.flags = cqe.flags;
+    return true;
+}
+
+void IoUring::consume()
+{
+    StoreRelease(rings_->cqHead, *rings_->cqHead + 1);
+}
+
+bool IoUring::next(IoCompletion& out, int timeoutMs)
+{
+    if (!peek(out) && !(submit(1, timeoutMs) && peek(out))) {
+        return false;
+    }
+    consume();
+    return true;
+}
+
+bool IoUring::provideBuffers(uint16_t count, uint32_t size)
+{
+    if (!rings_ || rings_->bufCount > 0 || count == 0 || (count & (count - 1)) != 0) {
+        return false;
+    }
+    Rings& r = *rings_;
+    // The kernel needs the ring page-aligned
+    r.bufRingBytes = count * sizeof(io_uring_buf);
+    void* ring = mmap(nullptr, r.bufRingBytes, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (ring == MAP_FAILED) {
+        return false;
+    }
+    r.bufRing = static_cast<io_uring_buf*>(ring);
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = count;
+    reg.bgid = BUFFER_GROUP;
+    if (syscall(__NR_io_uring_register, r.fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        LOG(WARN) << "io_uring: provided buffer ring not supported: " << std::strerror(errno);
+        return false;
+    }
+    r.bufCount = count;
+    r.bufSize = size;
+    r.buffers.resize(size_t(count) * size);
+    for (uint16_t id = 0; id < count; ++id) {
+        r.addBuffer(id);
+    }
+    __atomic_store_n(r.bufRingTail(), r.bufTail, __ATOMIC_RELEASE);
+    return true;
+}
+
+const char* IoUring::buffer(uint16_t id) const
+{
+    return &rings_->buffers[size_t(id) * rings_->bufSize];
+}
+
+void IoUring::recycle(uint16_t id)
+{
+    rings_->addBuffer(id);
+    __atomic_store_n(rings_->bufRingTail(), rings_->bufTail, __ATOMIC_RELEASE);
+}
+
+#else // !USE_IO_URING: every init() fails and callers keep their POSIX path
+
+bool IoCompletion::hasBuffer() const { return false; }
+uint16_t IoCompletion::bufferId() const { return 0; }
+bool IoCompletion::more() const { return false; }
+
+struct IoUring::Rings
+{
+};
+
+IoUring::IoUring() = default;
+IoUring::~IoUring() = default;
+
+bool IoUring::init(unsigned)
+{
+    LOG(WARN) << "io_uring unavailable: built without USE_IO_URING";
+    return false;
+}
+
+void IoUring::close() {}
+bool IoUring::write(int, const void*, uint32_t, uint64_t, uint64_t, bool) { return false; }
+bool IoUring::fdatasync(int, uint64_t) { return false; }
+bool IoUring::recvMultishot(int, uint64_t) { return false; }
+bool IoUring::submit(unsigned, int) { return false; }
+bool IoUring::peek(IoCompletion&) const { return false; }
+void IoUring::consume() {}
+bool IoUring::next(IoCompletion&, int) { return false; }
+bool IoUring::provideBuffers(uint16_t, uint32_t) { return false; }
+const char* IoUring::buffer(uint16_t) const { return nullptr; }
+void IoUring::recycle(uint16_t) {}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef IO_URING_H
+#define IO_URING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// One completed operation, as posted by the kernel
+struct IoCompletion
+{
+    uint64_t userData = 0;
+    int32_t result = 0;         // Bytes transferred, or -errno
+    uint32_t flags = 0;
+
+    bool hasBuffer() const;     // The receive landed in a provided buffer: bufferId()
+    uint16_t bufferId() const;
+    bool more() const;          // A multishot request stays armed after this completion
+};
+
+/**
+ * @class IoUring
+ * @brief Minimal io_uring instance on the raw kernel interface (no liburing).
+ *
+ * Operations are queued into the submission ring and reach the kernel together in one
+ * submit(), which can also wait for completions: a journal group commit (write + linked
+ * fdatasync) or a tick log block (header + payload) costs one system call. Receives use
+ * a ring of provided buffers, so one multishot request serves a socket until it closes
+ * and every completion names the buffer holding its data.
+ *
+ * Built only with USE_IO_URING on Linux; otherwise, or when the kernel refuses (too old,
+ * io_uring disabled, seccomp), init() fails and the caller keeps its POSIX path.
+ * One issuing thread at a time.
+ */
+class IoUring
+{
+public:
+    IoUring();
+    ~IoUring();
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // False if unavailable; the reason is logged
+    bool init(unsigned entries);
+    bool ready() const { return rings_ != nullptr; }
+    void close();
+
+    // Queue one operation; false if the submission ring is full.
+    // 'linkNext': the next queued operation starts only if this one succeeds.
+    bool write(int fd, const void* data, uint32_t size, uint64_t offset, uint64_t userData, bool linkNext = false);
+    bool fdatasync(int fd, uint64_t userData);
+    // Receives into provided buffers until the socket closes, fails or buffers run out
+    // (completion without more(): -ENOBUFS means re-arm after recycling)
+    bool recvMultishot(int fd, uint64_t userData);
+
+    // Hands everything queued to the kernel and waits until at least 'wait' completions
+    // are ready, or timeoutMs passes (-1: no limit). Returns false on an error.
+    bool submit(unsigned wait = 0, int timeoutMs = -1);
+
+    // Next completion without consuming it / consume it
+    bool peek(IoCompletion& out) const;
+    void consume();
+    // Next completion, waiting up to timeoutMs for one; consumed
+    bool next(IoCompletion& out, int timeoutMs = -1);
+
+    // 'count' (a power of two) buffers of 'size' bytes for recvMultishot
+    bool provideBuffers(uint16_t count, uint32_t size);
+    const char* buffer(uint16_t id) const;
+    // Returns a buffer to the kernel once its data has been consumed
+    void recycle(uint16_t id);
+
+private:
+    struct Rings;
+    std::unique_ptr<Rings> rings_;
+};
+
+#endif // IO_URING_H
@@ -0,0 +1,357 @@
+#include "Journal.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include "FileUtils.h"
+#include "ThreadPlacement.h"
+#include "pch.h"
+
+namespace {
+
+constexpr char JOURNAL_MAGIC[4] = {'T', 'S', 'J', '1'};
+constexpr char SNAPSHOT_MAGIC[4] = {'T', 'S', 'S', '1'};
+constexpr uint32_t FORMAT_VERSION = 2;   // 2: SYMBOL records, named snapshots
+
+struct JournalFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+struct SnapshotFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t sequence;
+    uint32_t size;
+    uint32_t checksum;
+};
+
+constexpr size_t CHECKSUMMED_BYTES = offsetof(JournalRecord, checksum);
+constexpr size_t REPLAY_CHUNK = 4096;   // Records read per fread during recovery
+constexpr int COMMIT_ATTEMPTS = 5;      // Per group commit, before the journal latches failed
+constexpr auto COMMIT_RETRY_DELAY = std::chrono::milliseconds(100);
+
+} // namespace
+
+Journal::~Journal()
+{
+    stop();
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+}
+
+void Journal::configure(const JournalConfig& config)
+{
+    config_ = config;
+    if (config_.enabled) {
+        ring_ = std::make_unique<SpscRing<JournalRecord>>(config_.ringCapacity);
+        batch_.reserve(ring_->capacity());
+    }
+}
+
+bool Journal::loadSnapshot(void* snapshot, size_t snapshotSize, uint64_t& sequence)
+{
+    std::FILE* file = std::fopen(snapshotPath().c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    SnapshotFileHeader header{};
+    std::vector<unsigned char> data(snapshotSize);
+    const bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                    std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+                    header.version == FORMAT_VERSION && header.size == snapshotSize &&
+                    std::fread(data.data(), 1, snapshotSize, file) == snapshotSize &&
+                    FileUtils::crc32(data.data(), snapshotSize) == header.checksum;
+    std::fclose(file);
+    if (!ok) {
+        LOG(WARN) << "Journal: ignoring invalid snapshot " << snapshotPath();
+        return false;
+    }
+    std::memcpy(snapshot, data.data(), snapshotSize);
+    sequence = header.sequence;
+    return true;
+}
+
+bool Journal::open(void* snapshot, size_t snapshotSize, bool& snapshotLoaded)
+{
+    snapshotLoaded = false;
+    if (!FileUtils::MakeDirectory(config_.directory)) {
+        LOG(ERROR) << "Journal: cannot create directory " << config_.directory;
+        return false;
+    }
+
+    uint64_t snapshotSequence = 0;
+    snapshotLoaded = loadSnapshot(snapshot, snapshotSize, snapshotSequence);
+    snapshotWritten_ = snapshotSequence;
+
+    file_ = std::fopen(journalPath().c_str(), "r+b");
+    if (file_ == nullptr) {
+        file_ = std::fopen(journalPath().c_str(), "w+b");
+        if (file_ == nullptr) {
+            LOG(ERROR) << "Journal: cannot create " << journalPath();
+            return false;
+        }
+        JournalFileHeader header{};
+        std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+        header.version = FORMAT_VERSION;
+        header.recordSize = sizeof(JournalRecord);
+        std::fwrite(&header, sizeof(header), 1, file_);
+        FileUtils::SyncFile(file_);
+    }
+
+    JournalFileHeader header{};
+    FileUtils::SeekTo(file_, 0);
+    if (std::fread(&header, sizeof(header), 1, file_) != 1 ||
+        std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+        header.version != FORMAT_VERSION || header.recordSize != sizeof(JournalRecord)) {
+        LOG(ERROR) << "Journal: " << journalPath() << " is not a version " << FORMAT_VERSION << " journal";
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool Journal::replay(const ReplayHandler& handler, JournalRecoveryStats& stats)
+{
+    const auto started = std::chrono::steady_clock::now();
+    stats = JournalRecoveryStats();
+    if (file_ == nullptr) {
+        return false;
+    }
+    const uint64_t snapshotSequence = snapshotWritten_;
+    stats.snapshotSequence = snapshotSequence;
+    const size_t headerSize = sizeof(JournalFileHeader);
+
+    const long long fileSize = FileUtils::FileSize(file_);
+    const uint64_t recordCount = static_cast<uint64_t>(fileSize - static_cast<long long>(headerSize)) / sizeof(JournalRecord);
+    uint64_t validRecords = 0;
+    uint64_t lastSequence = snapshotSequence;
+
+    JournalRecord first{};
+    FileUtils::SeekTo(file_, headerSize);
+    if (recordCount > 0 && std::fread(&first, sizeof(first), 1, file_) == 1 &&
+        FileUtils::crc32(&first, CHECKSUMMED_BYTES) == first.checksum) {
+        // Fixed-size records with contiguous sequences: seek past everything the snapshot covers
+        const uint64_t firstSequence = first.sequence;
+        if (snapshotSequence + 1 < firstSequence) {
+            LOG(WARN) << "Journal: gap between snapshot " << snapshotSequence << " and first record " << firstSequence;
+        }
+        const uint64_t index = (snapshotSequence >= firstSequence) ? snapshotSequence - firstSequence + 1 : 0;
+        bool intact = true;
+        if (index > recordCount) {
+            // The snapshot is newer than every record (unsynced writes lost in an OS crash).
+            // Records appended after these would not sit at their sequence's offset: the file
+            // is cut back to its header and restarts after the snapshot
+            LOG(WARN) << "Journal: snapshot " << snapshotSequence << " is ahead of the last record "
+                      << (firstSequence + recordCount - 1) << ", starting a new journal";
+            intact = false;
+        } else {
+            validRecords = index;
+            lastSequence = std::max(snapshotSequence, firstSequence + index - 1);
+        }
+
+        std::vector<JournalRecord> chunk(REPLAY_CHUNK);
+        FileUtils::SeekTo(file_, static_cast<long long>(headerSize + validRecords * sizeof(JournalRecord)));
+        while (intact && validRecords < recordCount) {
+            const size_t wanted = static_cast<size_t>(std::min<uint64_t>(REPLAY_CHUNK, recordCount - validRecords));
+            const size_t got = std::fread(chunk.data(), sizeof(JournalRecord), wanted, file_);
+            for (size_t i = 0; i < got; ++i) {
+                const JournalRecord& record = chunk[i];
+                if (FileUtils::crc32(&record, CHECKSUMMED_BYTES) != record.checksum || record.sequence != firstSequence + validRecords) {
+                    intact = false;
+                    break;
+                }
+                handler(record);
+                lastSequence = record.sequence;
+                ++validRecords;
+                ++stats.replayed;
+            }
+            intact = intact && got == wanted;
+        }
+    }
+
+    // Cut a torn or corrupt tail so new records follow the last good one
+    const long long validSize = static_cast<long long>(headerSize + validRecords * sizeof(JournalRecord));
+    if (validSize < fileSize) {
+        stats.discardedBytes = static_cast<uint64_t>(fileSize - validSize);
+        LOG(WARN) << "Journal: discarding " << stats.discardedBytes << " bytes after record " << lastSequence;
+        std::fflush(file_);
+        FileUtils::TruncateFile(file_, validSize);
+    }
+    FileUtils::SeekTo(file_, 0, SEEK_END);
+
+    nextSequence_ = lastSequence + 1;
+    durableSequence_.store(lastSequence, std::memory_order_release);
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return true;
+}
+
+bool Journal::start()
+{
+    if (!config_.enabled || file_ == nullptr || running_.load(std::memory_order_acquire)) {
+        return config_.enabled ? file_ != nullptr : true;
+    }
+    // Recovery left the stream at the end; a failed commit is rewritten from here
+    std::fflush(file_);
+    appendOffset_ = static_cast<uint64_t>(FileUtils::FileSize(file_));
+    if (config_.ioUring && !uring_.init(8)) {
+        LOG(WARN) << "Journal: group commits through stdio";
+    }
+    running_.store(true, std::memory_order_release);
+    ioThread_ = std::thread(&Journal::run, this);
+    return true;
+}
+
+void Journal::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (ioThread_.joinable()) {
+        ioThread_.join();
+    }
+}
+
+uint64_t Journal::append(JournalRecord& record)
+{
+    if (failed_.load(std::memory_order_acquire)) {
+        return 0;   // Nothing more reaches the disk; the owner stops trading
+    }
+    record.sequence = nextSequence_++;
+    std::memset(record.reserved, 0, sizeof(record.reserved));
+    record.checksum = FileUtils::crc32(&record, CHECKSUMMED_BYTES);
+    // Durability over latency: a full ring means the disk is far behind, so wait for it
+    while (!ring_->tryPush(record)) {
+        if (failed_.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        ++producerStalls_;
+        std::this_thread::yield();
+    }
+    ++appendedSinceSnapshot_;
+    return record.sequence;
+}
+
+void Journal::snapshot(const void* data, size_t size)
+{
+    if (size > MAX_SNAPSHOT_BYTES) {
+        LOG(ERROR) << "Journal: snapshot of " << size << " bytes exceeds " << MAX_SNAPSHOT_BYTES;
+        return;
+    }
+    SnapshotImage& image = snapshot_.beginWrite();
+    image.sequence = lastSequence();
+    image.size = static_cast<uint32_t>(size);
+    std::memcpy(image.data, data, size);
+    snapshot_.endWrite();
+    snapshotRequested_.store(image.sequence, std::memory_order_release);
+    appendedSinceSnapshot_ = 0;
+}
+
+size_t Journal::flushBatch()
+{
+    batch_.clear();
+    JournalRecord record;
+    while (batch_.size() < batch_.capacity() && ring_->tryPop(record)) {
+        batch_.push_back(record);
+    }
+    if (batch_.empty()) {
+        return 0;
+    }
+
+    // Group commit: one write and one sync for everything that accumulated. A failed
+    // attempt is rewritten whole at the same offset, over whatever part of it landed
+    for (int attempt = 1; !commitBatch(); ++attempt) {
+        LOG(ERROR) << "Journal: write of records " << batch_.front().sequence << "-" << batch_.back().sequence
+                   << " failed (attempt " << attempt << " of " << COMMIT_ATTEMPTS << ")";
+        if (attempt == COMMIT_ATTEMPTS) {
+            LOG(ERROR) << "Journal: FAILED, durable up to record " << durableSequence() << "; no further records are written";
+            failed_.store(true, std::memory_order_release);
+            return batch_.size();
+        }
+        std::this_thread::sleep_for(COMMIT_RETRY_DELAY);
+    }
+    appendOffset_ += batch_.size() * sizeof(JournalRecord);
+    durableSequence_.store(batch_.back().sequence, std::memory_order_release);
+    groupCommits_.fetch_add(1, std::memory_order_relaxed);
+    return batch_.size();
+}
+
+bool Journal::commitBatch()
+{
+    if (uring_.ready()) {
+        return commitUring();
+    }
+    std::clearerr(file_);
+    return FileUtils::SeekTo(file_, static_cast<long long>(appendOffset_)) &&
+           std::fwrite(batch_.data(), sizeof(JournalRecord), batch_.size(), file_) == batch_.size() &&
+           (config_.sync ? FileUtils::SyncFile(file_) : std::fflush(file_) == 0);
+}
+
+bool Journal::commitUring()
+{
+    const int fd = fileno(file_);
+    const uint32_t bytes = static_cast<uint32_t>(batch_.size() * sizeof(JournalRecord));
+    const unsigned operations = config_.sync ? 2 : 1;
+    if (!uring_.write(fd, batch_.data(), bytes, appendOffset_, 0, config_.sync) ||
+        (config_.sync && !uring_.fdatasync(fd, 1)) ||
+        !uring_.submit(operations)) {
+        return false;
+    }
+    bool ok = true;
+    IoCompletion completion;
+    for (unsigned i = 0; i < operations; ++i) {
+        if (!uring_.next(completion)) {
+            return false;
+        }
+        ok = ok && completion.result == (completion.userData == 0 ? static_cast<int32_t>(bytes) : 0);
+    }
+    return ok;
+}
+
+bool Journal::writeSnapshot(const SnapshotImage& image)
+{
+    SnapshotFileHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.sequence = image.sequence;
+    header.size = image.size;
+    header.checksum = FileUtils::crc32(image.data, image.size);
+    return FileUtils::WriteFileAtomic(snapshotPath(), &header, sizeof(header), image.data, image.size);
+}
+
+void Journal::run()
+{
+    ThreadPlacement::instance().apply(ThreadRole::JOURNAL);
+
+    auto writePendingSnapshot = [this] {
+        if (snapshotRequested_.load(std::memory_order_acquire) <= snapshotWritten_) {
+            return;
+        }
+        // The executor may have published a newer image since: decide on the sequence the
+        // image read carries, and write it only once every record it covers is durable
+        const SnapshotImage image = snapshot_.read();
+        if (image.sequence > snapshotWritten_ && image.sequence <= durableSequence_.load(std::memory_order_acquire)) {
+            if (writeSnapshot(image)) {
+                snapshotWritten_ = image.sequence;
+            } else {
+                LOG(ERROR) << "Journal: snapshot at record " << image.sequence << " failed";
+            }
+        }
+    };
+
+    while ((running_.load(std::memory_order_acquire) || !ring_->empty()) && !failed()) {
+        const size_t written = flushBatch();
+        writePendingSnapshot();
+        if (written == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    if (!failed()) {
+        flushBatch();
+        writePendingSnapshot();
+    }
+}
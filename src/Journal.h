@@ -0,0 +1,186 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FixedPoint.h"
+#include "IoUring.h"
+#include "SeqLock.h"
+#include "SpscRing.h"
+#include "SymbolTable.h"
+
+enum class JournalRecordType : uint8_t
+{
+    SIGNAL = 1,   // Accepted ActionSignal: side = ActionType
+    ORDER = 2,    // Order reached a terminal state: side = OrderSide, state = OrderState
+    FILL = 3,     // Execution against one of our orders: side = OrderSide
+    SYMBOL = 4,   // Names a SymbolId of the writing process, before that process first uses it
+};
+
+// Fixed size, so replay can seek straight to any sequence number
+struct JournalRecord
+{
+    uint64_t sequence;
+    long long timestampMs;
+    uint64_t orderId;
+    PriceTicks price;
+    QtyLots quantity;
+    QtyLots filled;             // ORDER: total executed quantity
+    SymbolId symbol;
+    JournalRecordType type;
+    uint8_t side;
+    uint8_t state;
+    uint8_t reserved[7];
+    uint32_t checksum;          // CRC-32 of the preceding bytes
+};
+
+static_assert(sizeof(JournalRecord) == 64, "Journal records are one cache line on disk");
+
+// SYMBOL records carry the name, '\0'-padded, in the orderId and price fields
+static_assert(MAX_SYMBOL_LENGTH + 1 == sizeof(uint64_t) + sizeof(PriceTicks), "A symbol name fills orderId and price");
+
+inline void setJournalSymbolName(JournalRecord& record, const char* name)
+{
+    char padded[MAX_SYMBOL_LENGTH + 1] = {};
+    std::strncpy(padded, name, MAX_SYMBOL_LENGTH);
+    std::memcpy(&record.orderId, padded, sizeof(record.orderId));
+    std::memcpy(&record.price, padded + sizeof(record.orderId), sizeof(record.price));
+}
+
+inline void journalSymbolName(const JournalRecord& record, char (&name)[MAX_SYMBOL_LENGTH + 1])
+{
+    std::memcpy(name, &record.orderId, sizeof(record.orderId));
+    std::memcpy(name + sizeof(record.orderId), &record.price, sizeof(record.price));
+    name[MAX_SYMBOL_LENGTH] = '\0';
+}
+
+struct JournalConfig
+{
+    bool enabled = false;
+    std::string directory = "journal";
+    bool sync = true;                  // fdatasync each group commit
+    size_t ringCapacity = 65536;       // Records buffered between executor and I/O thread
+    uint64_t snapshotEvery = 10000;    // Records between portfolio snapshots (0 = only at shutdown)
+    bool ioUring = false;              // Group commit as one io_uring submission; needs a USE_IO_URING=1 build
+};
+
+struct JournalRecoveryStats
+{
+    uint64_t snapshotSequence = 0;     // 0 = no snapshot
+    uint64_t replayed = 0;             // Records applied after the snapshot
+    uint64_t discardedBytes = 0;       // Torn or corrupt tail truncated away
+    double milliseconds = 0.0;
+};
+
+/**
+ * @class Journal
+ * @brief Append-only write-ahead log of signals, orders and fills, plus periodic snapshots.
+ *
+ * The executor appends records into a lock-free ring and never touches the disk. A
+ * dedicated I/O thread drains whatever has accumulated, writes it with one call and
+ * makes it durable with one fdatasync (group commit). Snapshots are opaque, trivially
+ * copyable state images published through a SeqLock; the I/O thread writes one only
+ * after every record it covers is durable, and replaces the previous one atomically.
+ *
+ * SymbolIds are handed out per process in feed arrival order, so the owner names each
+ * id with a SYMBOL record before first using it in a run, and stores the names of the
+ * ids a snapshot indexes inside the snapshot; recovery maps them back by name.
+ *
+ * Startup: open() loads the snapshot, replay() seeks to the first record after it,
+ * replays the tail and truncates a torn last write. Then start() launches the I/O thread.
+ *
+ * A group commit that fails is rewritten at the same offset a few times; if it still
+ * fails the journal latches failed(): nothing after the last durable record is written,
+ * so no sequence number is ever skipped on disk, and the owner must stop trading.
+ */
+class Journal
+{
+public:
+    static constexpr size_t MAX_SNAPSHOT_BYTES = 16 * 1024;
+
+    using ReplayHandler = std::function<void(const JournalRecord&)>;
+
+    Journal() = default;
+    ~Journal();
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Startup only, in this order: configure(), open(), replay(), start()
+    void configure(const JournalConfig& config);
+    bool enabled() const { return config_.enabled; }
+
+    // Opens (or creates) the journal; copies the snapshot into 'snapshot' if one of this size exists
+    bool open(void* snapshot, size_t snapshotSize, bool& snapshotLoaded);
+
+    // Feeds every intact record after the snapshot to 'handler'
+    bool replay(const ReplayHandler& handler, JournalRecoveryStats& stats);
+
+    bool start();
+    void stop();   // Drains, syncs and joins the I/O thread
+
+    // Executor thread: assigns the sequence number and checksum; spins only if the ring is full
+    uint64_t append(JournalRecord& record);
+
+    // Executor thread: publishes a state image covering every record appended so far
+    void snapshot(const void* data, size_t size);
+
+    // Called by the owner to decide when to snapshot
+    bool snapshotDue() const { return config_.snapshotEvery > 0 && appendedSinceSnapshot_ >= config_.snapshotEvery; }
+
+    uint64_t lastSequence() const { return nextSequence_ - 1; }
+    uint64_t durableSequence() const { return durableSequence_.load(std::memory_order_acquire); }
+    uint64_t groupCommits() const { return groupCommits_.load(std::memory_order_relaxed); }
+    uint64_t producerStalls() const { return producerStalls_; }
+    bool failed() const { return failed_.load(std::memory_order_acquire); }
+    size_t pending() const { return ring_ ? ring_->size() : 0; }   // Records not yet written
+
+private:
+    struct SnapshotImage
+    {
+        uint64_t sequence;
+        uint32_t size;
+        unsigned char data[MAX_SNAPSHOT_BYTES];
+    };
+
+    std::string journalPath() const { return config_.directory + "/journal.bin"; }
+    std::string snapshotPath() const { return config_.directory + "/snapshot.bin"; }
+    bool loadSnapshot(void* snapshot, size_t snapshotSize, uint64_t& sequence);
+    bool writeSnapshot(const SnapshotImage& image);
+    void run();
+    size_t flushBatch();
+    // Writes and syncs batch_ at appendOffset_; false if any part failed
+    bool commitBatch();
+    // Write + linked fdatasync of batch_ at appendOffset_, one system call
+    bool commitUring();
+
+    JournalConfig config_;
+    std::FILE* file_ = nullptr;
+    std::thread ioThread_;
+    std::atomic<bool> running_{false};
+
+    // Producer side (executor thread)
+    std::unique_ptr<SpscRing<JournalRecord>> ring_;
+    uint64_t nextSequence_ = 1;
+    uint64_t appendedSinceSnapshot_ = 0;
+    uint64_t producerStalls_ = 0;
+    SeqLock<SnapshotImage> snapshot_;
+    std::atomic<uint64_t> snapshotRequested_{0};   // Sequence of the newest published image
+
+    // I/O thread
+    std::vector<JournalRecord> batch_;
+    IoUring uring_;                    // Ready if config_.ioUring and the kernel allows
+    uint64_t appendOffset_ = 0;        // End of the durable part of the journal file
+    uint64_t snapshotWritten_ = 0;     // Also the sequence of the snapshot loaded by open()
+    std::atomic<uint64_t> durableSequence_{0};
+    std::atomic<uint64_t> groupCommits_{0};
+    std::atomic<bool> failed_{false};
+};
+
+#endif // JOURNAL_H
@@ -0,0 +1,46 @@
+#ifndef MARK_BOARD_H
+#define MARK_BOARD_H
+
+#include <atomic>
+#include <cstdint>
+#include "SymbolTable.h"
+
+static_assert(MAX_SYMBOLS <= 64, "MarkBoard keeps one dirty bit per symbol in a uint64_t");
+
+/**
+ * @class MarkBoard
+ * @brief Latest tick price per symbol, handed from the feed thread to the portfolio writer.
+ *
+ * publish() is an atomic store plus a dirty bit; take() swaps the dirty mask out, so
+ * ticks that arrive faster than the consumer runs coalesce into one mark per symbol.
+ */
+class MarkBoard
+{
+public:
+    MarkBoard()
+    {
+        for (auto& price : prices_) {
+            price.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Returns true if the board was clean, i.e. the consumer may need a wake-up
+    bool publish(SymbolId symbol, PriceTicks price)
+    {
+        prices_[symbol].store(price, std::memory_order_relaxed);
+        return dirty_.fetch_or(uint64_t(1) << symbol, std::memory_order_release) == 0;
+    }
+
+    bool pending() const { return dirty_.load(std::memory_order_acquire) != 0; }
+
+    // Dirty symbols since the last call; read their prices with price()
+    uint64_t take() { return dirty_.exchange(0, std::memory_order_acquire); }
+
+    PriceTicks price(SymbolId symbol) const { return prices_[symbol].load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<PriceTicks> prices_[MAX_SYMBOLS];
+    std::atomic<uint64_t> dirty_{0};
+};
+
+#endif // MARK_BOARD_H
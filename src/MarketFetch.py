@@ -1,3 +1,4 @@
+import select
 import socket
 import time
 import json
@@ -19,6 +20,10 @@ DATA_FILE = args.output
 data_queue = deque()
 flush_counter = 0
 
+# Per-symbol sequence numbers (from 1) and the last messages sent, for replay requests
+sequences = {}
+sent_history = {}
+
 
 def fetch_price_binance():
     url = "https://api.binance.com/api/v3/ticker/price"
@@ -76,19 +81,63 @@ def write_csv():
     print(f"[CSV] Updated with {len(data_queue)} entries")
 
 
-def start_sender():
-    global flush_counter
+def connect():
     sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
     # Added retry mechanism to prevent connection failure if C++ Server is not yet ready
-    connected = False
-    while not connected:
+    while True:
         try:
             sock.connect(('localhost', 9999))
-            connected = True
+            return sock
         except ConnectionRefusedError:
             print("[WAIT] Waiting for C++ Server to listen on 9999...")
             time.sleep(1)
 
+
+def sequence(data):
+    symbol = data["symbol"]
+    data["seq"] = sequences.get(symbol, 0) + 1
+    sequences[symbol] = data["seq"]
+    history = sent_history.setdefault(symbol, deque(maxlen=MAX_ENTRIES))
+    history.append((data["seq"], json.dumps(data) + "\n"))
+
+
+def replay(sock, request):
+    """Resends everything kept from request["from"] on. If the oldest kept tick is past
+    "from", the engine sees the gap again once its replay timeout expires and rebuilds."""
+    symbol = request.get("replay")
+    first = request.get("from", 0)
+    messages = [message for seq, message in sent_history.get(symbol, ()) if seq >= first]
+    sock.sendall("".join(messages).encode('utf-8'))
+    print(f"[REPLAY] {symbol} resent {len(messages)} ticks from seq {first}")
+
+
+def wait_for_requests(sock, buffer, seconds):
+    """Sleeps until the next tick is due, serving replay requests from the engine meanwhile."""
+    deadline = time.time() + seconds
+    while True:
+        remaining = deadline - time.time()
+        if remaining <= 0:
+            return buffer
+        readable, _, _ = select.select([sock], [], [], remaining)
+        if not readable:
+            return buffer
+        chunk = sock.recv(4096)
+        if not chunk:
+            raise ConnectionResetError("engine closed the connection")
+        buffer += chunk
+        while b"\n" in buffer:
+            line, buffer = buffer.split(b"\n", 1)
+            try:
+                replay(sock, json.loads(line))
+            except ValueError:
+                print(f"[WARN] Ignoring malformed request: {line!r}")
+
+
+def start_sender():
+    global flush_counter
+    sock = connect()
+    buffer = b""
+
     while True:
         # Replace original fetch_price_binance with the wrapped function
         data = get_market_data()
@@ -96,8 +145,16 @@ def start_sender():
             print("[SKIP] No valid data to send")
             time.sleep(5)
             continue
-        message = json.dumps(data) + "\n"
-        sock.sendall(message.encode('utf-8'))
+        # Numbered even if the send fails: the engine sees the gap and asks for a replay
+        sequence(data)
+        try:
+            sock.sendall(sent_history[data["symbol"]][-1][1].encode('utf-8'))
+            buffer = wait_for_requests(sock, buffer, 1)
+        except OSError as e:
+            print(f"[WARN] Connection lost ({e}), reconnecting")
+            sock.close()
+            sock = connect()
+            buffer = b""
 
         data_queue.append(data)
         if len(data_queue) > MAX_ENTRIES:
@@ -108,7 +165,5 @@ def start_sender():
             write_csv()
             flush_counter = 0
 
-        time.sleep(1)
-
 if __name__ == "__main__":
     start_sender()
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "Metrics.h"
+#include <cstdio>
+
+namespace {
+
+struct MetricInfo
+{
+    const char* name;
+    const char* help;
+};
+
+const MetricInfo COUNTER_INFO[] = {
+    {"ticks_received", "Ticks received from the feed"},
+    {"parse_errors", "Feed messages that failed to parse"},
+    {"signals", "Signals queued for the executor"},
+    {"signals_rejected", "Signals stopped by the risk gate"},
+    {"signals_processed", "Signals handled by the executor"},
+    {"orders", "Orders created by the executor"},
+    {"fills", "Executions against our orders"},
+    {"feed_gaps", "Sequence gaps detected on the live feed"},
+    {"feed_missing_ticks", "Ticks missing across feed sequence gaps"},
+    {"feed_discarded", "Feed ticks discarded as duplicates or while a replay is pending"},
+    {"feed_replay_requests", "Replay requests sent to the feeder"},
+    {"feed_window_rebuilds", "Price windows cleared after an unrecoverable gap or feed restart"},
+    {"ticks_conflated", "Ticks superseded by a newer one of the same symbol before strategy evaluation"},
+    {"feed_batches", "Feed batches processed in batch mode (ticks_received / feed_batches = mean batch size)"},
+    {"bars_closed", "OHLCV bars completed, over all bar series and symbols"},
+};
+
+const MetricInfo LATENCY_INFO[] = {
+    {"tick_processing", "Tick received to strategies evaluated"},
+    {"tick_to_signal", "Tick received to signal queued"},
+    {"tick_to_fill", "Tick received to fill applied"},
+};
+
+static_assert(sizeof(COUNTER_INFO) / sizeof(COUNTER_INFO[0]) == static_cast<size_t>(MetricCounter::COUNT),
+              "One entry per MetricCounter");
+static_assert(sizeof(LATENCY_INFO) / sizeof(LATENCY_INFO[0]) == static_cast<size_t>(MetricLatency::COUNT),
+              "One entry per MetricLatency");
+
+void AppendHeader(std::string& out, const std::string& name, const char* help, const char* type)
+{
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+void AppendSample(std::string& out, const std::string& name, double value)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), " %.17g\n", value);
+    out.append(name).append(buffer);
+}
+
+} // namespace
+
+MetricsShard::MetricsShard()
+{
+    for (auto& counter : counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (auto& histogram : latencies) {
+        for (auto& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.sumNs.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencySummary::quantileNs(double q) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return LATENCY_FIRST_BOUND_NS << i;
+        }
+    }
+    return LATENCY_FIRST_BOUND_NS << (LATENCY_BUCKETS - 1);
+}
+
+const char* Metrics::counterName(MetricCounter counter)
+{
+    return COUNTER_INFO[static_cast<size_t>(counter)].name;
+}
+
+const char* Metrics::latencyName(MetricLatency latency)
+{
+    return LATENCY_INFO[static_cast<size_t>(latency)].name;
+}
+
+MetricsShard& Metrics::attach()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    shards_.push_back(std::make_unique<MetricsShard>());
+    return *shards_.back();
+}
+
+void Metrics::addGauge(const std::string& name, const std::string& help, GaugeReader read)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    gauges_.push_back(Gauge{name, help, std::move(read)});
+}
+
+MetricsSnapshot Metrics::snapshot() const
+{
+    MetricsSnapshot total;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& shard : shards_) {
+        for (size_t c = 0; c < static_cast<size_t>(MetricCounter::COUNT); ++c) {
+            total.counters[c] += shard->counters[c].load(std::memory_order_relaxed);
+        }
+        for (size_t l = 0; l < static_cast<size_t>(MetricLatency::COUNT); ++l) {
+            const MetricsShard::Histogram& histogram = shard->latencies[l];
+            LatencySummary& summary = total.latencies[l];
+            for (size_t b = 0; b < LATENCY_BUCKETS; ++b) {
+                summary.buckets[b] += histogram.buckets[b].load(std::memory_order_relaxed);
+            }
+            summary.count += histogram.count.load(std::memory_order_relaxed);
+            summary.sumNs += histogram.sumNs.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+std::string Metrics::renderPrometheus() const
+{
+    const MetricsSnapshot snap = snapshot();
+    std::string out;
+    out.reserve(16 * 1024);
+
+    for (size_t c = 0; c < static_cast<size_t>(MetricCounter::COUNT); ++c) {
+        const std::string name = std::string("trading_") + COUNTER_INFO[c].name + "_total";
+        AppendHeader(out, name, COUNTER_INFO[c].help, "counter");
+        AppendSample(out, name, static_cast<double>(snap.counters[c]));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Gauge& gauge : gauges_) {
+            const std::string name = "trading_" + gauge.name;
+            AppendHeader(out, name, gauge.help.c_str(), "gauge");
+            AppendSample(out, name, gauge.read(snap));
+        }
+    }
+
+    for (size_t l = 0; l < static_cast<size_t>(MetricLatency::COUNT); ++l) {
+        const std::string name = std::string("trading_") + LATENCY_INFO[l].name + "_seconds";
+        const LatencySummary& summary = snap.latencies[l];
+        AppendHeader(out, name, LATENCY_INFO[l].help, "histogram");
+        // Prometheus buckets are cumulative; the last log2 bucket is the +Inf one
+        uint64_t cumulative = 0;
+        char label[64];
+        for (size_t b = 0; b + 1 < LATENCY_BUCKETS; ++b) {
+            cumulative += summary.buckets[b];
+            std::snprintf(label, sizeof(label), "_bucket{le=\"%.9g\"}",
+                          static_cast<double>(LATENCY_FIRST_BOUND_NS << b) * 1e-9);
+            AppendSample(out, name + label, static_cast<double>(cumulative));
+        }
+        AppendSample(out, name + "_bucket{le=\"+Inf\"}", static_cast<double>(summary.count));
+        AppendSample(out, name + "_sum", static_cast<double>(summary.sumNs) * 1e-9);
+        AppendSample(out, name + "_count", static_cast<double>(summary.count));
+    }
+    return out;
+}
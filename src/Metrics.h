@@ -0,0 +1,181 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class MetricCounter : uint8_t
+{
+    TICKS_RECEIVED,
+    PARSE_ERRORS,
+    SIGNALS,              // Passed the risk gate and queued for the executor
+    SIGNALS_REJECTED,     // Stopped by the risk gate
+    SIGNALS_PROCESSED,    // Taken off the queue by the executor
+    ORDERS,
+    FILLS,
+    FEED_GAPS,            // Sequence gaps detected on the live feed
+    FEED_MISSING_TICKS,   // Ticks missing across those gaps
+    FEED_DISCARDED,       // Duplicates, and ticks held back while a replay is pending
+    FEED_REPLAY_REQUESTS,
+    FEED_WINDOW_REBUILDS, // Price windows cleared after an unrecoverable gap or feed restart
+    TICKS_CONFLATED,      // Overwritten in the conflation board before the strategy saw them
+    FEED_BATCHES,         // Batch mode: socket wakeups processed as one batch
+    BARS_CLOSED,          // Bars completed across all BAR_SERIES and symbols
+    COUNT
+};
+
+enum class MetricLatency : uint8_t
+{
+    TICK_PROCESSING,      // Tick received -> strategies evaluated
+    TICK_TO_SIGNAL,       // Tick received -> signal queued
+    TICK_TO_FILL,         // Tick received -> fill applied by the executor
+    COUNT
+};
+
+// Monotonic nanoseconds for latency measurements
+inline uint64_t monotonicNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 32-bit stamp carried in records that have no room for a full timestamp:
+// 64 ns units, differences exact for latencies below ~4.5 minutes
+inline uint32_t latencyStamp() { return static_cast<uint32_t>(monotonicNs() >> 6); }
+inline uint64_t stampToNs(uint32_t stamp) { return static_cast<uint64_t>(stamp) << 6; }
+inline uint64_t elapsedSinceStampNs(uint32_t stamp) { return stampToNs(latencyStamp() - stamp); }
+
+// Log2 buckets: bucket i counts latencies below 128 ns << i; the last one is unbounded
+constexpr size_t LATENCY_BUCKETS = 32;
+constexpr uint64_t LATENCY_FIRST_BOUND_NS = 128;
+
+inline size_t latencyBucket(uint64_t ns)
+{
+    const uint64_t scaled = ns / LATENCY_FIRST_BOUND_NS;
+    const size_t bucket = (scaled == 0) ? 0 : static_cast<size_t>(64 - __builtin_clzll(scaled));
+    return bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1;
+}
+
+/**
+ * @struct MetricsShard
+ * @brief One thread's counters and latency histograms.
+ *
+ * Only the owning thread writes, so an update is a relaxed load and store on a line
+ * no other thread writes: no lock prefix, no contention. Scrapes read with relaxed
+ * loads and sum across shards.
+ */
+struct alignas(64) MetricsShard
+{
+    struct Histogram
+    {
+        std::atomic<uint64_t> buckets[LATENCY_BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sumNs;
+    };
+
+    std::atomic<uint64_t> counters[static_cast<size_t>(MetricCounter::COUNT)];
+    Histogram latencies[static_cast<size_t>(MetricLatency::COUNT)];
+
+    MetricsShard();
+
+    void add(MetricCounter counter, uint64_t n = 1)
+    {
+        bump(counters[static_cast<size_t>(counter)], n);
+    }
+
+    void record(MetricLatency latency, uint64_t ns)
+    {
+        Histogram& histogram = latencies[static_cast<size_t>(latency)];
+        bump(histogram.buckets[latencyBucket(ns)], 1);
+        bump(histogram.count, 1);
+        bump(histogram.sumNs, ns);
+    }
+
+private:
+    static void bump(std::atomic<uint64_t>& value, uint64_t n)
+    {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+struct LatencySummary
+{
+    uint64_t buckets[LATENCY_BUCKETS] = {};
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+
+    // Upper bound of the bucket holding quantile q (0..1); 0 when empty
+    uint64_t quantileNs(double q) const;
+};
+
+struct MetricsSnapshot
+{
+    uint64_t counters[static_cast<size_t>(MetricCounter::COUNT)] = {};
+    LatencySummary latencies[static_cast<size_t>(MetricLatency::COUNT)];
+
+    uint64_t counter(MetricCounter c) const { return counters[static_cast<size_t>(c)]; }
+    const LatencySummary& latency(MetricLatency l) const { return latencies[static_cast<size_t>(l)]; }
+};
+
+/**
+ * @class Metrics
+ * @brief Process-wide registry of engine counters, gauges and latency histograms.
+ *
+ * Hot threads update their own MetricsShard through count() and latency(); the shard is
+ * created on a thread's first update and kept for the life of the process, so counts
+ * survive the thread. Everything else (summing shards, gauges, formatting) happens
+ * only when snapshot() or renderPrometheus() is called.
+ */
+class Metrics
+{
+public:
+    static Metrics& instance()
+    {
+        static Metrics inst;
+        return inst;
+    }
+
+    static MetricsShard& local()
+    {
+        thread_local MetricsShard& shard = instance().attach();
+        return shard;
+    }
+
+    static void count(MetricCounter counter, uint64_t n = 1) { local().add(counter, n); }
+    static void latency(MetricLatency latency, uint64_t ns) { local().record(latency, ns); }
+
+    static const char* counterName(MetricCounter counter);
+    static const char* latencyName(MetricLatency latency);
+
+    // Evaluated at scrape time (queue depths, derived values); registered at startup
+    using GaugeReader = std::function<double(const MetricsSnapshot&)>;
+    void addGauge(const std::string& name, const std::string& help, GaugeReader read);
+
+    MetricsSnapshot snapshot() const;
+
+    // Prometheus text exposition format 0.0.4
+    std::string renderPrometheus() const;
+
+private:
+    Metrics() = default;
+    MetricsShard& attach();
+
+    struct Gauge
+    {
+        std::string name;
+        std::string help;
+        GaugeReader read;
+    };
+
+    mutable std::mutex mutex_;      // Thread registration and scrapes only
+    std::vector<std::unique_ptr<MetricsShard>> shards_;
+    std::vector<Gauge> gauges_;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,138 @@
+#include "MetricsServer.h"
+#include <chrono>
+#include <cstring>
+#include "Metrics.h"
+#include "pch.h"
+#include "../util/PlatformUtils.h"
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    using SocketHandle = SOCKET;
+    #define SEND_FLAGS 0
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    using SocketHandle = int;
+    #define SEND_FLAGS MSG_NOSIGNAL    // A scraper hanging up must not raise SIGPIPE
+#endif
+
+namespace {
+
+bool SendAll(SocketHandle socket, const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const int n = send(socket, data.data() + sent, static_cast<int>(data.size() - sent), SEND_FLAGS);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+bool MetricsServer::start()
+{
+    if (!enabled() || running_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (!PlatformUtils::initSocketEnv()) {
+        return false;
+    }
+
+    const SocketHandle listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET_VAL) {
+        return false;
+    }
+    const int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    if (inet_pton(AF_INET, config_.bindAddress.c_str(), &addr.sin_addr) != 1 ||
+        bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listener, 8) < 0) {
+        CLOSE_SOCKET(listener);
+        return false;
+    }
+    // accept() wakes up every 500ms to check for shutdown
+    PlatformUtils::setSocketRecvTimeout(listener, std::chrono::milliseconds(500));
+
+    listenSocket_ = static_cast<intptr_t>(listener);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&MetricsServer::run, this);
+    LOG(Main) << "Metrics: serving http://" << config_.bindAddress << ":" << config_.port << "/metrics";
+    return true;
+}
+
+void MetricsServer::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (listenSocket_ != -1) {
+        CLOSE_SOCKET(static_cast<SocketHandle>(listenSocket_));
+        listenSocket_ = -1;
+        PlatformUtils::cleanupSocketEnv();
+    }
+}
+
+void MetricsServer::run()
+{
+    const SocketHandle listener = static_cast<SocketHandle>(listenSocket_);
+    while (running_.load(std::memory_order_acquire)) {
+        const SocketHandle client = accept(listener, nullptr, nullptr);
+        if (client == INVALID_SOCKET_VAL) {
+            continue;   // Timeout: check the flag again
+        }
+        PlatformUtils::setSocketRecvTimeout(client, std::chrono::milliseconds(500));
+        serve(static_cast<intptr_t>(client));
+        CLOSE_SOCKET(client);
+    }
+}
+
+void MetricsServer::serve(intptr_t clientHandle)
+{
+    const SocketHandle client = static_cast<SocketHandle>(clientHandle);
+
+    // Only the request line matters; read until the end of the headers or the buffer is full
+    char request[2048];
+    size_t received = 0;
+    while (received < sizeof(request) - 1) {
+        const int n = recv(client, request + received, static_cast<int>(sizeof(request) - 1 - received), 0);
+        if (n <= 0) {
+            break;
+        }
+        received += static_cast<size_t>(n);
+        request[received] = '\0';
+        if (std::strstr(request, "\r\n\r\n") != nullptr || std::strstr(request, "\n\n") != nullptr) {
+            break;
+        }
+    }
+    request[received] = '\0';
+
+    std::string body;
+    const char* status = "200 OK";
+    if (std::strncmp(request, "GET /metrics", 12) == 0 || std::strncmp(request, "GET / ", 6) == 0) {
+        body = Metrics::instance().renderPrometheus();
+        scrapes_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        status = "404 Not Found";
+        body = "Not found; metrics are at /metrics\n";
+    }
+
+    std::string response;
+    response.reserve(body.size() + 160);
+    response.append("HTTP/1.1 ").append(status).append("\r\n");
+    response.append("Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n");
+    response.append("Content-Length: ").append(std::to_string(body.size())).append("\r\n");
+    response.append("Connection: close\r\n\r\n");
+    response.append(body);
+    SendAll(client, response);
+}
@@ -0,0 +1,50 @@
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+struct MetricsServerConfig
+{
+    uint16_t port = 0;                       // 0: disabled
+    std::string bindAddress = "127.0.0.1";   // Localhost only by default
+};
+
+/**
+ * @class MetricsServer
+ * @brief Minimal HTTP listener serving Metrics::renderPrometheus() on GET /metrics.
+ *
+ * One background thread, one request per connection. All aggregation happens here on
+ * the scrape, so a scraper polling at any rate costs the trading threads nothing.
+ */
+class MetricsServer
+{
+public:
+    MetricsServer() = default;
+    ~MetricsServer() { stop(); }
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    void configure(const MetricsServerConfig& config) { config_ = config; }
+    bool enabled() const { return config_.port != 0; }
+
+    // Binds on the caller's thread so a busy port is reported at startup
+    bool start();
+    void stop();
+
+    uint64_t scrapes() const { return scrapes_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void serve(intptr_t client);
+
+    MetricsServerConfig config_;
+    intptr_t listenSocket_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> scrapes_{0};
+};
+
+#endif // METRICS_SERVER_H
@@ -0,0 +1,223 @@
+#include "MulticastFeed.h"
+#include <cerrno>
+#include <chrono>
+#include <vector>
+#include "IoUring.h"
+#include "pch.h"
+#include "../util/PlatformUtils.h"
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    using SocketHandle = SOCKET;
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    using SocketHandle = int;
+#endif
+
+struct MulticastFeed::Ring
+{
+    std::vector<char> buffers;          // batch * datagramBytes, one slot per datagram
+    std::vector<const char*> slots;     // Into buffers, or into the io_uring provided buffers
+    std::vector<uint32_t> lengths;
+    std::vector<uint8_t> truncated;
+    IoUring uring;
+    std::vector<uint16_t> held;         // Provided buffers of the last batch, recycled on the next receive
+#ifdef __linux__
+    std::vector<iovec> iov;
+    std::vector<mmsghdr> headers;
+#endif
+};
+
+MulticastFeed::MulticastFeed() = default;
+
+MulticastFeed::~MulticastFeed()
+{
+    close();
+}
+
+bool MulticastFeed::open(const MulticastFeedConfig& config)
+{
+    close();
+    config_ = config;
+    config_.batch = config.batch > 0 ? config.batch : 1;
+    if (!PlatformUtils::initSocketEnv()) {
+        return false;
+    }
+
+    const SocketHandle fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd == INVALID_SOCKET_VAL) {
+        LOG(ERROR) << "Multicast feed: cannot create socket";
+        PlatformUtils::cleanupSocketEnv();
+        return false;
+    }
+    // Several receivers (e.g. a second engine) may join the same group on one host
+    const int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    const int receiveBuffer = static_cast<int>(config_.receiveBufferBytes);
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&receiveBuffer), sizeof(receiveBuffer));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    ip_mreq membership{};
+    if (inet_pton(AF_INET, config_.group.c_str(), &membership.imr_multiaddr) != 1 ||
+        inet_pton(AF_INET, config_.interfaceAddress.c_str(), &membership.imr_interface) != 1) {
+        LOG(ERROR) << "Multicast feed: invalid group " << config_.group << " or interface " << config_.interfaceAddress;
+        CLOSE_SOCKET(fd);
+        PlatformUtils::cleanupSocketEnv();
+        return false;
+    }
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        LOG(ERROR) << "Multicast feed: bind to port " << config_.port << " failed";
+        CLOSE_SOCKET(fd);
+        PlatformUtils::cleanupSocketEnv();
+        return false;
+    }
+    if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<const char*>(&membership),
+                   sizeof(membership)) < 0) {
+        LOG(ERROR) << "Multicast feed: cannot join " << config_.group << " on " << config_.interfaceAddress;
+        CLOSE_SOCKET(fd);
+        PlatformUtils::cleanupSocketEnv();
+        return false;
+    }
+    // The first datagram of a batch waits at most 500ms, so the caller can check for shutdown
+    PlatformUtils::setSocketRecvTimeout(fd, std::chrono::milliseconds(500));
+
+    ring_.reset(new Ring);
+    ring_->buffers.resize(size_t(config_.batch) * config_.datagramBytes);
+    ring_->slots.resize(config_.batch);
+    for (uint32_t i = 0; i < config_.batch; ++i) {
+        ring_->slots[i] = &ring_->buffers[size_t(i) * config_.datagramBytes];
+    }
+    ring_->lengths.assign(config_.batch, 0);
+    ring_->truncated.assign(config_.batch, 0);
+    if (config_.ioUring) {
+        // Twice the batch, so the kernel always has free buffers while one batch is held
+        uint16_t count = 2;
+        while (count < 2 * config_.batch && count < 16384) {
+            count = static_cast<uint16_t>(count * 2);
+        }
+        ring_->held.reserve(config_.batch);
+        if (!ring_->uring.init(64) || !ring_->uring.provideBuffers(count, config_.datagramBytes) ||
+            !ring_->uring.recvMultishot(static_cast<int>(fd), 0) || !ring_->uring.submit()) {
+            LOG(WARN) << "Multicast feed: io_uring receive unavailable, using recvmmsg";
+            ring_->uring.close();
+        }
+    }
+#ifdef __linux__
+    ring_->iov.resize(config_.batch);
+    ring_->headers.assign(config_.batch, mmsghdr{});
+    for (uint32_t i = 0; i < config_.batch; ++i) {
+        ring_->iov[i].iov_base = &ring_->buffers[size_t(i) * config_.datagramBytes];
+        ring_->iov[i].iov_len = config_.datagramBytes;
+        ring_->headers[i].msg_hdr.msg_iov = &ring_->iov[i];
+        ring_->headers[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+    socket_ = static_cast<intptr_t>(fd);
+    LOG(Strategy) << "Multicast feed: joined " << config_.group << ":" << config_.port << " on "
+                  << config_.interfaceAddress << ", up to " << config_.batch << " datagrams per receive";
+    return true;
+}
+
+void MulticastFeed::close()
+{
+    if (ring_) {
+        // Its standing receive holds a reference to the socket
+        ring_->uring.close();
+    }
+    if (socket_ != -1) {
+        CLOSE_SOCKET(static_cast<SocketHandle>(socket_));
+        socket_ = -1;
+        PlatformUtils::cleanupSocketEnv();
+    }
+}
+
+int MulticastFeed::receive()
+{
+    if (socket_ == -1) {
+        return -1;
+    }
+    if (ring_->uring.ready()) {
+        return receiveUring();
+    }
+    const SocketHandle fd = static_cast<SocketHandle>(socket_);
+#ifdef __linux__
+    // MSG_WAITFORONE: block (up to the timeout) for the first datagram only
+    const int count = recvmmsg(fd, ring_->headers.data(), config_.batch, MSG_WAITFORONE, nullptr);
+    if (count < 0) {
+        return PlatformUtils::isSocketTimeout() ? 0 : -1;
+    }
+    for (int i = 0; i < count; ++i) {
+        ring_->lengths[i] = ring_->headers[i].msg_len;
+        ring_->truncated[i] = (ring_->headers[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    }
+    return count;
+#else
+    const int n = recv(fd, ring_->buffers.data(), static_cast<int>(config_.datagramBytes), 0);
+    if (n < 0) {
+        return PlatformUtils::isSocketTimeout() ? 0 : -1;
+    }
+    ring_->lengths[0] = static_cast<uint32_t>(n);
+    // Without MSG_TRUNC reporting, a full slot may have been cut short
+    ring_->truncated[0] = static_cast<uint32_t>(n) >= config_.datagramBytes;
+    return 1;
+#endif
+}
+
+int MulticastFeed::receiveUring()
+{
+    Ring& r = *ring_;
+    for (uint16_t id : r.held) {
+        r.uring.recycle(id);
+    }
+    r.held.clear();
+
+    // Waits up to 500ms for the first completion, then takes what is there, up to the batch size
+    IoCompletion completion;
+    if (!r.uring.peek(completion)) {
+        r.uring.submit(1, 500);
+    }
+    uint32_t count = 0;
+    while (count < config_.batch && r.uring.peek(completion)) {
+        r.uring.consume();
+        if (completion.hasBuffer()) {
+            r.held.push_back(completion.bufferId());
+            if (completion.result >= 0) {
+                r.slots[count] = r.uring.buffer(completion.bufferId());
+                r.lengths[count] = static_cast<uint32_t>(completion.result);
+                r.truncated[count] = static_cast<uint32_t>(completion.result) >= config_.datagramBytes;
+                ++count;
+            }
+        }
+        if (!completion.more()) {
+            // Out of buffers or failed; a UDP socket has nothing to close, so re-arm
+            if (completion.result != -ENOBUFS) {
+                LOG(WARN) << "Multicast feed: io_uring receive ended (" << completion.result << "), re-arming";
+            }
+            r.uring.recvMultishot(static_cast<int>(socket_), 0);
+            r.uring.submit();
+        }
+    }
+    return static_cast<int>(count);
+}
+
+const char* MulticastFeed::data(size_t slot) const
+{
+    return ring_->slots[slot];
+}
+
+size_t MulticastFeed::length(size_t slot) const
+{
+    return ring_->lengths[slot];
+}
+
+bool MulticastFeed::truncated(size_t slot) const
+{
+    return ring_->truncated[slot] != 0;
+}
@@ -0,0 +1,63 @@
+#ifndef MULTICAST_FEED_H
+#define MULTICAST_FEED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct MulticastFeedConfig
+{
+    std::string group = "239.255.0.1";
+    uint16_t port = 9999;
+    std::string interfaceAddress = "127.0.0.1";   // Local interface that joins the group
+    uint32_t batch = 64;                          // Datagrams per receive call
+    uint32_t datagramBytes = 2048;                // Larger datagrams are truncated and dropped
+    uint32_t receiveBufferBytes = 4 << 20;        // SO_RCVBUF; absorbs bursts while a batch is processed
+    bool ioUring = false;                         // Multishot receive into provided buffers (USE_IO_URING=1 build)
+};
+
+/**
+ * @class MulticastFeed
+ * @brief UDP multicast receiver reading up to config.batch datagrams per system call.
+ *
+ * All datagram buffers and message headers are allocated once, in open(), and reused
+ * by every receive(): a ring of 'batch' fixed-size slots that recvmmsg() fills in one
+ * call on Linux (one recv() per call elsewhere). With config.ioUring the slots are instead
+ * io_uring provided buffers filled by one standing multishot receive: receive() only
+ * collects completions, and returns the previous batch's buffers to the kernel.
+ * UDP gives no delivery guarantee; loss shows up as per-symbol sequence gaps, which
+ * FeedSequencer detects downstream.
+ */
+class MulticastFeed
+{
+public:
+    MulticastFeed();
+    ~MulticastFeed();
+    MulticastFeed(const MulticastFeed&) = delete;
+    MulticastFeed& operator=(const MulticastFeed&) = delete;
+
+    // Binds the port and joins the group; false (and logged) on failure
+    bool open(const MulticastFeedConfig& config);
+    void close();
+
+    // Waits up to 500 ms for the first datagram, then takes whatever else is queued, up to
+    // the ring size. Returns the number received (0 on timeout) or -1 on a socket error.
+    int receive();
+
+    const char* data(size_t slot) const;
+    size_t length(size_t slot) const;
+    // The datagram did not fit its slot; its content is incomplete (under io_uring, a
+    // datagram filling the whole slot is assumed to be cut short)
+    bool truncated(size_t slot) const;
+
+private:
+    int receiveUring();
+
+    struct Ring;
+    std::unique_ptr<Ring> ring_;
+    intptr_t socket_ = -1;
+    MulticastFeedConfig config_;
+};
+
+#endif // MULTICAST_FEED_H
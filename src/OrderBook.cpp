@@ -0,0 +1,232 @@
+#include "OrderBook.h"
+#include <algorithm>
+
+OrderBook::OrderBook(size_t levelCount, size_t maxOrders)
+    : levelCount_(levelCount),
+      bids_(levelCount),
+      asks_(levelCount),
+      bestBid_(-1),
+      bestAsk_(static_cast<int64_t>(levelCount)),
+      nodes_(maxOrders)
+{
+    freeList_.reserve(maxOrders);
+    clear();
+}
+
+void OrderBook::clear()
+{
+    std::fill(bids_.begin(), bids_.end(), Level());
+    std::fill(asks_.begin(), asks_.end(), Level());
+    bestBid_ = -1;
+    bestAsk_ = static_cast<int64_t>(levelCount_);
+    freeList_.clear();
+    // Hand out low indices first so a quiet book stays in the first cache lines
+    for (size_t i = nodes_.size(); i > 0; --i) {
+        nodes_[i - 1].active = false;
+        freeList_.push_back(static_cast<uint32_t>(i - 1));
+    }
+}
+
+BookResult OrderBook::submit(uint64_t orderId, OrderSide side, OrderType type, PriceTicks price, QtyLots quantity)
+{
+    BookResult result;
+    if (quantity <= 0) {
+        return result;
+    }
+
+    result.filled = match(orderId, side, type, price, quantity);
+    const QtyLots remaining = quantity - result.filled;
+    if (remaining == 0) {
+        return result;
+    }
+
+    if (type == OrderType::LIMIT && inWindow(price)) {
+        result.handle = rest(orderId, side, price, remaining);
+    }
+    if (result.handle != INVALID_ORDER_HANDLE) {
+        result.resting = remaining;
+    } else {
+        result.cancelled = remaining;
+    }
+    return result;
+}
+
+QtyLots OrderBook::match(uint64_t takerId, OrderSide side, OrderType type, PriceTicks price, QtyLots quantity)
+{
+    const bool isBuy = (side == OrderSide::BUY);
+    std::vector<Level>& opposite = isBuy ? asks_ : bids_;
+    QtyLots remaining = quantity;
+
+    while (remaining > 0 && (isBuy ? hasAsk() : hasBid())) {
+        const int64_t levelIndex = isBuy ? bestAsk_ : bestBid_;
+        const PriceTicks levelPrice = base_ + levelIndex;
+        if (type != OrderType::MARKET && (isBuy ? levelPrice > price : levelPrice < price)) {
+            break;
+        }
+
+        Level& level = opposite[levelIndex];
+        while (remaining > 0 && level.head != NIL) {
+            const uint32_t makerIndex = level.head;
+            Node& maker = nodes_[makerIndex];
+            const QtyLots quantityFilled = std::min(remaining, maker.remaining);
+            maker.remaining -= quantityFilled;
+            level.total -= quantityFilled;
+            remaining -= quantityFilled;
+
+            if (fillHandler_) {
+                fillHandler_(BookFill{takerId, maker.id, levelPrice, quantityFilled, side});
+            }
+            if (maker.remaining == 0) {
+                unlink(makerIndex);  // Also advances the best price once the level empties
+            }
+        }
+    }
+    return quantity - remaining;
+}
+
+OrderHandle OrderBook::rest(uint64_t orderId, OrderSide side, PriceTicks price, QtyLots quantity)
+{
+    if (freeList_.empty()) {
+        return INVALID_ORDER_HANDLE;
+    }
+    const uint32_t index = freeList_.back();
+    freeList_.pop_back();
+
+    const int64_t levelIndex = price - base_;
+    Level& level = (side == OrderSide::BUY) ? bids_[levelIndex] : asks_[levelIndex];
+
+    Node& node = nodes_[index];
+    node.id = orderId;
+    node.remaining = quantity;
+    node.price = price;
+    node.prev = level.tail;
+    node.next = NIL;
+    node.side = side;
+    node.active = true;
+
+    if (level.tail != NIL) {
+        nodes_[level.tail].next = index;
+    } else {
+        level.head = index;
+    }
+    level.tail = index;
+    level.total += quantity;
+
+    if (side == OrderSide::BUY) {
+        bestBid_ = std::max(bestBid_, levelIndex);
+    } else {
+        bestAsk_ = std::min(bestAsk_, levelIndex);
+    }
+    return index;
+}
+
+void OrderBook::unlink(uint32_t nodeIndex)
+{
+    Node& node = nodes_[nodeIndex];
+    const int64_t levelIndex = node.price - base_;
+    const bool isBuy = (node.side == OrderSide::BUY);
+    Level& level = isBuy ? bids_[levelIndex] : asks_[levelIndex];
+
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        level.head = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    } else {
+        level.tail = node.prev;
+    }
+    level.total -= node.remaining;
+    node.active = false;
+    freeList_.push_back(nodeIndex);
+
+    if (level.head != NIL) {
+        return;
+    }
+    // Level emptied: walk to the next populated level if it was the best one
+    if (isBuy && levelIndex == bestBid_) {
+        while (bestBid_ >= 0 && bids_[bestBid_].head == NIL) {
+            --bestBid_;
+        }
+    } else if (!isBuy && levelIndex == bestAsk_) {
+        while (bestAsk_ < static_cast<int64_t>(levelCount_) && asks_[bestAsk_].head == NIL) {
+            ++bestAsk_;
+        }
+    }
+}
+
+bool OrderBook::cancel(OrderHandle handle, uint64_t orderId)
+{
+    if (handle >= nodes_.size()) {
+        return false;
+    }
+    Node& node = nodes_[handle];
+    if (!node.active || node.id != orderId) {
+        return false;
+    }
+    unlink(handle);
+    return true;
+}
+
+QtyLots OrderBook::depthAt(OrderSide side, PriceTicks price) const
+{
+    if (!inWindow(price)) {
+        return 0;
+    }
+    const int64_t levelIndex = price - base_;
+    return (side == OrderSide::BUY) ? bids_[levelIndex].total : asks_[levelIndex].total;
+}
+
+bool OrderBook::canShift(const std::vector<Level>& levels, int64_t delta) const
+{
+    const int64_t count = static_cast<int64_t>(levelCount_);
+    // Levels that would drop out of the window must be empty
+    const int64_t first = delta > 0 ? 0 : std::max<int64_t>(0, count + delta);
+    const int64_t last = delta > 0 ? std::min(delta, count) : count;
+    for (int64_t i = first; i < last; ++i) {
+        if (levels[i].head != NIL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void OrderBook::shiftLevels(std::vector<Level>& levels, int64_t delta)
+{
+    const int64_t count = static_cast<int64_t>(levelCount_);
+    if (delta >= count || -delta >= count) {
+        std::fill(levels.begin(), levels.end(), Level());
+    } else if (delta > 0) {
+        std::move(levels.begin() + delta, levels.end(), levels.begin());
+        std::fill(levels.end() - delta, levels.end(), Level());
+    } else if (delta < 0) {
+        std::move_backward(levels.begin(), levels.end() + delta, levels.end());
+        std::fill(levels.begin(), levels.begin() - delta, Level());
+    }
+}
+
+bool OrderBook::recenter(PriceTicks mid)
+{
+    const PriceTicks newBase = mid - static_cast<PriceTicks>(levelCount_ / 2);
+    const int64_t delta = newBase - base_;
+    if (delta == 0) {
+        return true;
+    }
+    if (!canShift(bids_, delta) || !canShift(asks_, delta)) {
+        return false;
+    }
+
+    shiftLevels(bids_, delta);
+    shiftLevels(asks_, delta);
+    base_ = newBase;
+    if (bestBid_ >= 0) {
+        bestBid_ -= delta;
+    }
+    if (bestAsk_ < static_cast<int64_t>(levelCount_)) {
+        bestAsk_ -= delta;
+    } else {
+        bestAsk_ = static_cast<int64_t>(levelCount_);
+    }
+    return true;
+}
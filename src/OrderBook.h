@@ -0,0 +1,118 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "FixedPoint.h"
+
+enum class OrderSide : uint8_t
+{
+    BUY,
+    SELL,
+};
+
+enum class OrderType : uint8_t
+{
+    LIMIT,   // Match what crosses, rest the remainder
+    MARKET,  // Match at any price, cancel the remainder
+    IOC,     // Match up to the limit price, cancel the remainder
+};
+
+using OrderHandle = uint32_t;
+constexpr OrderHandle INVALID_ORDER_HANDLE = 0xFFFFFFFF;
+
+// One execution between an incoming (taker) order and a resting (maker) order
+struct BookFill
+{
+    uint64_t takerId;
+    uint64_t makerId;
+    PriceTicks price;
+    QtyLots quantity;
+    OrderSide takerSide;
+};
+
+struct BookResult
+{
+    QtyLots filled = 0;          // Executed immediately
+    QtyLots resting = 0;         // Left on the book (LIMIT only)
+    QtyLots cancelled = 0;       // Discarded remainder (MARKET/IOC, or no room to rest)
+    OrderHandle handle = INVALID_ORDER_HANDLE;  // Valid while the order rests
+};
+
+/**
+ * @class OrderBook
+ * @brief Single-symbol price-time priority limit order book for simulation.
+ *
+ * Price levels are a flat array covering [base, base + levelCount) ticks; each level
+ * is an intrusive FIFO list threaded through a preallocated node pool, so add,
+ * cancel (by handle) and fill are O(1) and never allocate after construction.
+ * Orders priced outside the window cannot rest; recenter() shifts the window.
+ */
+class OrderBook
+{
+public:
+    using FillHandler = std::function<void(const BookFill&)>;
+
+    OrderBook(size_t levelCount = 4096, size_t maxOrders = 65536);
+
+    void setFillHandler(FillHandler handler) { fillHandler_ = std::move(handler); }
+
+    // Matches against the opposite side, then rests (LIMIT) or cancels the remainder
+    BookResult submit(uint64_t orderId, OrderSide side, OrderType type, PriceTicks price, QtyLots quantity);
+
+    // Removes a resting order; orderId guards against a recycled handle
+    bool cancel(OrderHandle handle, uint64_t orderId);
+
+    // Moves the price window so 'mid' sits in the middle; fails if a resting order would fall outside
+    bool recenter(PriceTicks mid);
+
+    void clear();
+
+    bool hasBid() const { return bestBid_ >= 0; }
+    bool hasAsk() const { return bestAsk_ < static_cast<int64_t>(levelCount_); }
+    PriceTicks bestBid() const { return base_ + bestBid_; }
+    PriceTicks bestAsk() const { return base_ + bestAsk_; }
+    QtyLots depthAt(OrderSide side, PriceTicks price) const;
+    size_t restingOrders() const { return nodes_.size() - freeList_.size(); }
+    bool inWindow(PriceTicks price) const { return price >= base_ && price < base_ + static_cast<PriceTicks>(levelCount_); }
+
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFF;
+
+    struct Node
+    {
+        uint64_t id;
+        QtyLots remaining;
+        PriceTicks price;   // Absolute, so recenter() does not have to touch nodes
+        uint32_t prev;
+        uint32_t next;
+        OrderSide side;
+        bool active;
+    };
+
+    struct Level
+    {
+        uint32_t head = NIL;
+        uint32_t tail = NIL;
+        QtyLots total = 0;
+    };
+
+    QtyLots match(uint64_t takerId, OrderSide side, OrderType type, PriceTicks price, QtyLots quantity);
+    OrderHandle rest(uint64_t orderId, OrderSide side, PriceTicks price, QtyLots quantity);
+    void unlink(uint32_t nodeIndex);
+    bool canShift(const std::vector<Level>& levels, int64_t delta) const;
+    void shiftLevels(std::vector<Level>& levels, int64_t delta);
+
+    size_t levelCount_;
+    PriceTicks base_ = 0;
+    std::vector<Level> bids_;
+    std::vector<Level> asks_;
+    int64_t bestBid_;   // Index of the best bid level, -1 when empty
+    int64_t bestAsk_;   // Index of the best ask level, levelCount_ when empty
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> freeList_;
+    FillHandler fillHandler_;
+};
+
+#endif // ORDER_BOOK_H
@@ -0,0 +1,125 @@
+#include "OrderManager.h"
+
+namespace {
+
+constexpr uint16_t bit(OrderState state) { return static_cast<uint16_t>(1u << static_cast<unsigned>(state)); }
+
+// Allowed next states, indexed by current state
+constexpr uint16_t ALLOWED_TRANSITIONS[] = {
+    /* NEW              */ bit(OrderState::PENDING_NEW) | bit(OrderState::REJECTED),
+    /* PENDING_NEW      */ bit(OrderState::ACKNOWLEDGED) | bit(OrderState::PARTIALLY_FILLED) |
+                           bit(OrderState::FILLED) | bit(OrderState::CANCELLED) | bit(OrderState::REJECTED),
+    /* ACKNOWLEDGED     */ bit(OrderState::PARTIALLY_FILLED) | bit(OrderState::FILLED) |
+                           bit(OrderState::PENDING_CANCEL) | bit(OrderState::CANCELLED),
+    /* PARTIALLY_FILLED */ bit(OrderState::PARTIALLY_FILLED) | bit(OrderState::FILLED) |
+                           bit(OrderState::PENDING_CANCEL) | bit(OrderState::CANCELLED),
+    /* PENDING_CANCEL   */ bit(OrderState::PARTIALLY_FILLED) | bit(OrderState::FILLED) | bit(OrderState::CANCELLED),
+    /* FILLED           */ 0,
+    /* CANCELLED        */ 0,
+    /* REJECTED         */ 0,
+};
+
+} // namespace
+
+OrderManager::OrderManager(size_t preallocated, size_t maxOrders)
+    : pool_(preallocated, maxOrders)
+{
+}
+
+Order* OrderManager::create(SymbolId symbol, OrderSide side, OrderType type, PriceTicks price,
+                            QtyLots quantity, long long nowMs)
+{
+    const uint32_t slot = pool_.acquire();
+    if (slot == SlabPool<Order>::INVALID_INDEX) {
+        return nullptr;
+    }
+
+    Order& order = pool_[slot];
+    const uint32_t generation = order.generation + 1;  // Survives recycling of the slot
+    order = Order();
+    order.generation = generation;
+    order.id = (static_cast<OrderId>(generation) << 32) | slot;
+    order.symbol = symbol;
+    order.side = side;
+    order.type = type;
+    order.price = price;
+    order.quantity = quantity;
+    order.createdMs = nowMs;
+    return &order;
+}
+
+Order* OrderManager::find(OrderId id)
+{
+    const uint32_t slot = slotOf(id);
+    if (id == INVALID_ORDER_ID || slot >= pool_.capacity()) {
+        return nullptr;
+    }
+    Order& order = pool_[slot];
+    return order.id == id ? &order : nullptr;
+}
+
+bool OrderManager::transition(Order& order, OrderState next)
+{
+    if ((ALLOWED_TRANSITIONS[static_cast<size_t>(order.state)] & bit(next)) == 0) {
+        ++rejectedTransitions_;
+        return false;
+    }
+    order.state = next;
+    return true;
+}
+
+bool OrderManager::applyFill(OrderId id, PriceTicks price, QtyLots quantity, const InstrumentScale& scale)
+{
+    Order* order = find(id);
+    if (order == nullptr || quantity <= 0 || quantity > order->remaining()) {
+        return false;
+    }
+    const OrderState next = (quantity == order->remaining()) ? OrderState::FILLED : OrderState::PARTIALLY_FILLED;
+    if (!transition(*order, next)) {
+        return false;
+    }
+    order->filled += quantity;
+    order->filledNotional += scale.notional(price, quantity);
+    if (fillHandler_) {
+        fillHandler_(*order, price, quantity);
+    }
+    return true;
+}
+
+void OrderManager::applySubmitResult(Order& order, const BookResult& result)
+{
+    if (isTerminal(order.state)) {
+        return;  // Fully filled while matching
+    }
+    if (result.resting > 0) {
+        order.venueHandle = result.handle;
+        if (order.state == OrderState::PENDING_NEW) {
+            transition(order, OrderState::ACKNOWLEDGED);
+        }
+    } else if (result.cancelled > 0) {
+        transition(order, OrderState::CANCELLED);
+    }
+}
+
+bool OrderManager::cancel(OrderId id)
+{
+    Order* order = find(id);
+    if (order == nullptr || order->venueHandle == INVALID_ORDER_HANDLE || !cancelHandler_ ||
+        !transition(*order, OrderState::PENDING_CANCEL)) {
+        return false;
+    }
+    if (!cancelHandler_(*order)) {
+        return false;
+    }
+    order->venueHandle = INVALID_ORDER_HANDLE;
+    return transition(*order, OrderState::CANCELLED);
+}
+
+void OrderManager::releaseIfDone(Order& order)
+{
+    if (isTerminal(order.state)) {
+        const uint32_t slot = slotOf(order.id);
+        order.id = INVALID_ORDER_ID;   // Stale ids no longer resolve
+        pool_.release(slot);
+    }
+}
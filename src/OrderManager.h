@@ -0,0 +1,123 @@
+#ifndef ORDER_MANAGER_H
+#define ORDER_MANAGER_H
+
+#include <cstdint>
+#include <functional>
+#include "OrderBook.h"
+#include "SlabPool.h"
+#include "SymbolTable.h"
+
+enum class OrderState : uint8_t
+{
+    NEW,               // Created, not yet sent
+    PENDING_NEW,       // Sent to the venue, no response yet
+    ACKNOWLEDGED,      // Resting on the venue
+    PARTIALLY_FILLED,
+    PENDING_CANCEL,
+    FILLED,            // Terminal
+    CANCELLED,         // Terminal (may carry a partial fill)
+    REJECTED,          // Terminal
+};
+
+inline const char* orderStateToString(OrderState state)
+{
+    switch (state) {
+        case OrderState::NEW:              return "New";
+        case OrderState::PENDING_NEW:      return "PendingNew";
+        case OrderState::ACKNOWLEDGED:     return "Acknowledged";
+        case OrderState::PARTIALLY_FILLED: return "PartiallyFilled";
+        case OrderState::PENDING_CANCEL:   return "PendingCancel";
+        case OrderState::FILLED:           return "Filled";
+        case OrderState::CANCELLED:        return "Cancelled";
+        case OrderState::REJECTED:         return "Rejected";
+        default:                           return "Unknown";
+    }
+}
+
+inline bool isTerminal(OrderState state)
+{
+    return state == OrderState::FILLED || state == OrderState::CANCELLED || state == OrderState::REJECTED;
+}
+
+// Order id = (generation << 32) | pool slot, so the slot is a dense index and a
+// recycled slot never answers to an old id
+using OrderId = uint64_t;
+constexpr OrderId INVALID_ORDER_ID = 0;
+
+struct Order
+{
+    OrderId id = INVALID_ORDER_ID;
+    PriceTicks price = 0;
+    QtyLots quantity = 0;
+    QtyLots filled = 0;
+    CashUnits filledNotional = 0;
+    long long createdMs = 0;
+    OrderHandle venueHandle = INVALID_ORDER_HANDLE;
+    uint32_t generation = 0;
+    SymbolId symbol = INVALID_SYMBOL_ID;
+    OrderSide side = OrderSide::BUY;
+    OrderType type = OrderType::LIMIT;
+    OrderState state = OrderState::NEW;
+
+    QtyLots remaining() const { return quantity - filled; }
+};
+
+/**
+ * @class OrderManager
+ * @brief Owns every live order: pooled storage, dense ids and the lifecycle state machine.
+ *
+ * Orders live in a SlabPool sized for bursts of in-flight orders, so the steady state
+ * never allocates. Every state change goes through transition(), which rejects moves the
+ * lifecycle does not allow. Fills are forwarded to the fill handler (the portfolio)
+ * before a filled order is recycled; cancels go to the venue through the cancel handler. Single-threaded: used from the executor thread only.
+ */
+class OrderManager
+{
+public:
+    // Called for each execution: the order (already updated), fill price and quantity
+    using FillHandler = std::function<void(const Order&, PriceTicks, QtyLots)>;
+    // Pulls a resting order off the venue; false if it is no longer there
+    using CancelHandler = std::function<bool(const Order&)>;
+
+    OrderManager(size_t preallocated, size_t maxOrders);
+
+    void setFillHandler(FillHandler handler) { fillHandler_ = std::move(handler); }
+    void setCancelHandler(CancelHandler handler) { cancelHandler_ = std::move(handler); }
+
+    // Allocates an order in state NEW; nullptr when the pool is exhausted
+    Order* create(SymbolId symbol, OrderSide side, OrderType type, PriceTicks price, QtyLots quantity, long long nowMs);
+
+    Order* find(OrderId id);
+
+    // Validated state change; returns false (and leaves the order untouched) if not allowed
+    bool transition(Order& order, OrderState next);
+
+    // Applies an execution report to the order identified by 'id'
+    bool applyFill(OrderId id, PriceTicks price, QtyLots quantity, const InstrumentScale& scale);
+
+    // Final venue response to a submit: acknowledges the resting part or cancels the remainder
+    void applySubmitResult(Order& order, const BookResult& result);
+
+    // Cancels the resting part of an acknowledged order: PENDING_CANCEL, then CANCELLED once
+    // the venue confirms. If the venue no longer has it, the order stays PENDING_CANCEL
+    // until the execution report that beat the cancel arrives. Returns true if cancelled
+    bool cancel(OrderId id);
+
+    // Returns terminal orders to the pool; call once the caller is done with the order
+    void releaseIfDone(Order& order);
+
+    size_t liveOrders() const { return pool_.inUse(); }
+    size_t poolCapacity() const { return pool_.capacity(); }
+    size_t poolGrowth() const { return pool_.growthCount(); }
+    uint64_t rejectedTransitions() const { return rejectedTransitions_; }
+
+private:
+    static uint32_t slotOf(OrderId id) { return static_cast<uint32_t>(id & 0xFFFFFFFF); }
+
+    SlabPool<Order> pool_;
+    FillHandler fillHandler_;
+    CancelHandler cancelHandler_;
+    uint64_t rejectedTransitions_ = 0;
+};
+
+#endif // ORDER_MANAGER_H
@@ -0,0 +1,290 @@
+#include "Portfolio.h"
+#include <cstring>
+
+namespace {
+
+// Splits "BTC-EUR" into base "BTC" and quote "EUR"; false for plain names
+bool SplitPair(const char* name, size_t& baseLength, const char*& quote, size_t& quoteLength)
+{
+    const char* separator = std::strpbrk(name, "-/_");
+    if (separator == nullptr) {
+        return false;
+    }
+    baseLength = static_cast<size_t>(separator - name);
+    quote = separator + 1;
+    quoteLength = std::strlen(quote);
+    return quoteLength > 0 && quoteLength <= MAX_CURRENCY_LENGTH;
+}
+
+CashUnits ToBase(CashUnits value, int64_t fxToBase)
+{
+    return static_cast<CashUnits>(static_cast<WideInt>(value) * fxToBase / FX_SCALE);
+}
+
+CashUnits Abs(CashUnits value) { return value < 0 ? -value : value; }
+
+} // namespace
+
+void Portfolio::reset(const char* baseCurrency, CashUnits initialCash)
+{
+    PortfolioState& state = state_.beginWrite();
+    state = PortfolioState();
+    std::strncpy(state.currencyNames[BASE_CURRENCY_ID], baseCurrency, MAX_CURRENCY_LENGTH);
+    state.currencyCount = 1;
+    state.fxToBase[BASE_CURRENCY_ID] = FX_SCALE;
+    state.cash[BASE_CURRENCY_ID] = initialCash;
+    state.initialValue = initialCash;
+    state.pnl.equity = initialCash;
+    state.pnl.highWaterMark = initialCash;
+    state_.endWrite();
+}
+
+void Portfolio::restore(const PortfolioState& restored)
+{
+    PortfolioState& state = state_.beginWrite();
+    state = restored;
+    state_.endWrite();
+}
+
+CurrencyId Portfolio::findCurrency(const PortfolioState& state, const char* name, size_t length) const
+{
+    if (length == 0 || length > MAX_CURRENCY_LENGTH) {
+        return NO_CURRENCY;
+    }
+    for (CurrencyId id = 0; id < state.currencyCount; ++id) {
+        if (std::strncmp(state.currencyNames[id], name, length) == 0 && state.currencyNames[id][length] == '\0') {
+            return id;
+        }
+    }
+    return NO_CURRENCY;
+}
+
+CurrencyId Portfolio::resolveCurrency(PortfolioState& state, SymbolId symbol)
+{
+    PortfolioPosition& position = state.positions[symbol];
+    if (position.active) {
+        return position.currency;
+    }
+    position.active = true;
+    position.currency = BASE_CURRENCY_ID;
+
+    size_t baseLength = 0;
+    const char* quote = nullptr;
+    size_t quoteLength = 0;
+    if (!SplitPair(SymbolTable::instance().name(symbol), baseLength, quote, quoteLength)) {
+        return position.currency;
+    }
+
+    CurrencyId currency = findCurrency(state, quote, quoteLength);
+    if (currency == NO_CURRENCY) {
+        if (state.currencyCount >= MAX_CURRENCIES) {
+            return position.currency;   // Table full: booked in the base currency
+        }
+        currency = state.currencyCount++;
+        std::memcpy(state.currencyNames[currency], quote, quoteLength);
+        position.currency = currency;
+        linkFxPairs(state);   // An existing "<new>-<base>" symbol now prices it
+        return currency;
+    }
+    position.currency = currency;
+    if (currency == BASE_CURRENCY_ID) {
+        linkFxPairs(state);   // This symbol may be a "<currency>-<base>" pair
+    }
+    return currency;
+}
+
+void Portfolio::linkFxPairs(PortfolioState& state)
+{
+    for (size_t i = 0; i < MAX_SYMBOLS; ++i) {
+        PortfolioPosition& position = state.positions[i];
+        if (!position.active || position.fxFor != NO_CURRENCY || position.currency != BASE_CURRENCY_ID) {
+            continue;
+        }
+        const SymbolId symbol = static_cast<SymbolId>(i);
+        const char* name = SymbolTable::instance().name(symbol);
+        size_t baseLength = 0;
+        const char* quote = nullptr;
+        size_t quoteLength = 0;
+        if (!SplitPair(name, baseLength, quote, quoteLength)) {
+            continue;
+        }
+        const CurrencyId currency = findCurrency(state, name, baseLength);
+        if (currency == NO_CURRENCY || currency == BASE_CURRENCY_ID) {
+            continue;
+        }
+        position.fxFor = currency;
+        if (position.mark > 0) {
+            const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+            applyFxRate(state, currency, static_cast<int64_t>(static_cast<WideInt>(position.mark) * FX_SCALE / scale.priceScale));
+        }
+    }
+}
+
+void Portfolio::revalue(PortfolioState& state, SymbolId symbol)
+{
+    PortfolioPosition& position = state.positions[symbol];
+    const int64_t fx = state.fxToBase[position.currency];
+    const CashUnits value = SymbolTable::instance().scale(symbol).notional(position.mark, position.quantity);
+    position.unrealizedPnl = value - position.costBasis;
+
+    const CashUnits realizedBase = ToBase(position.realizedPnl, fx);
+    state.pnl.realized += realizedBase - position.realizedBase;
+    position.realizedBase = realizedBase;
+    const CashUnits unrealizedBase = ToBase(position.unrealizedPnl, fx);
+    const CashUnits exposureBase = ToBase(value, fx);
+    state.pnl.unrealized += unrealizedBase - position.unrealizedBase;
+    state.pnl.netExposure += exposureBase - position.exposureBase;
+    state.pnl.grossExposure += Abs(exposureBase) - Abs(position.exposureBase);
+    position.unrealizedBase = unrealizedBase;
+    position.exposureBase = exposureBase;
+}
+
+void Portfolio::updateEquity(PortfolioState& state)
+{
+    PnlSummary& pnl = state.pnl;
+    pnl.equity = state.initialValue + pnl.realized + pnl.unrealized;
+    if (pnl.equity > pnl.highWaterMark) {
+        pnl.highWaterMark = pnl.equity;
+    }
+    pnl.drawdown = pnl.highWaterMark - pnl.equity;
+    if (pnl.drawdown > pnl.maxDrawdown) {
+        pnl.maxDrawdown = pnl.drawdown;
+    }
+}
+
+void Portfolio::applyFxRate(PortfolioState& state, CurrencyId currency, int64_t fxToBase)
+{
+    if (state.fxToBase[currency] == fxToBase) {
+        return;
+    }
+    state.fxToBase[currency] = fxToBase;
+    for (size_t i = 0; i < MAX_SYMBOLS; ++i) {
+        if (state.positions[i].active && state.positions[i].currency == currency) {
+            revalue(state, static_cast<SymbolId>(i));
+        }
+    }
+}
+
+CurrencyId Portfolio::activate(SymbolId symbol)
+{
+    const PortfolioPosition& current = state_.writerView().positions[symbol];
+    if (current.active) {
+        return current.currency;
+    }
+    PortfolioState& state = state_.beginWrite();
+    const CurrencyId currency = resolveCurrency(state, symbol);
+    state_.endWrite();
+    return currency;
+}
+
+void Portfolio::applyFill(SymbolId symbol, OrderSide side, PriceTicks price, QtyLots quantity)
+{
+    const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+    PortfolioState& state = state_.beginWrite();
+    const CurrencyId currency = resolveCurrency(state, symbol);
+    PortfolioPosition& position = state.positions[symbol];
+
+    QtyLots delta = (side == OrderSide::BUY) ? quantity : -quantity;
+    state.cash[currency] -= scale.notional(price, delta);
+    if (position.mark == 0) {
+        position.mark = price;
+    }
+
+    // Reducing: realize against the average cost of the closed part
+    if (position.quantity != 0 && (position.quantity > 0) != (delta > 0)) {
+        const QtyLots closed = (Abs(delta) < Abs(position.quantity)) ? delta : -position.quantity;
+        const CashUnits closedCost = static_cast<CashUnits>(
+            static_cast<WideInt>(position.costBasis) * -closed / position.quantity);
+        const CashUnits realized = -scale.notional(price, closed) - closedCost;
+        position.realizedPnl += realized;
+        position.costBasis -= closedCost;
+        position.quantity += closed;
+        delta -= closed;
+    }
+    // Opening or increasing (including the remainder of a flip)
+    if (delta != 0) {
+        position.costBasis += scale.notional(price, delta);
+        position.quantity += delta;
+    }
+
+    revalue(state, symbol);
+    updateEquity(state);
+    state_.endWrite();
+}
+
+void Portfolio::mark(SymbolId symbol, PriceTicks price)
+{
+    PortfolioState& state = state_.beginWrite();
+    resolveCurrency(state, symbol);
+    PortfolioPosition& position = state.positions[symbol];
+    position.mark = price;
+    ++state.pnl.markUpdates;
+    revalue(state, symbol);
+    if (position.fxFor != NO_CURRENCY) {
+        const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+        applyFxRate(state, position.fxFor, static_cast<int64_t>(static_cast<WideInt>(price) * FX_SCALE / scale.priceScale));
+    }
+    updateEquity(state);
+    state_.endWrite();
+}
+
+void Portfolio::setFxRate(CurrencyId currency, double rateToBase)
+{
+    if (currency == BASE_CURRENCY_ID || currency >= MAX_CURRENCIES) {
+        return;
+    }
+    PortfolioState& state = state_.beginWrite();
+    applyFxRate(state, currency, static_cast<int64_t>(rateToBase * FX_SCALE + 0.5));
+    updateEquity(state);
+    state_.endWrite();
+}
+
+void Portfolio::countTrade(OrderSide side)
+{
+    PortfolioState& state = state_.beginWrite();
+    ++state.totalTrades;
+    ++(side == OrderSide::BUY ? state.buyTrades : state.sellTrades);
+    state_.endWrite();
+}
+
+CashUnits Portfolio::cash(SymbolId symbol) const
+{
+    const PortfolioState& state = state_.writerView();
+    return state.cash[state.positions[symbol].currency];
+}
+
+const char* Portfolio::currencyName(SymbolId symbol) const
+{
+    const PortfolioState& state = state_.writerView();
+    return state.currencyNames[state.positions[symbol].currency];
+}
+
+CashUnits Portfolio::valueIn(const PortfolioState& state, CurrencyId currency)
+{
+    CashUnits value = state.cash[currency];
+    for (size_t i = 0; i < MAX_SYMBOLS; ++i) {
+        const PortfolioPosition& position = state.positions[i];
+        if (position.active && position.currency == currency && position.quantity != 0) {
+            value += SymbolTable::instance().scale(static_cast<SymbolId>(i)).notional(position.mark, position.quantity);
+        }
+    }
+    return value;
+}
+
+CashUnits Portfolio::valueInBase(const PortfolioState& state, uint32_t* unconverted)
+{
+    CashUnits total = 0;
+    uint32_t missing = 0;
+    for (CurrencyId id = 0; id < state.currencyCount; ++id) {
+        const CashUnits value = valueIn(state, id);
+        if (state.fxToBase[id] == 0) {
+            missing |= (value != 0) ? (1u << id) : 0u;
+            continue;
+        }
+        total += ToBase(value, state.fxToBase[id]);
+    }
+    if (unconverted != nullptr) {
+        *unconverted = missing;
+    }
+    return total;
+}
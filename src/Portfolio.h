@@ -0,0 +1,118 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <cstdint>
+#include "OrderBook.h"
+#include "SeqLock.h"
+#include "SymbolTable.h"
+
+using CurrencyId = uint8_t;
+
+constexpr size_t MAX_CURRENCIES = 8;
+constexpr size_t MAX_CURRENCY_LENGTH = 7;       // Excluding the terminating '\0'
+constexpr CurrencyId BASE_CURRENCY_ID = 0;
+constexpr int64_t FX_SCALE = 100000000;         // fxToBase units per 1.0
+
+constexpr CurrencyId NO_CURRENCY = 0xFF;
+
+struct PortfolioPosition
+{
+    QtyLots quantity = 0;
+    PriceTicks mark = 0;              // Last known price, in the quote currency
+    CashUnits costBasis = 0;          // Signed cost of the open quantity, quote currency
+    CashUnits realizedPnl = 0;        // Quote currency
+    CashUnits unrealizedPnl = 0;      // notional(mark, quantity) - costBasis, quote currency
+    CashUnits realizedBase = 0;       // Contributions to the totals, base currency
+    CashUnits unrealizedBase = 0;
+    CashUnits exposureBase = 0;       // Signed notional at the mark
+    CurrencyId currency = BASE_CURRENCY_ID;   // Quote currency
+    CurrencyId fxFor = NO_CURRENCY;   // Set when this symbol is the <currency>-<base> FX pair
+    bool active = false;              // Traded or marked at least once
+};
+
+// Portfolio-wide P&L in the base currency, maintained incrementally
+struct PnlSummary
+{
+    CashUnits realized;
+    CashUnits unrealized;
+    CashUnits equity;                 // initialValue + realized + unrealized
+    CashUnits highWaterMark;
+    CashUnits drawdown;               // highWaterMark - equity
+    CashUnits maxDrawdown;
+    CashUnits grossExposure;          // Sum of |notional| at the marks
+    CashUnits netExposure;
+    uint64_t markUpdates;
+};
+
+// Everything a reader sees; copied out whole under the seqlock
+struct PortfolioState
+{
+    CashUnits cash[MAX_CURRENCIES];
+    int64_t fxToBase[MAX_CURRENCIES];                          // 0 = no rate yet
+    char currencyNames[MAX_CURRENCIES][MAX_CURRENCY_LENGTH + 1];
+    uint8_t currencyCount;
+    PortfolioPosition positions[MAX_SYMBOLS];
+    PnlSummary pnl;
+    CashUnits initialValue;                                    // In the base currency
+    uint32_t totalTrades;
+    uint32_t buyTrades;
+    uint32_t sellTrades;
+};
+
+/**
+ * @class Portfolio
+ * @brief Cash per currency and positions per SymbolId, in flat arrays.
+ *
+ * The executor thread is the only writer. Readers (reporting, risk, dashboards) take
+ * snapshot() copies through a seqlock and never block execution. A symbol's quote
+ * currency is taken from its name ("BTC-EUR", "ETH/USDT"); plain names ("BTC") are
+ * quoted in the base currency. Marks of a "<currency>-<base>" pair set that currency's
+ * FX rate.
+ *
+ * P&L is incremental: a fill or a new mark changes one position, and the totals are
+ * adjusted by that position's delta, so each update is O(1). Only an FX rate change
+ * revalues the positions quoted in that currency. Realized P&L is kept per position in
+ * its quote currency (it is held as cash in that currency) and, like the unrealized P&L,
+ * converted at the current rate, so equity always equals valueInBase().
+ */
+class Portfolio
+{
+public:
+    // Startup only, before any thread reads or writes
+    void reset(const char* baseCurrency, CashUnits initialCash);
+    void restore(const PortfolioState& state);
+
+    // Writer (executor thread)
+    // Binds a symbol to its quote currency ahead of its first fill or mark, so cash() and
+    // currencyName() answer for that currency. Only the base currency is funded: cash in
+    // any other starts at zero and comes from selling
+    CurrencyId activate(SymbolId symbol);
+    void applyFill(SymbolId symbol, OrderSide side, PriceTicks price, QtyLots quantity);
+    void mark(SymbolId symbol, PriceTicks price);
+    void setFxRate(CurrencyId currency, double rateToBase);
+    void countTrade(OrderSide side);
+
+    CashUnits cash(SymbolId symbol) const;   // In the quote currency of an active symbol
+    QtyLots quantity(SymbolId symbol) const { return state_.writerView().positions[symbol].quantity; }
+    const char* currencyName(SymbolId symbol) const;
+    const PortfolioState& writerView() const { return state_.writerView(); }
+
+    // Any thread
+    PortfolioState snapshot() const { return state_.read(); }
+
+    // Valuation of a snapshot; currencies without an FX rate are skipped and flagged in 'unconverted'
+    static CashUnits valueIn(const PortfolioState& state, CurrencyId currency);
+    static CashUnits valueInBase(const PortfolioState& state, uint32_t* unconverted = nullptr);
+
+private:
+    CurrencyId resolveCurrency(PortfolioState& state, SymbolId symbol);
+    CurrencyId findCurrency(const PortfolioState& state, const char* name, size_t length) const;
+    void linkFxPairs(PortfolioState& state);
+    void applyFxRate(PortfolioState& state, CurrencyId currency, int64_t fxToBase);
+    void revalue(PortfolioState& state, SymbolId symbol);
+    void updateEquity(PortfolioState& state);
+
+    SeqLock<PortfolioState> state_;
+};
+
+#endif // PORTFOLIO_H
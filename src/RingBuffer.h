@@ -0,0 +1,76 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class RingBuffer
+ * @brief Fixed-capacity sliding window with deque-like read access.
+ *
+ * Storage is allocated once (constructor or reset()); push_back() on a full
+ * buffer overwrites the oldest element, so steady-state use never touches
+ * the heap. Index 0 is the oldest element and back() is the latest one.
+ */
+template <typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(size_t capacity = 0)
+        : buffer_(capacity), head_(0), size_(0) {}
+
+    // Reallocates storage and drops all elements (startup / reconfiguration only)
+    void reset(size_t capacity)
+    {
+        buffer_.assign(capacity, T());
+        head_ = 0;
+        size_ = 0;
+    }
+
+    void push_back(const T& value)
+    {
+        const size_t cap = buffer_.size();
+        if (cap == 0) {
+            return;
+        }
+        if (size_ < cap) {
+            buffer_[wrap(head_ + size_)] = value;
+            ++size_;
+        } else {
+            buffer_[head_] = value;
+            head_ = wrap(head_ + 1);
+        }
+    }
+
+    void pop_front()
+    {
+        if (size_ > 0) {
+            head_ = wrap(head_ + 1);
+            --size_;
+        }
+    }
+
+    void clear() { head_ = 0; size_ = 0; }
+
+    const T& operator[](size_t index) const { return buffer_[wrap(head_ + index)]; }
+    const T& front() const { return buffer_[head_]; }
+    const T& back() const { return buffer_[wrap(head_ + size_ - 1)]; }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return buffer_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == buffer_.size(); }
+
+private:
+    // head_ + index is always < 2 * capacity, so one conditional subtract is enough
+    size_t wrap(size_t index) const
+    {
+        return index >= buffer_.size() ? index - buffer_.size() : index;
+    }
+
+    std::vector<T> buffer_;
+    size_t head_;
+    size_t size_;
+};
+
+#endif // RING_BUFFER_H
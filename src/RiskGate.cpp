@@ -0,0 +1,190 @@
+#include "RiskGate.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include "../util/Logger.h"
+
+RiskGate::RiskGate()
+    : rejectionLog_(1024)
+{
+    for (size_t i = 0; i < MAX_SYMBOLS; ++i) {
+        maxPositionLots_[i].store(0, std::memory_order_relaxed);
+        lastPrice_[i].store(0, std::memory_order_relaxed);
+        position_[i].store(0, std::memory_order_relaxed);
+        working_[i].store(0, std::memory_order_relaxed);
+    }
+    for (auto& counter : rejected_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void RiskGate::configure(const RiskLimits& limits)
+{
+    setLimits(limits);
+    tokens_.store(bucketDepth_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    lastRefillNs_.store(0, std::memory_order_relaxed);
+}
+
+void RiskGate::setLimits(const RiskLimits& limits)
+{
+    // Until onTick() converts it again, check() converts the new limit itself
+    maxPosition_.store(limits.maxPosition, std::memory_order_relaxed);
+    positionLimitReady_.store(0, std::memory_order_release);
+    maxOrderNotional_.store(toCashUnits(limits.maxOrderNotional), std::memory_order_relaxed);
+    collarBps_.store(static_cast<int64_t>(limits.priceCollarBps), std::memory_order_relaxed);
+    int64_t refillPerNs = 0;
+    if (limits.ordersPerSecond > 0.0) {
+        // Rounded; a positive rate below the resolution still throttles, at the slowest rate
+        refillPerNs = std::max<int64_t>(1, std::llround(limits.ordersPerSecond * TOKENS_PER_NS_PER_ORDER_PER_SEC));
+    }
+    refillPerNs_.store(refillPerNs, std::memory_order_relaxed);
+    // The bucket itself is only written by check(), which caps it at the new depth
+    bucketDepth_.store(static_cast<int64_t>(std::max(limits.orderBurst, 1.0) * TOKEN), std::memory_order_relaxed);
+    maxDailyLoss_.store(toCashUnits(limits.maxDailyLoss), std::memory_order_relaxed);
+}
+
+RiskReason RiskGate::check(const ActionSignal& signal)
+{
+    if (signal.type_ == ActionType::HOLD) {
+        return RiskReason::NONE;
+    }
+
+    if (killed_.load(std::memory_order_acquire)) {
+        return reject(signal, RiskReason::KILL_SWITCH);
+    }
+
+    const PriceTicks last = lastPrice_[signal.symbol_].load(std::memory_order_relaxed);
+    const int64_t collarBps = collarBps_.load(std::memory_order_relaxed);
+    if (collarBps > 0 && last > 0) {
+        const PriceTicks distance = signal.price_ > last ? signal.price_ - last : last - signal.price_;
+        if (distance * 10000 > collarBps * last) {
+            return reject(signal, RiskReason::PRICE_COLLAR);
+        }
+    }
+
+    const CashUnits maxOrderNotional = maxOrderNotional_.load(std::memory_order_relaxed);
+    if (maxOrderNotional > 0 &&
+        SymbolTable::instance().scale(signal.symbol_).notional(signal.price_, signal.amount_) > maxOrderNotional) {
+        return reject(signal, RiskReason::ORDER_NOTIONAL);
+    }
+
+    const QtyLots signedAmount = (signal.type_ == ActionType::BUY) ? signal.amount_ : -signal.amount_;
+    if (maxPosition_.load(std::memory_order_relaxed) > 0.0) {
+        // Projected position includes orders accepted but not yet done
+        const QtyLots limit = positionLimit(signal.symbol_);
+        const QtyLots projected = position_[signal.symbol_].load(std::memory_order_relaxed) +
+                                  working_[signal.symbol_].load(std::memory_order_relaxed) + signedAmount;
+        if (projected > limit || projected < -limit) {
+            return reject(signal, RiskReason::POSITION_LIMIT);
+        }
+    }
+
+    // Last, so orders rejected for other reasons do not consume tokens. The bucket refills
+    // on signal time (IClock), so replays throttle exactly like the recorded session
+    const int64_t refillPerNs = refillPerNs_.load(std::memory_order_relaxed);
+    if (refillPerNs > 0 && !takeToken(signal.timestamp_ms_ * 1000000, refillPerNs)) {
+        return reject(signal, RiskReason::THROTTLE);
+    }
+
+    working_[signal.symbol_].fetch_add(signedAmount, std::memory_order_relaxed);
+    accepted_.fetch_add(1, std::memory_order_relaxed);
+    return RiskReason::NONE;
+}
+
+void RiskGate::convertPositionLimit(SymbolId symbol)
+{
+    // Converted on the symbol's first tick, in its own lot size (scales are set before trading)
+    static_assert(MAX_SYMBOLS <= 64, "One bit per SymbolId");
+    const QtyLots limit = SymbolTable::instance().scale(symbol).toLots(maxPosition_.load(std::memory_order_relaxed));
+    maxPositionLots_[symbol].store(limit, std::memory_order_relaxed);
+    positionLimitReady_.fetch_or(uint64_t(1) << symbol, std::memory_order_release);
+}
+
+QtyLots RiskGate::positionLimit(SymbolId symbol) const
+{
+    if (positionLimitReady_.load(std::memory_order_acquire) & (uint64_t(1) << symbol)) {
+        return maxPositionLots_[symbol].load(std::memory_order_relaxed);
+    }
+    return SymbolTable::instance().scale(symbol).toLots(maxPosition_.load(std::memory_order_relaxed));
+}
+
+bool RiskGate::takeToken(int64_t now, int64_t refillPerNs)
+{
+    const int64_t bucketDepth = bucketDepth_.load(std::memory_order_relaxed);
+    const int64_t elapsed = now - lastRefillNs_.load(std::memory_order_relaxed);
+    // A reload may have made the bucket shallower than what it holds
+    int64_t tokens = std::min(tokens_.load(std::memory_order_relaxed), bucketDepth);
+
+    // Cap elapsed before multiplying so a long idle period cannot overflow
+    if (elapsed >= (bucketDepth - tokens) / refillPerNs) {
+        tokens = bucketDepth;
+    } else if (elapsed > 0) {
+        tokens += elapsed * refillPerNs;
+    }
+    lastRefillNs_.store(now, std::memory_order_relaxed);
+
+    if (tokens < TOKEN) {
+        tokens_.store(tokens, std::memory_order_relaxed);
+        return false;
+    }
+    tokens_.store(tokens - TOKEN, std::memory_order_relaxed);
+    return true;
+}
+
+RiskReason RiskGate::reject(const ActionSignal& signal, RiskReason reason)
+{
+    rejected_[static_cast<size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    if (!rejectionLog_.tryPush(RiskRejection{signal.timestamp_ms_, signal.price_, signal.amount_,
+                                             signal.symbol_, signal.type_, reason})) {
+        droppedLogEntries_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return reason;
+}
+
+void RiskGate::onFill(SymbolId symbol, ActionType side, QtyLots quantity)
+{
+    position_[symbol].fetch_add(side == ActionType::BUY ? quantity : -quantity, std::memory_order_relaxed);
+}
+
+void RiskGate::onOrderDone(SymbolId symbol, ActionType side, QtyLots quantity)
+{
+    working_[symbol].fetch_sub(side == ActionType::BUY ? quantity : -quantity, std::memory_order_relaxed);
+}
+
+void RiskGate::updateEquity(CashUnits equity, long long nowMs)
+{
+    const long long day = nowMs / MS_PER_DAY;
+    if (day != day_.load(std::memory_order_relaxed)) {
+        day_.store(day, std::memory_order_relaxed);
+        dayStartEquity_.store(equity, std::memory_order_relaxed);
+        if (killed_.exchange(false, std::memory_order_acq_rel)) {
+            LOG(WARN) << "Risk: new trading day, kill switch reset";
+        }
+        return;
+    }
+
+    const CashUnits loss = dayStartEquity_.load(std::memory_order_relaxed) - equity;
+    const CashUnits maxDailyLoss = maxDailyLoss_.load(std::memory_order_relaxed);
+    if (maxDailyLoss > 0 && loss >= maxDailyLoss && !killed_.exchange(true, std::memory_order_acq_rel)) {
+        LOG(WARN) << "Risk: KILL SWITCH engaged, daily loss $" << std::fixed << std::setprecision(2)
+                  << fromCashUnits(loss) << " >= limit $" << fromCashUnits(maxDailyLoss);
+    }
+}
+
+void RiskGate::logRejections()
+{
+    RiskRejection rejection;
+    while (rejectionLog_.tryPop(rejection)) {
+        const InstrumentScale& scale = SymbolTable::instance().scale(rejection.symbol_);
+        LOG(WARN) << "Risk rejected " << (rejection.type_ == ActionType::BUY ? "BUY" : "SELL")
+                  << " " << SymbolTable::instance().name(rejection.symbol_)
+                  << " " << scale.fromLots(rejection.amount_)
+                  << " at $" << std::fixed << std::setprecision(2) << scale.fromTicks(rejection.price_)
+                  << ": " << riskReasonToString(rejection.reason_);
+    }
+    const uint64_t dropped = droppedLogEntries_.load(std::memory_order_relaxed);
+    if (dropped > loggedDrops_) {
+        LOG(WARN) << "Risk: " << (dropped - loggedDrops_) << " rejection log entries dropped";
+        loggedDrops_ = dropped;
+    }
+}
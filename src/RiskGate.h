@@ -0,0 +1,140 @@
+#ifndef RISK_GATE_H
+#define RISK_GATE_H
+
+#include <atomic>
+#include <cstdint>
+#include "Types.h"
+#include "SpscRing.h"
+
+enum class RiskReason : uint8_t
+{
+    NONE,
+    KILL_SWITCH,      // Daily loss limit breached
+    PRICE_COLLAR,     // Signal price too far from the last tick
+    ORDER_NOTIONAL,   // Single order too large
+    POSITION_LIMIT,   // Order would push the position past the limit
+    THROTTLE,         // Order rate above the token bucket
+    COUNT,
+};
+
+inline const char* riskReasonToString(RiskReason reason)
+{
+    switch (reason) {
+        case RiskReason::NONE:           return "None";
+        case RiskReason::KILL_SWITCH:    return "KillSwitch";
+        case RiskReason::PRICE_COLLAR:   return "PriceCollar";
+        case RiskReason::ORDER_NOTIONAL: return "OrderNotional";
+        case RiskReason::POSITION_LIMIT: return "PositionLimit";
+        case RiskReason::THROTTLE:       return "Throttle";
+        default:                         return "Unknown";
+    }
+}
+
+// Limits in config units; 0 disables the corresponding check
+struct RiskLimits
+{
+    double maxPosition = 0.0;        // Absolute position per symbol, base units
+    double maxOrderNotional = 0.0;   // Per order, quote currency
+    double ordersPerSecond = 0.0;    // Token bucket refill rate, orders per second (fractions allowed)
+    double orderBurst = 0.0;         // Token bucket depth
+    double priceCollarBps = 0.0;     // Max distance of the signal price from the last tick
+    double maxDailyLoss = 0.0;       // Equity drawdown from the start of the UTC day
+};
+
+// Queued for the asynchronous rejection log
+struct RiskRejection
+{
+    long long timestamp_ms_;
+    PriceTicks price_;
+    QtyLots amount_;
+    SymbolId symbol_;
+    ActionType type_;
+    RiskReason reason_;
+};
+
+/**
+ * @class RiskGate
+ * @brief Pre-trade checks between StrategyEngine and TradeExecutor.
+ *
+ * Limits are converted to fixed point once in configure() (and again in setLimits() on a
+ * config reload), so check() is a handful of integer compares on atomics. setLimits() and
+ * onTick() run on the ingest thread, check() on whichever thread evaluates the strategy;
+ * fills, completed orders and equity are reported by the executor thread. Rejections are
+ * counted and queued; logRejections() writes them out away from the tick path.
+ */
+class RiskGate
+{
+public:
+    RiskGate();
+
+    void configure(const RiskLimits& limits);
+    // New limits for a running gate: the order bucket keeps its tokens, up to the new burst.
+    // On the thread that calls onTick()
+    void setLimits(const RiskLimits& limits);
+
+    // Ingest thread
+    void onTick(SymbolId symbol, PriceTicks price)
+    {
+        lastPrice_[symbol].store(price, std::memory_order_relaxed);
+        if ((positionLimitReady_.load(std::memory_order_relaxed) & (uint64_t(1) << symbol)) == 0) {
+            convertPositionLimit(symbol);
+        }
+    }
+
+    // Strategy thread
+    RiskReason check(const ActionSignal& signal);
+
+    // Executor thread
+    void onFill(SymbolId symbol, ActionType side, QtyLots quantity);
+    void onOrderDone(SymbolId symbol, ActionType side, QtyLots quantity);
+    void updateEquity(CashUnits equity, long long nowMs);
+
+    // Any thread; drains the rejection queue into the log (single consumer)
+    void logRejections();
+
+    bool killed() const { return killed_.load(std::memory_order_acquire); }
+    uint64_t accepted() const { return accepted_.load(std::memory_order_relaxed); }
+    uint64_t rejected(RiskReason reason) const { return rejected_[static_cast<size_t>(reason)].load(std::memory_order_relaxed); }
+    QtyLots position(SymbolId symbol) const { return position_[symbol].load(std::memory_order_relaxed); }
+
+private:
+    // One order in token units; a refill of 1000 units per nanosecond is one order per second,
+    // so rates resolve to 0.001 orders per second
+    static constexpr int64_t TOKEN = 1000000000000LL;
+    static constexpr double TOKENS_PER_NS_PER_ORDER_PER_SEC = TOKEN / 1e9;
+    static constexpr long long MS_PER_DAY = 86400000;
+
+    RiskReason reject(const ActionSignal& signal, RiskReason reason);
+    bool takeToken(int64_t nowNs, int64_t refillPerNs);
+    void convertPositionLimit(SymbolId symbol);
+    QtyLots positionLimit(SymbolId symbol) const;
+
+    // Precomputed limits (fixed point); written by setLimits() and onTick(), read by check()
+    std::atomic<double> maxPosition_{0.0};              // Base units; each symbol converts it with its own lot size
+    std::atomic<QtyLots> maxPositionLots_[MAX_SYMBOLS]; // Valid where positionLimitReady_ has the symbol's bit
+    std::atomic<uint64_t> positionLimitReady_{0};
+    std::atomic<CashUnits> maxOrderNotional_{0};
+    std::atomic<int64_t> collarBps_{0};
+    std::atomic<int64_t> refillPerNs_{0};       // Token units per nanosecond
+    std::atomic<int64_t> bucketDepth_{0};       // Burst in token units
+    std::atomic<CashUnits> maxDailyLoss_{0};    // Read by the executor thread
+
+    std::atomic<PriceTicks> lastPrice_[MAX_SYMBOLS];
+    std::atomic<QtyLots> position_[MAX_SYMBOLS];   // Filled
+    std::atomic<QtyLots> working_[MAX_SYMBOLS];    // Accepted, not yet done (signed)
+
+    std::atomic<int64_t> tokens_{0};
+    std::atomic<int64_t> lastRefillNs_{0};
+
+    std::atomic<bool> killed_{false};
+    std::atomic<long long> day_{-1};
+    std::atomic<CashUnits> dayStartEquity_{0};
+
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> rejected_[static_cast<size_t>(RiskReason::COUNT)];
+    SpscRing<RiskRejection> rejectionLog_;
+    std::atomic<uint64_t> droppedLogEntries_{0};
+    uint64_t loggedDrops_ = 0;   // Consumer side
+};
+
+#endif // RISK_GATE_H
@@ -0,0 +1,217 @@
+#include "RuntimeConfig.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include "pch.h"
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+// Keys parsed into RuntimeConfig; a change to any other key needs a restart
+const char* const RELOADABLE_KEYS[] = {
+    "MIN_HISTORY", "TRADE_AMOUNT", "FEED_TICK_DELAY_MS", "EXECUTOR_DELAY_MS", "PNL_REPORT_INTERVAL_SEC",
+    "RISK_MAX_POSITION", "RISK_MAX_ORDER_NOTIONAL", "RISK_ORDERS_PER_SEC", "RISK_ORDER_BURST",
+    "RISK_PRICE_COLLAR_BPS", "RISK_MAX_DAILY_LOSS",
+};
+
+bool reloadable(const std::string& key)
+{
+    for (const char* name : RELOADABLE_KEYS) {
+        if (key == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string directoryOf(const std::string& path)
+{
+    const size_t slash = path.find_last_of('/');
+    if (slash == std::string::npos) {
+        return ".";
+    }
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+std::string fileNameOf(const std::string& path)
+{
+    const size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+RuntimeConfig RuntimeConfig::parse(const ConfigManager& config)
+{
+    RuntimeConfig out;
+    out.maxHistory = static_cast<uint32_t>(config.get("MAX_HISTORY", 70));
+    out.minHistory = static_cast<uint32_t>(config.get("MIN_HISTORY", 10));
+    out.tradeAmount = config.get("TRADE_AMOUNT", 0.01);
+    out.feedTickDelayMs = static_cast<uint32_t>(config.get("FEED_TICK_DELAY_MS", 50));
+    out.executorDelayMs = static_cast<uint32_t>(config.get("EXECUTOR_DELAY_MS", 50));
+    out.pnlReportIntervalSec = static_cast<uint32_t>(config.get("PNL_REPORT_INTERVAL_SEC", 10));
+
+    out.risk.maxPosition = config.get("RISK_MAX_POSITION", 0.0);
+    out.risk.maxOrderNotional = config.get("RISK_MAX_ORDER_NOTIONAL", 0.0);
+    out.risk.ordersPerSecond = config.get("RISK_ORDERS_PER_SEC", 0.0);
+    out.risk.orderBurst = config.get("RISK_ORDER_BURST", 1.0);
+    out.risk.priceCollarBps = config.get("RISK_PRICE_COLLAR_BPS", 0.0);
+    out.risk.maxDailyLoss = config.get("RISK_MAX_DAILY_LOSS", 0.0);
+    return out;
+}
+
+bool ConfigWatcher::start(const std::vector<std::string>& paths, const ConfigManager& loaded, RuntimeConfigStore& store)
+{
+    stop();
+    paths_ = paths;
+    applied_ = loaded;
+    store_ = &store;
+#ifdef __linux__
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        LOG(ERROR) << "Config: inotify unavailable (" << std::strerror(errno) << "), reload disabled";
+        return false;
+    }
+    directories_.clear();
+    for (const std::string& path : paths_) {
+        const std::string directory = directoryOf(path);
+        bool watched = false;
+        for (const std::string& existing : directories_) {
+            watched = watched || existing == directory;
+        }
+        if (watched) {
+            continue;
+        }
+        // Whole-file writes and files renamed into place; the files themselves may be replaced
+        if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            LOG(ERROR) << "Config: cannot watch " << directory << " (" << std::strerror(errno) << ")";
+            ::close(fd);
+            return false;
+        }
+        directories_.push_back(directory);
+    }
+    inotifyFd_ = fd;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&ConfigWatcher::run, this);
+    LOG(Main) << "Config: watching " << paths_.size() << " file(s) for changes";
+    return true;
+#else
+    LOG(WARN) << "Config: file watching needs inotify (Linux), reload disabled";
+    return false;
+#endif
+}
+
+void ConfigWatcher::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+#ifdef __linux__
+    if (inotifyFd_ != -1) {
+        ::close(static_cast<int>(inotifyFd_));
+        inotifyFd_ = -1;
+    }
+#endif
+}
+
+void ConfigWatcher::run()
+{
+#ifdef __linux__
+    using Clock = std::chrono::steady_clock;
+    // Editors and deploy scripts often write in several steps: reload once they are done
+    constexpr auto SETTLE = std::chrono::milliseconds(200);
+    bool pending = false;
+    Clock::time_point due;
+    alignas(inotify_event) char events[4096];
+
+    while (running_.load(std::memory_order_acquire)) {
+        pollfd entry{static_cast<int>(inotifyFd_), POLLIN, 0};
+        const int waitMs = pending ? 50 : 500;   // Checks for shutdown at least twice a second
+        if (poll(&entry, 1, waitMs) > 0) {
+            ssize_t length;
+            while ((length = read(entry.fd, events, sizeof(events))) > 0) {
+                for (char* at = events; at < events + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+                    at += sizeof(inotify_event) + event->len;
+                    if (event->len == 0) {
+                        continue;
+                    }
+                    for (const std::string& path : paths_) {
+                        if (fileNameOf(path) == event->name) {
+                            pending = true;
+                            due = Clock::now() + SETTLE;
+                        }
+                    }
+                }
+            }
+        }
+        if (pending && Clock::now() >= due) {
+            pending = false;
+            reload();
+        }
+    }
+#endif
+}
+
+bool ConfigWatcher::reload()
+{
+    ConfigManager next;
+    for (const std::string& path : paths_) {
+        if (!next.load(path)) {
+            LOG(ERROR) << "Config: cannot read " << path << ", keeping version " << store_->current().version;
+            return false;
+        }
+    }
+
+    RuntimeConfig config;
+    try {
+        config = RuntimeConfig::parse(next);
+    } catch (const std::exception&) {
+        LOG(ERROR) << "Config: invalid number in the reloaded files, keeping version " << store_->current().version;
+        return false;
+    }
+    // The price windows keep their startup capacity
+    config.maxHistory = store_->current().maxHistory;
+
+    // Report what changed: reloadable keys take effect now, the rest at the next start
+    bool changed = false;
+    const auto& before = applied_.values();
+    const auto& after = next.values();
+    auto report = [&](const std::string& key, const std::string& from, const std::string& to) {
+        if (reloadable(key)) {
+            changed = true;
+            LOG(Main) << "Config: " << key << " " << from << " -> " << to;
+        } else {
+            LOG(WARN) << "Config: " << key << " " << from << " -> " << to << " needs a restart";
+        }
+    };
+    for (const auto& entry : after) {
+        const auto previous = before.find(entry.first);
+        if (previous == before.end()) {
+            report(entry.first, "(unset)", entry.second);
+        } else if (previous->second != entry.second) {
+            report(entry.first, previous->second, entry.second);
+        }
+    }
+    for (const auto& entry : before) {
+        if (after.find(entry.first) == after.end()) {
+            report(entry.first, entry.second, "(unset)");
+        }
+    }
+    applied_ = next;
+    if (!changed) {
+        return true;
+    }
+
+    const RuntimeConfig& published = store_->publish(config);
+    reloads_.fetch_add(1, std::memory_order_relaxed);
+    LOG(Main) << "Config: published version " << published.version;
+    return true;
+}
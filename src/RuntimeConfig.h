@@ -0,0 +1,111 @@
+#ifndef RUNTIME_CONFIG_H
+#define RUNTIME_CONFIG_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConfigManager.h"
+#include "RiskGate.h"
+
+/**
+ * @struct RuntimeConfig
+ * @brief The parameters the running engine picks up without a restart, parsed once.
+ *
+ * Immutable once published: a reload builds a new instance. Everything else in the
+ * config files (feed transport, pools, journal, thread placement, ...) is read once at
+ * startup, and so is MAX_HISTORY, which sizes the preallocated price windows.
+ */
+struct RuntimeConfig
+{
+    uint64_t version = 0;               // 1 for the startup load, +1 per published reload
+    uint32_t maxHistory = 70;           // Restart only
+    uint32_t minHistory = 10;           // Window size before the strategy runs
+    double tradeAmount = 0.01;          // Base units per signal
+    uint32_t feedTickDelayMs = 50;      // Pause after each live tick (0 = none, for load tests)
+    uint32_t executorDelayMs = 50;      // Pause after each executed signal
+    uint32_t pnlReportIntervalSec = 10;
+    RiskLimits risk;
+
+    // Throws std::invalid_argument on a value that is not a number
+    static RuntimeConfig parse(const ConfigManager& config);
+};
+
+/**
+ * @class RuntimeConfigStore
+ * @brief Publishes the current RuntimeConfig through one atomic pointer.
+ *
+ * current() is a single acquire load, on any thread. Readers hold no reference count,
+ * so a replaced snapshot is retired rather than freed: it stays valid until the store
+ * is destroyed. Reloads are rare and a snapshot is a few dozen bytes.
+ */
+class RuntimeConfigStore
+{
+public:
+    RuntimeConfigStore() { publish(RuntimeConfig()); }
+    RuntimeConfigStore(const RuntimeConfigStore&) = delete;
+    RuntimeConfigStore& operator=(const RuntimeConfigStore&) = delete;
+
+    const RuntimeConfig& current() const { return *current_.load(std::memory_order_acquire); }
+
+    // Stamps the next version; returns the published snapshot
+    const RuntimeConfig& publish(const RuntimeConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        std::unique_ptr<RuntimeConfig> next(new RuntimeConfig(config));
+        next->version = published_.size();
+        const RuntimeConfig* published = next.get();
+        published_.push_back(std::move(next));
+        current_.store(published, std::memory_order_release);
+        return *published;
+    }
+
+private:
+    std::atomic<const RuntimeConfig*> current_{nullptr};
+    std::mutex publishMutex_;
+    std::vector<std::unique_ptr<const RuntimeConfig>> published_;   // [version]; the default is 0
+};
+
+/**
+ * @class ConfigWatcher
+ * @brief Reloads the config files when one of them changes and publishes a new RuntimeConfig.
+ *
+ * Watches the directories of the files with inotify (Linux), so editors that replace a
+ * file by renaming a new one over it are seen too. On a change, all files are read again
+ * in their original order after a short settle delay; a file that cannot be read or a
+ * value that does not parse keeps the current snapshot. Changed keys outside RuntimeConfig
+ * are logged as needing a restart. Elsewhere start() fails and the config is static.
+ */
+class ConfigWatcher
+{
+public:
+    ConfigWatcher() = default;
+    ~ConfigWatcher() { stop(); }
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    // 'loaded': the files' contents the current snapshot was built from
+    bool start(const std::vector<std::string>& paths, const ConfigManager& loaded, RuntimeConfigStore& store);
+    void stop();
+
+    uint64_t reloads() const { return reloads_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    // Re-reads the files; false (and logged) if the current snapshot was kept
+    bool reload();
+
+    std::vector<std::string> paths_;
+    std::vector<std::string> directories_;
+    ConfigManager applied_;
+    RuntimeConfigStore* store_ = nullptr;
+    intptr_t inotifyFd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> reloads_{0};
+};
+
+#endif // RUNTIME_CONFIG_H
@@ -0,0 +1,66 @@
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @class SeqLock
+ * @brief Single-writer, many-reader publication of a trivially copyable value.
+ *
+ * The writer mutates the value in place between beginWrite() and endWrite() and never
+ * waits. Readers copy the value and retry if the sequence changed meanwhile, so a
+ * reader always gets a consistent snapshot and never blocks the writer.
+ */
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied with memcpy");
+
+public:
+    // Writer thread only
+    T& beginWrite()
+    {
+        sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return value_;
+    }
+
+    void endWrite() { sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // The writer may read its own value without the protocol
+    const T& writerView() const { return value_; }
+
+    // Any thread
+    T read() const
+    {
+        uint64_t version;
+        return read(version);
+    }
+
+    // Also returns the version() the copy was taken at
+    T read(uint64_t& version) const
+    {
+        T copy;
+        uint64_t before;
+        uint64_t after;
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            std::memcpy(static_cast<void*>(&copy), static_cast<const void*>(&value_), sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+        version = before >> 1;
+        return copy;
+    }
+
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    T value_{};
+};
+
+#endif // SEQ_LOCK_H
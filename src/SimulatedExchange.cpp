@@ -0,0 +1,78 @@
+#include "SimulatedExchange.h"
+#include <algorithm>
+
+SimulatedExchange::SimulatedExchange(const LiquidityConfig& config)
+    : config_(config),
+      venues_(MAX_SYMBOLS)
+{
+}
+
+OrderBook& SimulatedExchange::book(SymbolId symbol)
+{
+    Venue& venue = venues_[symbol];
+    if (!venue.book) {
+        // Created on the first order for a symbol; everything after that is preallocated
+        venue.book = std::make_unique<OrderBook>(config_.bookLevels, config_.maxOrders);
+        venue.quotes.reserve(2 * config_.levels);
+        venue.book->setFillHandler([this, symbol](const BookFill& fill) {
+            if (fillHandler_) {
+                fillHandler_(symbol, fill);
+            }
+        });
+    }
+    return *venue.book;
+}
+
+void SimulatedExchange::updateReference(SymbolId symbol, PriceTicks referencePrice)
+{
+    OrderBook& orderBook = book(symbol);
+    Venue& venue = venues_[symbol];
+
+    // Keep the reference price inside the middle half of the window
+    const PriceTicks quarter = static_cast<PriceTicks>(config_.bookLevels / 4);
+    const bool recenter = !venue.centered || !orderBook.inWindow(referencePrice - quarter) ||
+                          !orderBook.inWindow(referencePrice + quarter);
+    // Quotes stand until the reference moves by a tick: depth taken at an unchanged
+    // price stays taken, and an order costs no cancel/re-quote of every level
+    if (!recenter && venue.quoted && referencePrice == venue.quotedPrice) {
+        return;
+    }
+
+    for (OrderHandle handle : venue.quotes) {
+        orderBook.cancel(handle, LIQUIDITY_ORDER_ID);
+    }
+    venue.quotes.clear();
+
+    if (recenter && orderBook.recenter(referencePrice)) {
+        venue.centered = true;
+    }
+    venue.quoted = true;
+    venue.quotedPrice = referencePrice;
+
+    const QtyLots depth = SymbolTable::instance().scale(symbol).toLots(config_.depthPerLevel);
+    const PriceTicks halfSpread = std::max<PriceTicks>(1, config_.spreadTicks / 2);
+    for (uint32_t i = 0; i < config_.levels; ++i) {
+        const PriceTicks offset = halfSpread + i;
+        BookResult bid = orderBook.submit(LIQUIDITY_ORDER_ID, OrderSide::BUY, OrderType::LIMIT,
+                                          referencePrice - offset, depth);
+        BookResult ask = orderBook.submit(LIQUIDITY_ORDER_ID, OrderSide::SELL, OrderType::LIMIT,
+                                          referencePrice + offset, depth);
+        if (bid.handle != INVALID_ORDER_HANDLE) {
+            venue.quotes.push_back(bid.handle);
+        }
+        if (ask.handle != INVALID_ORDER_HANDLE) {
+            venue.quotes.push_back(ask.handle);
+        }
+    }
+}
+
+BookResult SimulatedExchange::submit(SymbolId symbol, uint64_t orderId, OrderSide side, OrderType type,
+                                     PriceTicks price, QtyLots quantity)
+{
+    return book(symbol).submit(orderId, side, type, price, quantity);
+}
+
+bool SimulatedExchange::cancel(SymbolId symbol, OrderHandle handle, uint64_t orderId)
+{
+    return book(symbol).cancel(handle, orderId);
+}
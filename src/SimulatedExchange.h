@@ -0,0 +1,63 @@
+#ifndef SIMULATED_EXCHANGE_H
+#define SIMULATED_EXCHANGE_H
+
+#include <memory>
+#include <vector>
+#include "OrderBook.h"
+#include "SymbolTable.h"
+
+// Synthetic liquidity quoted around the reference price of every symbol
+struct LiquidityConfig
+{
+    uint32_t levels = 10;           // Price levels quoted per side
+    PriceTicks spreadTicks = 2;     // Distance between best bid and best ask
+    double depthPerLevel = 0.05;    // Quantity quoted at each level (converted with the symbol's lot scale)
+    size_t bookLevels = 4096;       // Price window of each book, in ticks
+    size_t maxOrders = 65536;       // Resting order capacity of each book
+};
+
+/**
+ * @class SimulatedExchange
+ * @brief In-process venue: one OrderBook per symbol plus a synthetic market maker.
+ *
+ * updateReference() re-quotes the market maker when the latest price moves, so orders
+ * submitted by the executor see finite depth, a spread and partial fills instead of
+ * unlimited liquidity at the signal price. Market-maker orders use order id 0.
+ */
+class SimulatedExchange
+{
+public:
+    using FillHandler = std::function<void(SymbolId, const BookFill&)>;
+
+    static constexpr uint64_t LIQUIDITY_ORDER_ID = 0;
+
+    explicit SimulatedExchange(const LiquidityConfig& config = LiquidityConfig());
+
+    void setFillHandler(FillHandler handler) { fillHandler_ = std::move(handler); }
+
+    // Replaces the synthetic quotes of 'symbol' around 'referencePrice', unless they
+    // already stand around that price
+    void updateReference(SymbolId symbol, PriceTicks referencePrice);
+
+    BookResult submit(SymbolId symbol, uint64_t orderId, OrderSide side, OrderType type,
+                      PriceTicks price, QtyLots quantity);
+    bool cancel(SymbolId symbol, OrderHandle handle, uint64_t orderId);
+
+    OrderBook& book(SymbolId symbol);
+
+private:
+    struct Venue
+    {
+        std::unique_ptr<OrderBook> book;
+        std::vector<OrderHandle> quotes;   // Resting market-maker orders
+        PriceTicks quotedPrice = 0;        // Reference the quotes were placed around
+        bool quoted = false;
+        bool centered = false;
+    };
+
+    LiquidityConfig config_;
+    std::vector<Venue> venues_;
+    FillHandler fillHandler_;
+};
+
+#endif // SIMULATED_EXCHANGE_H
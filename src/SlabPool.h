@@ -0,0 +1,81 @@
+#ifndef SLAB_POOL_H
+#define SLAB_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class SlabPool
+ * @brief Fixed-size object pool made of equally sized slabs, addressed by dense index.
+ *
+ * Slabs for 'preallocated' objects are created up front, so acquire()/release() of
+ * up to that many live objects never touches the heap. Beyond that the pool grows
+ * one slab at a time until 'maxObjects'; acquire() then returns INVALID_INDEX.
+ * Objects are never destroyed or moved, so references stay valid while acquired.
+ */
+template <typename T, size_t SLAB_SHIFT = 10>
+class SlabPool
+{
+public:
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+    static constexpr size_t SLAB_SIZE = size_t(1) << SLAB_SHIFT;
+
+    SlabPool(size_t preallocated, size_t maxObjects)
+        : maxSlabs_((maxObjects + SLAB_SIZE - 1) / SLAB_SIZE)
+    {
+        slabs_.reserve(maxSlabs_);
+        freeList_.reserve(maxSlabs_ * SLAB_SIZE);
+        const size_t initialSlabs = std::min((preallocated + SLAB_SIZE - 1) / SLAB_SIZE, maxSlabs_);
+        for (size_t i = initialSlabs; i > 0; --i) {
+            addSlab(i - 1);
+        }
+    }
+
+    uint32_t acquire()
+    {
+        if (freeList_.empty()) {
+            if (slabs_.size() >= maxSlabs_) {
+                return INVALID_INDEX;
+            }
+            addSlab(slabs_.size());
+            ++growthCount_;
+        }
+        const uint32_t index = freeList_.back();
+        freeList_.pop_back();
+        return index;
+    }
+
+    void release(uint32_t index) { freeList_.push_back(index); }
+
+    T& operator[](uint32_t index) { return slabs_[index >> SLAB_SHIFT][index & (SLAB_SIZE - 1)]; }
+    const T& operator[](uint32_t index) const { return slabs_[index >> SLAB_SHIFT][index & (SLAB_SIZE - 1)]; }
+
+    size_t capacity() const { return slabs_.size() * SLAB_SIZE; }
+    size_t inUse() const { return capacity() - freeList_.size(); }
+    size_t growthCount() const { return growthCount_; }   // Slabs added after construction
+
+private:
+    // Slabs are created in any order but indexed by position; the free list is pushed
+    // highest index first, so low indices are handed out first
+    void addSlab(size_t position)
+    {
+        if (slabs_.size() <= position) {
+            slabs_.resize(position + 1);
+        }
+        slabs_[position] = std::make_unique<T[]>(SLAB_SIZE);
+        const size_t first = position * SLAB_SIZE;
+        for (size_t i = SLAB_SIZE; i > 0; --i) {
+            freeList_.push_back(static_cast<uint32_t>(first + i - 1));
+        }
+    }
+
+    size_t maxSlabs_;
+    size_t growthCount_ = 0;
+    std::vector<std::unique_ptr<T[]>> slabs_;
+    std::vector<uint32_t> freeList_;
+};
+
+#endif // SLAB_POOL_H
@@ -0,0 +1,80 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SpscRing
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Capacity is rounded up to a power of two and allocated once. tryPush() never blocks:
+ * it returns false when the ring is full and the producer decides whether to drop
+ * the item or retry.
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+        : mask_(roundUpPow2(capacity) - 1), slots_(mask_ + 1)
+    {
+    }
+
+    // Producer side
+    bool tryPush(const T& item)
+    {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ > mask_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ > mask_) {
+                return false;
+            }
+        }
+        slots_[head & mask_] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool tryPop(T& item)
+    {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cachedHead_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail == cachedHead_) {
+                return false;
+            }
+        }
+        item = slots_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+    size_t size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+
+private:
+    static size_t roundUpPow2(size_t n)
+    {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    const size_t mask_;
+    std::vector<T> slots_;
+
+    // Producer and consumer indices on separate cache lines; each side caches the other's index
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t cachedTail_ = 0;
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    uint64_t cachedHead_ = 0;
+};
+
+#endif // SPSC_RING_H
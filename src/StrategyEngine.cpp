@@ -1,18 +1,61 @@
 #include "StrategyEngine.h"
 #include <iomanip>
-using json = nlohmann::json;
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include "Metrics.h"
+#include "ThreadPlacement.h"
+
+#ifdef MSG_NOSIGNAL
+    #define REPLAY_SEND_FLAGS MSG_NOSIGNAL   // A feeder that hung up must not raise SIGPIPE
+#else
+    #define REPLAY_SEND_FLAGS 0
+#endif
 
 // Simplified constructor implementation
 StrategyEngine::StrategyEngine(SystemContext& ctx)
     : marketDataCtx_(ctx.marketData),
       actionSignalCtx_(ctx.actionSignal),
       systemState_(ctx.state),
-      priceHistory_(),
-      maxHistory_(ctx.maxHistory), 
-      minHistory_(ctx.minHistory)
+      risk_(ctx.risk),
+      signalLog_(ctx.signalLog),
+      marks_(ctx.marks),
+      checkpoint_(ctx.checkpoint),
+      recorder_(ctx.recorder),
+      bars_(ctx.bars),
+      clock_(*ctx.clock),
+      config_(ctx.config),
+      riskConfigVersion_(ctx.config.current().version),
+      priceHistory_(MAX_SYMBOLS, PriceWindow(ctx.config.current().maxHistory)),
+      sequencer_(ctx.feedSequencing),
+      batchMode_(ctx.feedBatch),
+      batchPerTick_(ctx.feedBatchPerTick),
+      batch_(ctx.feedBatch || ctx.feedMulticast ? BATCH_CAPACITY : 0),
+      ioUring_(ctx.ioUring),
+      multicast_(ctx.feedMulticast),
+      multicastConfig_(ctx.multicastFeed)
 {
+    checkpoint_.reserve(priceHistory_);
     StrategyWrapper::initialize();
-    
+    const char* barSeries = StrategyWrapper::barSeries();
+    BarSpec barSpec;
+    if (barSeries != nullptr && !BarSpec::parse(barSeries, barSpec)) {
+        LOG(ERROR) << "Strategy bar series \"" << barSeries << "\" is not a valid bar spec";
+        barSeries = nullptr;
+    }
+    if (barSeries != nullptr) {
+        bars_.subscribe(bars_.add(barSpec),
+                        [this](SymbolId symbol, const BarSeries& series) { OnBarClose(symbol, series); });
+        LOG(Strategy) << "Strategy evaluated on " << barSpec.name << " bars";
+    }
+    if (ctx.feedConflation) {
+        // Bar signals are raised where the bars are built, on the ingest thread when
+        // conflating, while the risk gate expects a single signalling thread
+        conflate_ = StrategyWrapper::conflationSafe() && barSeries == nullptr;
+        if (!conflate_) {
+            LOG(WARN) << "FEED_CONFLATION ignored: the active strategy needs every tick";
+        }
+    }
 }
 
 void StrategyEngine::closeSockets() 
@@ -28,8 +71,27 @@ void StrategyEngine::closeSockets()
     }
 }
 
+void StrategyEngine::WarmStart()
+{
+    WindowCheckpointStats stats;
+    if (checkpoint_.load(priceHistory_, stats)) {
+        LOG(Strategy) << "Warm start: restored " << stats.symbols << " symbol windows (" << stats.prices
+                      << " prices) saved " << std::fixed << std::setprecision(1) << stats.ageSeconds
+                      << " s ago, loaded in " << std::setprecision(3) << stats.milliseconds << " ms";
+    } else if (stats.stale) {
+        LOG(Strategy) << "Warm start: checkpoint is " << std::fixed << std::setprecision(1)
+                      << stats.ageSeconds << " s old, starting with empty windows";
+    }
+}
+
 void StrategyEngine::ProcessMarketDataAndGenerateSignals()
 {
+    ThreadPlacement::instance().apply(conflate_ ? ThreadRole::INGEST : ThreadRole::STRATEGY);
+    if (multicast_) {
+        ReceiveMulticast();
+        return;
+    }
+
     // 1. Initialize Socket environment (cross-platform)
     if (!PlatformUtils::initSocketEnv()) {
         std::cerr << "Socket init failed\n";
@@ -60,14 +122,25 @@ void StrategyEngine::ProcessMarketDataAndGenerateSignals()
     listen(server_fd_, 1);
     PlatformUtils::setSocketRecvTimeout(server_fd_, std::chrono::milliseconds(500));
 
+    if (ioUring_ && !(uring_.init(64) && uring_.provideBuffers(URING_BUFFERS, URING_BUFFER_BYTES))) {
+        LOG(WARN) << "Feed: io_uring receive unavailable, using recv";
+        uring_.close();
+    }
+
+    std::thread strategyThread = StartConflatedStrategy();
+
     client_fd_ = INVALID_SOCKET_VAL;
-    std::string buffer;
-    char recv_buf[1024];
+    size_t pending = 0; // Bytes of an incomplete line kept at the front of recvBuffer_
+    TradeData currentMarketData;
 
     while (systemState_.runningFlag.load(std::memory_order_acquire) &&
            !systemState_.brokenFlag.load(std::memory_order_acquire))
     {
-         TradeData currentMarketData; 
+        // Receives time out every 500ms, so this runs even when the feed is idle
+        if (!conflate_ && checkpoint_.saveDue()) {
+            checkpoint_.save(priceHistory_);
+        }
+
         // 1. Handle connection: if no client is currently connected, execute accept
         if (client_fd_ == INVALID_SOCKET_VAL) {
             // Because timeout is set, accept will block here for a maximum of 500ms
@@ -80,12 +153,26 @@ void StrategyEngine::ProcessMarketDataAndGenerateSignals()
 
             // After successful connection, set timeout for the newly created client_fd_ as well
             PlatformUtils::setSocketRecvTimeout(client_fd_, std::chrono::milliseconds(500));
+            pending = 0;
+            if (uring_.ready()) {
+                uringClosed_ = false;
+                uring_.recvMultishot(client_fd_, 0);
+                uring_.submit();
+            }
             LOG(Strategy) << "Client connected successfully.";
         }
 
+        if (pending == RECV_BUFFER_SIZE) {
+            // A single line larger than the whole buffer can never complete: drop it
+            std::cerr << "[ERROR] Message exceeds receive buffer, dropping\n";
+            pending = 0;
+        }
+
         // 2. Receive data: also controlled by the 500ms timeout
-        int bytes = recv(client_fd_, recv_buf, sizeof(recv_buf), 0);
-        
+        int bytes = uring_.ready()
+            ? ReceiveUring(pending)
+            : recv(client_fd_, recvBuffer_ + pending, static_cast<int>(RECV_BUFFER_SIZE - pending), 0);
+
         if (bytes < 0) {
             // Check if it is a timeout error (EAGAIN/EWOULDBLOCK/WSAETIMEDOUT)
             if (PlatformUtils::isSocketTimeout()) { 
@@ -103,22 +190,59 @@ void StrategyEngine::ProcessMarketDataAndGenerateSignals()
             continue;
         }
 
-        // 6. Valid data received: process normally
-        buffer.append(recv_buf, bytes);
-
-        size_t pos;
-        while ((pos = buffer.find('\n')) != std::string::npos) 
+        // 6. Valid data received: process every complete line in place
+        const uint64_t receivedNs = monotonicNs();
+        size_t total = pending + static_cast<size_t>(bytes);
+        if (batchMode_ && !uring_.ready()) {
+            total = DrainSocket(total);
+        }
+        size_t start = 0;
+        const char* newline;
+        while ((newline = static_cast<const char*>(
+                    std::memchr(recvBuffer_ + start, '\n', total - start))) != nullptr)
         {
-            std::string line = buffer.substr(0, pos);
-            buffer.erase(0, pos + 1);
-            HandleMessage(line,currentMarketData);
+            const size_t lineLen = static_cast<size_t>(newline - (recvBuffer_ + start));
+            if (batchMode_) {
+                // Parsed straight into the batch; everything else waits for ProcessBatch
+                if (TickParser::Parse(recvBuffer_ + start, lineLen, batch_[batchSize_])) {
+                    if (++batchSize_ == batch_.size()) {
+                        ProcessBatch(receivedNs);
+                    }
+                } else {
+                    Metrics::count(MetricCounter::PARSE_ERRORS);
+                    std::cerr << "[ERROR] Failed to parse JSON\n";
+                }
+                start += lineLen + 1;
+                continue;
+            }
+            const bool parsed = HandleMessage(recvBuffer_ + start, lineLen, currentMarketData);
+            start += lineLen + 1;
+            if (!parsed) {
+                continue;
+            }
+            const SequenceCheck sequence = sequencer_.check(currentMarketData, receivedNs);
+            if (sequence != SequenceCheck::ACCEPT && !HandleSequenceBreak(currentMarketData, sequence)) {
+                continue;
+            }
+            recorder_.tap(currentMarketData);
 
-            LOG(Strategy) << " Received price: $" << std::fixed << std::setprecision(2)
-            << currentMarketData.price_ << std::endl;
-            PlatformUtils::flushConsole(); // Cross-platform console flush
+            if (conflate_) {
+                IngestTick(currentMarketData, receivedNs);
+                PublishConflated(currentMarketData, receivedNs);
+                continue;
+            }
+            HandleTick(currentMarketData, receivedNs);
+            ThrottleTick();
+        }
+
+        if (batchSize_ > 0) {
+            ProcessBatch(receivedNs);
+        }
 
-            HandlePrice(currentMarketData.price_);
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // Keep the incomplete tail for the next recv
+        pending = total - start;
+        if (pending > 0 && start > 0) {
+            std::memmove(recvBuffer_, recvBuffer_ + start, pending);
         }
     }
     
@@ -129,11 +253,297 @@ void StrategyEngine::ProcessMarketDataAndGenerateSignals()
     if (server_fd_ != INVALID_SOCKET_VAL) {
         CLOSE_SOCKET(server_fd_);
     }
+    uring_.close();
     PlatformUtils::cleanupSocketEnv(); // Cross-platform Socket environment cleanup
+    FinishFeed(strategyThread);
+}
+
+std::thread StrategyEngine::StartConflatedStrategy()
+{
+    // Conflated: this thread becomes the ingest thread and the strategies get their own
+    std::thread strategyThread;
+    if (conflate_) {
+        ingestDone_.store(false, std::memory_order_release);
+        strategyThread = std::thread(&StrategyEngine::RunConflatedStrategy, this);
+        LOG(Strategy) << "Feed conflation on: latest tick per symbol to the strategy thread";
+    }
+    return strategyThread;
+}
+
+void StrategyEngine::FinishFeed(std::thread& strategyThread)
+{
+    if (strategyThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(conflationMutex_);
+            ingestDone_.store(true, std::memory_order_release);
+        }
+        conflationCv_.notify_one();
+        strategyThread.join();
+    }
+    if (checkpoint_.enabled()) {
+        // A periodic image may still be queued; the final one must not be skipped
+        checkpoint_.flush();
+        if (checkpoint_.save(priceHistory_) && checkpoint_.flush()) {
+            LOG(Strategy) << "Price windows checkpointed.";
+        }
+    }
     LOG(Strategy) << "StrategyEngine thread finished." ;
     PlatformUtils::flushConsole();
 }
 
+void StrategyEngine::ReceiveMulticast()
+{
+    MulticastFeed feed;
+    if (!feed.open(multicastConfig_)) {
+        std::cerr << "[ERROR] Multicast feed unavailable\n";
+        return;
+    }
+    std::thread strategyThread = StartConflatedStrategy();
+
+    while (systemState_.runningFlag.load(std::memory_order_acquire) &&
+           !systemState_.brokenFlag.load(std::memory_order_acquire))
+    {
+        // Receives time out every 500ms, so this runs even when the feed is idle
+        if (!conflate_ && checkpoint_.saveDue()) {
+            checkpoint_.save(priceHistory_);
+        }
+        const int count = feed.receive();
+        if (count < 0) {
+            std::cerr << "[ERROR] Multicast receive failed\n";
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        // Everything one receive returned is a batch; a datagram carries one or more lines
+        const uint64_t receivedNs = monotonicNs();
+        for (int slot = 0; slot < count; ++slot) {
+            if (feed.truncated(slot)) {
+                Metrics::count(MetricCounter::PARSE_ERRORS);
+                std::cerr << "[ERROR] Multicast datagram exceeds FEED_MULTICAST_DATAGRAM_BYTES, dropping\n";
+                continue;
+            }
+            const char* data = feed.data(slot);
+            const char* end = data + feed.length(slot);
+            while (data < end) {
+                const char* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+                const char* lineEnd = newline != nullptr ? newline : end;
+                if (lineEnd > data) {
+                    if (TickParser::Parse(data, static_cast<size_t>(lineEnd - data), batch_[batchSize_])) {
+                        if (++batchSize_ == batch_.size()) {
+                            ProcessBatch(receivedNs);
+                        }
+                    } else {
+                        Metrics::count(MetricCounter::PARSE_ERRORS);
+                        std::cerr << "[ERROR] Failed to parse JSON\n";
+                    }
+                }
+                data = lineEnd + 1;
+            }
+        }
+        if (batchSize_ > 0) {
+            ProcessBatch(receivedNs);
+        }
+    }
+
+    feed.close();
+    FinishFeed(strategyThread);
+}
+
+int StrategyEngine::ReceiveUring(size_t& pending)
+{
+    if (uringClosed_) {
+        return 0;
+    }
+    // Waits up to 500ms for the first completion, then appends every one already posted
+    IoCompletion completion;
+    if (!uring_.peek(completion)) {
+        uring_.submit(1, 500);
+    }
+    size_t total = pending;
+    while (uring_.peek(completion)) {
+        if (completion.result > 0 && total + static_cast<size_t>(completion.result) > RECV_BUFFER_SIZE) {
+            if (total > pending) {
+                break;  // Left for the next call, after these lines are processed
+            }
+            // A single line larger than the whole buffer can never complete: drop it
+            std::cerr << "[ERROR] Message exceeds receive buffer, dropping\n";
+            total = pending = 0;
+        }
+        uring_.consume();
+        if (completion.hasBuffer()) {
+            if (completion.result > 0) {
+                std::memcpy(recvBuffer_ + total, uring_.buffer(completion.bufferId()), static_cast<size_t>(completion.result));
+                total += static_cast<size_t>(completion.result);
+            }
+            uring_.recycle(completion.bufferId());
+        }
+        if (!completion.more()) {
+            if (completion.result != -ENOBUFS) {
+                // Closed by the feeder, or failed: report it once the data before it is processed
+                uringClosed_ = true;
+                break;
+            }
+            // Every buffer was in use: they are back now, so re-arm
+            uring_.recvMultishot(client_fd_, 0);
+            uring_.submit();
+        }
+    }
+    if (total > pending) {
+        return static_cast<int>(total - pending);
+    }
+    if (uringClosed_) {
+        return 0;
+    }
+    errno = EAGAIN;     // Nothing within the timeout: same as a timed-out recv
+    return -1;
+}
+
+size_t StrategyEngine::DrainSocket(size_t total)
+{
+#ifdef MSG_DONTWAIT
+    // Everything already queued on the socket, without blocking; a close or error is
+    // left for the next blocking recv to report
+    while (total < RECV_BUFFER_SIZE) {
+        const int more = recv(client_fd_, recvBuffer_ + total, static_cast<int>(RECV_BUFFER_SIZE - total), MSG_DONTWAIT);
+        if (more <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(more);
+    }
+#endif
+    return total;
+}
+
+void StrategyEngine::ProcessBatch(uint64_t receivedNs)
+{
+    Metrics::count(MetricCounter::FEED_BATCHES);
+    uint64_t touched = 0;
+    for (size_t i = 0; i < batchSize_; ++i) {
+        const TradeData& tick = batch_[i];
+        const SequenceCheck sequence = sequencer_.check(tick, receivedNs);
+        if (sequence != SequenceCheck::ACCEPT && !HandleSequenceBreak(tick, sequence)) {
+            continue;
+        }
+        recorder_.tap(tick);
+        IngestTick(tick, receivedNs);
+        if (conflate_) {
+            PublishConflated(tick, receivedNs);
+        } else if (batchPerTick_) {
+            EvaluateTick(tick, receivedNs);
+            ThrottleTick();
+        } else {
+            priceHistory_[tick.symbol_].push_back(tick.price_);
+            batchLatest_[tick.symbol_] = static_cast<uint32_t>(i);
+            touched |= uint64_t(1) << tick.symbol_;
+        }
+    }
+
+    // One evaluation per symbol, on its window after the whole batch
+    while (touched != 0) {
+        const SymbolId symbol = static_cast<SymbolId>(__builtin_ctzll(touched));
+        touched &= touched - 1;
+        EvaluateWindow(batch_[batchLatest_[symbol]], receivedNs);
+        ThrottleTick();
+    }
+    batchSize_ = 0;
+}
+
+void StrategyEngine::ThrottleTick()
+{
+    const uint32_t delayMs = config_.current().feedTickDelayMs;
+    if (delayMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+    }
+}
+
+void StrategyEngine::PublishConflated(const TradeData& tick, uint64_t receivedNs)
+{
+    bool conflated = false;
+    if (conflation_.publish(tick, receivedNs, conflated)) {
+        std::lock_guard<std::mutex> lock(conflationMutex_);
+        conflationCv_.notify_one();
+    }
+    if (conflated) {
+        Metrics::count(MetricCounter::TICKS_CONFLATED);
+    }
+}
+
+void StrategyEngine::RunConflatedStrategy()
+{
+    ThreadPlacement::instance().apply(ThreadRole::STRATEGY);
+    ConflationBoard::Entry entry;
+    for (;;) {
+        {
+            // Timed, so checkpoints are still written while the feed is idle
+            std::unique_lock<std::mutex> lock(conflationMutex_);
+            conflationCv_.wait_for(lock, std::chrono::milliseconds(500), [this] {
+                return conflation_.pending() || ingestDone_.load(std::memory_order_acquire);
+            });
+        }
+        if (checkpoint_.saveDue()) {
+            checkpoint_.save(priceHistory_);
+        }
+
+        uint64_t dirty = conflation_.take();
+        while (dirty != 0) {
+            const SymbolId symbol = static_cast<SymbolId>(__builtin_ctzll(dirty));
+            dirty &= dirty - 1;
+            bool reset = false;
+            if (!conflation_.read(symbol, entry, reset)) {
+                continue;
+            }
+            // Only what was appended before the reset request is cleared
+            if (reset) {
+                priceHistory_[symbol].clear();
+            }
+            EvaluateTick(entry.tick, entry.receivedNs);
+            ThrottleTick();
+        }
+
+        if (ingestDone_.load(std::memory_order_acquire) && !conflation_.pending()) {
+            break;
+        }
+    }
+    LOG(Strategy) << "Conflated strategy thread finished.";
+}
+
+void StrategyEngine::ResetWindow(SymbolId symbol)
+{
+    // The bars are fed on this thread in every mode; a bar spanning the break is not kept
+    bars_.discardOpen(symbol);
+    if (conflate_) {
+        conflation_.requestReset(symbol);
+    } else {
+        priceHistory_[symbol].clear();
+    }
+}
+
+void StrategyEngine::ReplayTicks(ITickSource& source, const std::function<void()>& afterTick)
+{
+    LOG(Strategy) << "Replay started.";
+    const auto started = std::chrono::steady_clock::now();
+    uint64_t ticks = 0;
+    TradeData tick;
+    while (systemState_.runningFlag.load(std::memory_order_acquire) &&
+           !systemState_.brokenFlag.load(std::memory_order_acquire) &&
+           source.Next(tick))
+    {
+        HandleTick(tick, monotonicNs());
+        if (afterTick) {
+            afterTick();
+        }
+        ++ticks;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    LOG(Strategy) << "Replay finished: " << ticks << " ticks in " << std::fixed << std::setprecision(3)
+                  << seconds << " s";
+
+    // Let the monitor loop shut down
+    systemState_.feedFinished.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(systemState_.brokenMutex);
+    systemState_.brokenCV.notify_all();
+}
+
 bool StrategyEngine::InitSocket() 
 {
 #ifdef _WIN32
@@ -144,54 +554,178 @@ bool StrategyEngine::InitSocket()
 #endif
 }
 
-void StrategyEngine::HandleMessage(const std::string& jsonStr, TradeData& currentMarketData) 
+bool StrategyEngine::HandleSequenceBreak(const TradeData& tick, SequenceCheck check)
 {
-    try 
-    {
-        auto j = json::parse(jsonStr);
-        std::cout << "[RECV] " << j["symbol"] << " $" << j["price"] << " @ " << j["timestamp"] << std::endl;
-        currentMarketData.price_ = j["price"];
-        currentMarketData.timestamp_ms_ = j["timestamp"];
-        currentMarketData.symbol_ = j["symbol"];
-    } 
-    catch (...) 
+    MetricsShard& metrics = Metrics::local();
+    const char* symbol = SymbolTable::instance().name(tick.symbol_);
+    const uint32_t missing = sequencer_.lastGapSize();
+    if (missing > 0) {
+        metrics.add(MetricCounter::FEED_GAPS);
+        metrics.add(MetricCounter::FEED_MISSING_TICKS, missing);
+    }
+
+    switch (check) {
+    case SequenceCheck::DISCARD:
+        metrics.add(MetricCounter::FEED_DISCARDED);
+        return false;
+    case SequenceCheck::REPLAY:
+        if (RequestReplay(tick)) {
+            metrics.add(MetricCounter::FEED_REPLAY_REQUESTS);
+            metrics.add(MetricCounter::FEED_DISCARDED);
+            LOG(WARN) << "Feed gap on " << symbol << ": " << missing << " ticks missing before seq " << tick.seq_
+                      << ", replay requested";
+            return false;
+        }
+        sequencer_.replayFailed(tick);
+        LOG(WARN) << "Feed gap on " << symbol << ": replay request failed";
+        break;
+    default:
+        break;
+    }
+
+    // The window no longer reflects a contiguous price series: refill it from this tick
+    ResetWindow(tick.symbol_);
+    metrics.add(MetricCounter::FEED_WINDOW_REBUILDS);
+    LOG(WARN) << "Feed " << (tick.seq_ == 1 ? "restart" : "gap") << " on " << symbol << " at seq " << tick.seq_
+              << ": price window rebuilt";
+    return true;
+}
+
+bool StrategyEngine::RequestReplay(const TradeData& tick)
+{
+    if (client_fd_ == INVALID_SOCKET_VAL) {
+        return false;
+    }
+    char request[96];
+    const int len = std::snprintf(request, sizeof(request), "{\"replay\": \"%s\", \"from\": %u, \"to\": %u}\n",
+                                  SymbolTable::instance().name(tick.symbol_), sequencer_.replayFrom(tick.symbol_),
+                                  tick.seq_);
+    if (len <= 0 || static_cast<size_t>(len) >= sizeof(request)) {
+        return false;
+    }
+    return send(client_fd_, request, len, REPLAY_SEND_FLAGS) == len;
+}
+
+bool StrategyEngine::HandleMessage(const char* data, size_t len, TradeData& currentMarketData) 
+{
+    if (!TickParser::Parse(data, len, currentMarketData))
     {
+        Metrics::count(MetricCounter::PARSE_ERRORS);
         std::cerr << "[ERROR] Failed to parse JSON\n";
+        return false;
     }
+    return true;
+}
+
+void StrategyEngine::HandleTick(const TradeData& tick, uint64_t receivedNs)
+{
+    IngestTick(tick, receivedNs);
+    EvaluateTick(tick, receivedNs);
 }
 
-void StrategyEngine::HandlePrice(double price)
+void StrategyEngine::IngestTick(const TradeData& tick, uint64_t receivedNs)
 {
-    priceHistory_.push_back(price);
-    if (priceHistory_.size() > maxHistory_)
+    Metrics::count(MetricCounter::TICKS_RECEIVED);
+    // Replays take their time from the tick; everything stamped during it sees that time
+    clock_.advanceTo(tick.timestamp_ms_);
+    const RuntimeConfig& config = config_.current();
+    if (config.version != riskConfigVersion_) {
+        // A reload was published: new limits from this tick on, whether or not a signal follows
+        risk_.setLimits(config.risk);
+        riskConfigVersion_ = config.version;
+    }
+    const PriceTicks priceTicks = SymbolTable::instance().scale(tick.symbol_).toTicks(tick.price_);
+    risk_.onTick(tick.symbol_, priceTicks);
+    if (marks_.publish(tick.symbol_, priceTicks))
     {
-        priceHistory_.pop_front();
+        // First mark since the executor last looked: wake it for mark-to-market
+        actionSignalCtx_.notify();
+    }
+    if (bars_.enabled()) {
+        barTickNs_ = receivedNs;
+        if (const size_t closed = bars_.onTick(tick)) {
+            Metrics::count(MetricCounter::BARS_CLOSED, closed);
+        }
     }
+}
+
+void StrategyEngine::OnBarClose(SymbolId symbol, const BarSeries& series)
+{
+    const Bar& bar = series.closed().back();
+    LOG(Strategy) << " Bar " << series.spec().name << " " << SymbolTable::instance().name(symbol)
+                  << " O " << bar.open << " H " << bar.high << " L " << bar.low << " C " << bar.close
+                  << " V " << bar.volume << " (" << bar.ticks << " ticks)";
+    const ActionType action = StrategyWrapper::runBarStrategy(series.closed());
+    if (action != ActionType::HOLD) {
+        EmitSignal(action, symbol, bar.close, barTickNs_);
+    }
+}
+
+void StrategyEngine::EvaluateTick(const TradeData& tick, uint64_t receivedNs)
+{
+    // Fixed-capacity window: once full, the oldest price is overwritten in place
+    priceHistory_[tick.symbol_].push_back(tick.price_);
+    EvaluateWindow(tick, receivedNs);
+}
+
+void StrategyEngine::EvaluateWindow(const TradeData& tick, uint64_t receivedNs)
+{
+    const PriceWindow& window = priceHistory_[tick.symbol_];
 
     ActionType generatedActionType = ActionType::HOLD;
-    if (priceHistory_.size() >= minHistory_)
+    if (window.size() >= config_.current().minHistory)
     {
-        generatedActionType = StrategyWrapper::runStrategy(priceHistory_);
+        generatedActionType = StrategyWrapper::runStrategy(window);
     }
+    Metrics::local().record(MetricLatency::TICK_PROCESSING, monotonicNs() - receivedNs);
 
+    // Nothing is logged per tick: only signals, in EmitSignal
     if (generatedActionType != ActionType::HOLD)
     {
-        double defaultTradeAmount = 0.01;
-        ActionSignal generatedActionSignal(generatedActionType, price, defaultTradeAmount);
+        EmitSignal(generatedActionType, tick.symbol_, tick.price_, receivedNs);
+    }
+}
 
-        {
-            // Replace with the mutex inside the context
-            std::lock_guard<std::mutex> lock(actionSignalCtx_.mutex);
-            actionSignalCtx_.queue.enqueue(generatedActionSignal); 
-            actionSignalCtx_.cv.notify_one();
-            LOG(Strategy) << " Generated signal: "
-                      << (generatedActionType == ActionType::BUY ? "BUY" : "SELL")
-                      << " at price $" << std::fixed << std::setprecision(2)
-                      << price << std::endl;
-        }
+void StrategyEngine::EmitSignal(ActionType generatedActionType, SymbolId symbol, double price, uint64_t receivedNs)
+{
+    MetricsShard& metrics = Metrics::local();
+    const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+    const RuntimeConfig& config = config_.current();
+    // Indicators stay in double; the signal leaves the engine in fixed point
+    ActionSignal generatedActionSignal(generatedActionType, symbol,
+                                       scale.toTicks(price), scale.toLots(config.tradeAmount), clock_.nowMs());
+    generatedActionSignal.tickStamp_ = static_cast<uint32_t>(receivedNs >> 6);
+
+    // Rejections are counted and logged by the gate off this path
+    if (risk_.check(generatedActionSignal) != RiskReason::NONE)
+    {
+        metrics.add(MetricCounter::SIGNALS_REJECTED);
+        return;
     }
-    else
+
+    // Like the unbounded queue it replaces, a full ring never loses a signal: the executor
+    // is far behind, so wait for it (it drains the ring between its per-signal pauses)
+    while (!actionSignalCtx_.queue.tryPush(generatedActionSignal))
     {
-        LOG(Strategy) << "No signal (HOLD)." ;
+        if (!systemState_.runningFlag.load(std::memory_order_acquire) ||
+            systemState_.brokenFlag.load(std::memory_order_acquire))
+        {
+            // Shutting down: nothing will execute it, so release what the gate reserved
+            risk_.onOrderDone(symbol, generatedActionType, generatedActionSignal.amount_);
+            return;
+        }
+        actionSignalCtx_.notify();
+        std::this_thread::yield();
     }
+    actionSignalCtx_.notify();
+    metrics.add(MetricCounter::SIGNALS);
+    metrics.record(MetricLatency::TICK_TO_SIGNAL, monotonicNs() - receivedNs);
+    // Formatted and written by the monitor loop, off this thread
+    TradeLogEntry entry{};
+    entry.event_ = TradeEvent::SIGNAL_EMITTED;
+    entry.price_ = generatedActionSignal.price_;
+    entry.quantity_ = generatedActionSignal.amount_;
+    entry.symbol_ = symbol;
+    entry.type_ = generatedActionType;
+    signalLog_.push(entry);
 }
\ No newline at end of file
@@ -3,8 +3,18 @@
 
 #include "pch.h"
 #include "StrategyWrapper.h"
-#include "json.hpp"
+#include "TickParser.h"
+#include "FeedSequencer.h"
+#include "ConflationBoard.h"
+#include "MulticastFeed.h"
+#include "IoUring.h"
 #include "SystemContext.h" 
+#include "TickSource.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 
 #include "../util/PlatformUtils.h"
@@ -30,21 +40,103 @@ private:
     MarketDataContext& marketDataCtx_;       
     ActionSignalContext& actionSignalCtx_;  
     SystemState& systemState_;
-    std::deque<double> priceHistory_;         
-    uint32_t maxHistory_;
-    uint32_t minHistory_;
+    RiskGate& risk_;
+    TradeLog& signalLog_;
+    MarkBoard& marks_;
+    WindowCheckpoint& checkpoint_;
+    TickRecorder& recorder_;
+    BarAggregator& bars_;
+    uint64_t barTickNs_ = 0;                  // receivedNs of the tick being fed to bars_
+    IClock& clock_;
+    const RuntimeConfigStore& config_;        // Read per tick; reloads take effect on the next one
+    uint64_t riskConfigVersion_;              // Snapshot whose limits risk_ applies; ingest thread
+    std::vector<PriceWindow> priceHistory_;   // One window per SymbolId
+    FeedSequencer sequencer_;
+
+    // Conflated mode: the socket thread publishes, a second thread runs the strategies
+    bool conflate_ = false;
+    ConflationBoard conflation_;
+    std::mutex conflationMutex_;
+    std::condition_variable conflationCv_;
+    std::atomic<bool> ingestDone_{false};
+
+    // Batch mode: every message already received is parsed into batch_ before any is processed
+    static constexpr size_t BATCH_CAPACITY = 4096;
+    bool batchMode_;
+    bool batchPerTick_;                       // Evaluate after every tick instead of once per symbol
+    std::vector<TradeData> batch_;
+    size_t batchSize_ = 0;
+    uint32_t batchLatest_[MAX_SYMBOLS] = {};  // Index in batch_ of each symbol's newest tick
+
+    // io_uring receive (IO_BACKEND=uring): one multishot recv per connection into provided buffers
+    static constexpr uint16_t URING_BUFFERS = 256;
+    static constexpr uint32_t URING_BUFFER_BYTES = 4096;
+    bool ioUring_;
+    IoUring uring_;
+    bool uringClosed_ = false;                // The multishot recv ended: connection closed or failed
+
+    // UDP multicast transport instead of the TCP listener; always processed in batches
+    bool multicast_;
+    MulticastFeedConfig multicastConfig_;
     SOCKET server_fd_ = INVALID_SOCKET_VAL;
     SOCKET client_fd_ = INVALID_SOCKET_VAL;
 
-    void HandlePrice(double price);
+    // Fixed receive buffer; an incomplete trailing line is kept at the front between recv calls
+    static constexpr size_t RECV_BUFFER_SIZE = 64 * 1024;
+    char recvBuffer_[RECV_BUFFER_SIZE];
+
+    // receivedNs: monotonicNs() when the tick arrived, for the latency metrics
+    void HandleTick(const TradeData& tick, uint64_t receivedNs);
+    // Per-tick bookkeeping that must see every tick: counters, clock, risk, marks and bars
+    void IngestTick(const TradeData& tick, uint64_t receivedNs);
+    // Subscribed to the strategy's bar series (IStrategy::barSeries)
+    void OnBarClose(SymbolId symbol, const BarSeries& series);
+    // Window update, strategy and signal; runs on the strategy thread
+    void EvaluateTick(const TradeData& tick, uint64_t receivedNs);
+    // Strategy and signal on the symbol's window as it is; 'tick' is its newest price
+    void EvaluateWindow(const TradeData& tick, uint64_t receivedNs);
+    // Risk check and hand-off to the executor
+    void EmitSignal(ActionType action, SymbolId symbol, double price, uint64_t receivedNs);
+    // io_uring counterpart of recv() into recvBuffer_ + pending: bytes appended, 0 = closed,
+    // -1 = timeout. Takes every receive already completed, so it also drains like DrainSocket
+    int ReceiveUring(size_t& pending);
+    // Batch mode: appends what is already queued on the socket to recvBuffer_; returns the new fill
+    size_t DrainSocket(size_t total);
+    void ProcessBatch(uint64_t receivedNs);
+    // Multicast receive loop: each receive() is parsed into batch_ and processed as one batch
+    void ReceiveMulticast();
+    // Conflated mode: starts the strategy thread (otherwise returns an empty thread)
+    std::thread StartConflatedStrategy();
+    // Joins the strategy thread and writes the final checkpoint
+    void FinishFeed(std::thread& strategyThread);
+    // FEED_TICK_DELAY_MS after each evaluation
+    void ThrottleTick();
+    void PublishConflated(const TradeData& tick, uint64_t receivedNs);
+    void RunConflatedStrategy();
+    // Clears the symbol's window on the thread that owns it
+    void ResetWindow(SymbolId symbol);
     bool InitSocket();
-    void HandleMessage(const std::string& jsonStr, TradeData& currentMarketData);
+    bool HandleMessage(const char* data, size_t len, TradeData& currentMarketData);
+    // Off the fast path: counts and recovers a sequence break; true if the tick is still processed
+    bool HandleSequenceBreak(const TradeData& tick, SequenceCheck check);
+    // Asks the connected feeder to resend the symbol's ticks from the first missing one
+    bool RequestReplay(const TradeData& tick);
 public:
     StrategyEngine() = delete;
     // Simplified constructor: only receives global context
     explicit StrategyEngine(SystemContext& ctx);
 
+    // Startup, before the engine thread runs: restores the price windows from the last checkpoint
+    void WarmStart();
+
     void ProcessMarketDataAndGenerateSignals();
+
+    // Live feed split into ingest and strategy threads (FEED_CONFLATION with a conflation-safe strategy)
+    bool conflating() const { return conflate_; }
+
+    // Replay mode: feeds recorded ticks through the same path as the socket, as fast as the
+    // clock allows; 'afterTick' runs on this thread after each tick (synchronous executor)
+    void ReplayTicks(ITickSource& source, const std::function<void()>& afterTick = nullptr);
     void closeSockets();
 };
 
@@ -17,26 +17,28 @@ void StrategyWrapper::cleanup()
     strategy_ = nullptr;
 }
 
-ActionType StrategyWrapper::runStrategy(const DoubleDeque& priceHistory) 
+bool StrategyWrapper::conflationSafe()
+{
+    return strategy_ != nullptr && strategy_->conflationSafe();
+}
+
+const char* StrategyWrapper::barSeries()
+{
+    return strategy_ != nullptr ? strategy_->barSeries() : nullptr;
+}
+
+ActionType StrategyWrapper::runBarStrategy(const BarWindow& bars)
+{
+    return strategy_ != nullptr ? strategy_->onBarClose(bars) : ActionType::HOLD;
+}
+
+ActionType StrategyWrapper::runStrategy(const PriceWindow& priceHistory) 
 {
     if (!strategy_) {
         std::cerr << "Strategy is not initialized!" << std::endl;
         return ActionType::HOLD; // or handle error as needed
     }
 
-    ActionType action = strategy_->calculateAction(priceHistory);
-
-    switch (action) {
-        case ActionType::BUY:
-            std::cout << "BUY" << std::endl;
-            break;
-        case ActionType::SELL:
-            std::cout << "SELL" << std::endl;
-            break;
-        case ActionType::HOLD:
-            std::cout << "HOLD" << std::endl;
-            break;
-    }
-
-    return action;
+    // Runs on every evaluated tick: nothing is written to the console here
+    return strategy_->calculateAction(priceHistory);
 }
\ No newline at end of file
@@ -15,7 +15,16 @@ public:
     static void cleanup();
 
     // Run strategy against price history
-    static ActionType runStrategy(const DoubleDeque& priceHistory);
+    static ActionType runStrategy(const PriceWindow& priceHistory);
+
+    // The active strategy tolerates skipped ticks (IStrategy::conflationSafe)
+    static bool conflationSafe();
+
+    // Bar series the active strategy subscribes to, or nullptr (IStrategy::barSeries)
+    static const char* barSeries();
+
+    // Run strategy on a completed bar of its series
+    static ActionType runBarStrategy(const BarWindow& bars);
 
 private:
     static IStrategy* strategy_;
@@ -0,0 +1,78 @@
+#include "SymbolTable.h"
+#include <cstring>
+
+SymbolId SymbolTable::findIn(const char* name, size_t len, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        const Entry& entry = entries_[i];
+        if (entry.length == len && std::memcmp(entry.name, name, len) == 0) {
+            return static_cast<SymbolId>(i);
+        }
+    }
+    return INVALID_SYMBOL_ID;
+}
+
+SymbolId SymbolTable::find(const char* name, size_t len) const
+{
+    return findIn(name, len, count_.load(std::memory_order_acquire));
+}
+
+SymbolId SymbolTable::intern(const char* name, size_t len)
+{
+    if (len == 0 || len > MAX_SYMBOL_LENGTH) {
+        return INVALID_SYMBOL_ID;
+    }
+
+    // Fast path: already interned (every tick after the first one for a symbol)
+    SymbolId id = find(name, len);
+    if (id != INVALID_SYMBOL_ID) {
+        return id;
+    }
+
+    std::lock_guard<std::mutex> lock(insertMutex_);
+    const size_t count = count_.load(std::memory_order_relaxed);
+    id = findIn(name, len, count); // Another thread may have added it meanwhile
+    if (id != INVALID_SYMBOL_ID) {
+        return id;
+    }
+    if (count >= MAX_SYMBOLS) {
+        return INVALID_SYMBOL_ID;
+    }
+
+    Entry& entry = entries_[count];
+    std::memcpy(entry.name, name, len);
+    entry.name[len] = '\0';
+    entry.length = static_cast<uint8_t>(len);
+    entry.scale = defaultScale_;
+    count_.store(count + 1, std::memory_order_release);
+    return static_cast<SymbolId>(count);
+}
+
+SymbolId SymbolTable::intern(const char* name)
+{
+    return intern(name, std::strlen(name));
+}
+
+const char* SymbolTable::name(SymbolId id) const
+{
+    if (id >= count_.load(std::memory_order_acquire)) {
+        return "?";
+    }
+    return entries_[id].name;
+}
+
+const InstrumentScale& SymbolTable::scale(SymbolId id) const
+{
+    if (id >= count_.load(std::memory_order_acquire)) {
+        return defaultScale_;
+    }
+    return entries_[id].scale;
+}
+
+void SymbolTable::setScale(SymbolId id, const InstrumentScale& scale)
+{
+    std::lock_guard<std::mutex> lock(insertMutex_);
+    if (id < count_.load(std::memory_order_relaxed)) {
+        entries_[id].scale = scale;
+    }
+}
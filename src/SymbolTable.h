@@ -0,0 +1,71 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "FixedPoint.h"
+
+// Compact instrument identifier carried by TradeData / ActionSignal
+using SymbolId = uint16_t;
+
+constexpr SymbolId INVALID_SYMBOL_ID = 0xFFFF;
+constexpr size_t MAX_SYMBOLS = 64;          // Ids are dense: 0 .. MAX_SYMBOLS-1
+constexpr size_t MAX_SYMBOL_LENGTH = 15;    // Excluding the terminating '\0'
+
+/**
+ * @class SymbolTable
+ * @brief Process-wide intern table mapping symbol names to dense SymbolIds.
+ *
+ * Lookups are lock-free (entries are published with a release store of the count
+ * and never change afterwards); only inserting a new symbol takes a mutex.
+ */
+class SymbolTable
+{
+public:
+    static SymbolTable& instance()
+    {
+        static SymbolTable inst;
+        return inst;
+    }
+
+    // Returns the id for 'name', adding it on first use; INVALID_SYMBOL_ID if the table is full or the name too long
+    SymbolId intern(const char* name, size_t len);
+    SymbolId intern(const char* name);
+
+    // Returns the id for 'name' or INVALID_SYMBOL_ID if it was never interned
+    SymbolId find(const char* name, size_t len) const;
+
+    // Name of an interned symbol ("?" for unknown ids)
+    const char* name(SymbolId id) const;
+
+    // Tick / lot scales; configure at startup, before the symbol trades
+    const InstrumentScale& scale(SymbolId id) const;
+    void setScale(SymbolId id, const InstrumentScale& scale);
+    void setDefaultScale(const InstrumentScale& scale) { defaultScale_ = scale; }
+    const InstrumentScale& defaultScale() const { return defaultScale_; }
+
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+
+private:
+    SymbolTable() = default;
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    SymbolId findIn(const char* name, size_t len, size_t count) const;
+
+    struct Entry
+    {
+        char name[MAX_SYMBOL_LENGTH + 1];
+        uint8_t length;
+        InstrumentScale scale;
+    };
+
+    Entry entries_[MAX_SYMBOLS] = {};
+    std::atomic<size_t> count_{0};
+    std::mutex insertMutex_;
+    InstrumentScale defaultScale_;
+};
+
+#endif // SYMBOL_TABLE_H
@@ -2,8 +2,23 @@
 #define SYSTEMCONTEXT_H
 
 #include "Types.h"
+#include "SimulatedExchange.h"
+#include "RiskGate.h"
+#include "TradeLog.h"
+#include "Portfolio.h"
+#include "MarkBoard.h"
+#include "Journal.h"
+#include "WindowCheckpoint.h"
+#include "TickRecorder.h"
+#include "Clock.h"
+#include "FeedSequencer.h"
+#include "BarAggregator.h"
+#include "MulticastFeed.h"
+#include "RuntimeConfig.h"
+#include "SpscRing.h"
 #include "../util/SafeQueue.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 
@@ -14,29 +29,65 @@ struct MarketDataContext {
     std::condition_variable cv;
 };
 
-// Encapsulates trade signal queue and synchronization components
+// Encapsulates trade signal queue and synchronization components.
+// One signalling thread (the strategy engine) and one executor thread: the hand-off is a
+// lock-free ring, and the mutex/cv are only taken when the executor is about to sleep.
 struct ActionSignalContext {
-    SafeQueue<ActionSignal> queue;
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+    SpscRing<ActionSignal> queue{QUEUE_CAPACITY};
     std::mutex mutex;
     std::condition_variable cv;
+    std::atomic<bool> waiting{false};   // The executor is waiting on cv, or about to
+
+    // Producer, after a push or a new mark: wakes the executor only if it waits.
+    // Pairs with the fence in the executor's wait: one side always sees the other's store
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_one();
+        }
+    }
 };
 
 // Encapsulates global system state (running/exception flags)
 struct SystemState {
     std::atomic<bool> runningFlag{true};
     std::atomic<bool> brokenFlag{false};
+    std::atomic<bool> feedFinished{false};   // Replay source exhausted
     std::mutex brokenMutex;
     std::condition_variable brokenCV;
 };
 
 // Global context (aggregates all core synchronization components)
 struct SystemContext {
+    // Chosen before the engine and executor are constructed; they keep a reference
+    std::unique_ptr<IClock> clock = std::make_unique<RealClock>();
     MarketDataContext marketData;
     ActionSignalContext actionSignal;
     SystemState state;
-    uint32_t maxHistory;
-    uint32_t minHistory;
+    MarkBoard marks;                // Latest tick per symbol, feed -> executor
+    Portfolio portfolio;            // Written by the executor, snapshot-read by everyone else
+    RiskGate risk;                  // Pre-trade checks between strategy and executor
+    TradeLog signalLog;             // Emitted signals, queued by the strategy thread
+    TradeLog executionLog;          // Signals received and orders, queued by the executor
+    Journal journal;                // Write-ahead log of the executor's signals, orders and fills
+    WindowCheckpoint checkpoint;    // Warm-start copy of the strategy engine's price windows
+    TickRecorder recorder;          // Binary log of every received tick, written off the feed thread
+    BarAggregator bars;             // OHLCV series built from every tick on the feed thread
+    RuntimeConfigStore config;      // Reloadable parameters (history, trade size, throttles, risk limits)
     double initialCash;
+    LiquidityConfig liquidity;      // Synthetic depth of the simulated exchange
+    PriceTicks slippageTicks = 5;   // Limit offset of executor orders from the signal price
+    uint32_t orderPoolSize = 8192;  // Orders preallocated for in-flight bursts
+    uint32_t orderPoolMax = 65536;  // Hard cap; the pool grows by slabs up to this
+    FeedSequencerConfig feedSequencing;   // Gap recovery of the live feed
+    bool feedConflation = false;    // Latest tick per symbol to a separate strategy thread, if the strategy allows
+    bool feedBatch = false;         // Drain and parse all received messages before processing them
+    bool feedBatchPerTick = false;  // Batch mode: evaluate per tick rather than once per symbol
+    bool feedMulticast = false;     // UDP multicast feed instead of the TCP listener
+    MulticastFeedConfig multicastFeed;
+    bool ioUring = false;           // io_uring for feed receives, journal commits and tick log blocks
 };
 
 #endif // SYSTEMCONTEXT_H
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "Telemetry.h"
+#include <chrono>
+#include <cstring>
+#include <new>
+#include "pch.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <process.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+uint64_t EpochMs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void CopyName(char (&dest)[TELEMETRY_NAME_LENGTH], const char* name)
+{
+    std::strncpy(dest, name, TELEMETRY_NAME_LENGTH - 1);
+    dest[TELEMETRY_NAME_LENGTH - 1] = '\0';
+}
+
+const char* QUEUE_NAMES[] = {"signal", "journal", "recorder"};
+static_assert(sizeof(QUEUE_NAMES) / sizeof(QUEUE_NAMES[0]) == static_cast<size_t>(TelemetryQueue::COUNT),
+              "One name per TelemetryQueue");
+
+} // namespace
+
+bool TelemetryPublisher::map()
+{
+#ifdef _WIN32
+    // Same name without the POSIX leading slash, in the session namespace
+    std::string name = config_.name;
+    if (!name.empty() && name[0] == '/') {
+        name = "Local\\" + name.substr(1);
+    }
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                        static_cast<DWORD>(sizeof(TelemetryPage)), name.c_str());
+    if (mapping == nullptr) {
+        return false;
+    }
+    void* address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(TelemetryPage));
+    if (address == nullptr) {
+        CloseHandle(mapping);
+        return false;
+    }
+    mapping_ = mapping;
+#else
+    const int fd = shm_open(config_.name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    // Recreated at this size even if a previous run left a segment of another version behind
+    if (ftruncate(fd, 0) != 0 || ftruncate(fd, sizeof(TelemetryPage)) != 0) {
+        close(fd);
+        return false;
+    }
+    void* address = mmap(nullptr, sizeof(TelemetryPage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+#endif
+    page_ = new (address) TelemetryPage();
+    return true;
+}
+
+void TelemetryPublisher::unmap()
+{
+    if (page_ == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(page_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    mapping_ = nullptr;
+#else
+    munmap(page_, sizeof(TelemetryPage));
+    shm_unlink(config_.name.c_str());
+#endif
+    page_ = nullptr;
+}
+
+bool TelemetryPublisher::start(StateReader readState)
+{
+    if (!config_.enabled || running_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (!map()) {
+        return false;
+    }
+    readState_ = std::move(readState);
+    startedMs_ = EpochMs();
+
+    TelemetryHeader& header = page_->header;
+    header.version = TELEMETRY_VERSION;
+    header.pageSize = static_cast<uint32_t>(sizeof(TelemetryPage));
+#ifdef _WIN32
+    header.pid = static_cast<uint32_t>(_getpid());
+#else
+    header.pid = static_cast<uint32_t>(getpid());
+#endif
+    header.counterCount = static_cast<uint32_t>(MetricCounter::COUNT);
+    header.latencyCount = static_cast<uint32_t>(MetricLatency::COUNT);
+    header.queueCount = static_cast<uint32_t>(TelemetryQueue::COUNT);
+    header.intervalMs = config_.intervalMs;
+    header.startedMs = startedMs_;
+    for (size_t i = 0; i < static_cast<size_t>(MetricCounter::COUNT); ++i) {
+        CopyName(header.counterNames[i], Metrics::counterName(static_cast<MetricCounter>(i)));
+    }
+    for (size_t i = 0; i < static_cast<size_t>(MetricLatency::COUNT); ++i) {
+        CopyName(header.latencyNames[i], Metrics::latencyName(static_cast<MetricLatency>(i)));
+    }
+    for (size_t i = 0; i < static_cast<size_t>(TelemetryQueue::COUNT); ++i) {
+        CopyName(header.queueNames[i], QUEUE_NAMES[i]);
+    }
+    publish(true);
+    header.magic.store(TELEMETRY_MAGIC, std::memory_order_release);
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&TelemetryPublisher::run, this);
+    LOG(Main) << "Telemetry: publishing to shared memory " << config_.name << " every " << config_.intervalMs << " ms";
+    return true;
+}
+
+void TelemetryPublisher::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (page_ != nullptr) {
+        publish(false);
+        unmap();
+    }
+}
+
+void TelemetryPublisher::run()
+{
+    const auto interval = std::chrono::milliseconds(config_.intervalMs > 0 ? config_.intervalMs : 100);
+    auto next = std::chrono::steady_clock::now() + interval;
+    while (running_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_until(next);
+        next += interval;
+        publish(true);
+    }
+}
+
+void TelemetryPublisher::publish(bool running)
+{
+    // Everything is gathered before the write section, which is only the copy
+    TelemetryData data{};
+    const MetricsSnapshot snap = Metrics::instance().snapshot();
+    data.publishedMs = EpochMs();
+    data.uptimeMs = data.publishedMs - startedMs_;
+    data.running = running ? 1 : 0;
+    for (size_t i = 0; i < static_cast<size_t>(MetricCounter::COUNT); ++i) {
+        data.counters[i] = snap.counters[i];
+    }
+    for (size_t i = 0; i < static_cast<size_t>(MetricLatency::COUNT); ++i) {
+        const LatencySummary& summary = snap.latencies[i];
+        TelemetryLatency& latency = data.latencies[i];
+        latency.count = summary.count;
+        latency.meanNs = summary.count > 0 ? summary.sumNs / summary.count : 0;
+        latency.p50Ns = summary.quantileNs(0.50);
+        latency.p90Ns = summary.quantileNs(0.90);
+        latency.p99Ns = summary.quantileNs(0.99);
+        latency.p999Ns = summary.quantileNs(0.999);
+        latency.maxNs = summary.quantileNs(1.0);
+    }
+    if (readState_) {
+        readState_(data);
+    }
+
+    TelemetryData& shared = page_->data.beginWrite();
+    shared = data;
+    page_->data.endWrite();
+}
@@ -0,0 +1,144 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include "Metrics.h"
+#include "SeqLock.h"
+
+constexpr uint32_t TELEMETRY_MAGIC = 0x4D545354;   // "TSTM" little-endian
+constexpr uint32_t TELEMETRY_VERSION = 1;
+constexpr size_t TELEMETRY_MAX_COUNTERS = 16;
+constexpr size_t TELEMETRY_MAX_LATENCIES = 8;
+constexpr size_t TELEMETRY_MAX_QUEUES = 8;
+constexpr size_t TELEMETRY_NAME_LENGTH = 32;
+
+enum class TelemetryQueue : uint8_t
+{
+    SIGNAL,               // Strategy -> executor
+    JOURNAL,              // Executor -> journal I/O thread
+    RECORDER,             // Feed -> tick recorder
+    COUNT
+};
+
+struct TelemetryLatency
+{
+    uint64_t count;
+    uint64_t meanNs;
+    uint64_t p50Ns;       // Quantiles are log2 bucket upper bounds (Metrics.h)
+    uint64_t p90Ns;
+    uint64_t p99Ns;
+    uint64_t p999Ns;
+    uint64_t maxNs;
+};
+
+// The seqlock-protected part, rewritten on every publish; every field is 8 bytes
+struct TelemetryData
+{
+    uint64_t publishedMs;                               // Wall clock, epoch ms
+    uint64_t uptimeMs;
+    uint64_t running;                                   // 0 once the engine has shut down
+    uint64_t counters[TELEMETRY_MAX_COUNTERS];          // Indexed by MetricCounter
+    int64_t queueDepths[TELEMETRY_MAX_QUEUES];          // Indexed by TelemetryQueue
+    uint64_t recorderDropped;
+    TelemetryLatency latencies[TELEMETRY_MAX_LATENCIES]; // Indexed by MetricLatency
+    uint64_t totalTrades;
+    uint64_t buyTrades;
+    uint64_t sellTrades;
+    double equity;                                      // Base currency
+    double realizedPnl;
+    double unrealizedPnl;
+    double maxDrawdown;
+};
+
+// Written once at startup, before magic is set
+struct TelemetryHeader
+{
+    std::atomic<uint32_t> magic;       // TELEMETRY_MAGIC once the page is ready
+    uint32_t version;
+    uint32_t pageSize;
+    uint32_t pid;
+    uint32_t counterCount;
+    uint32_t latencyCount;
+    uint32_t queueCount;
+    uint32_t intervalMs;
+    uint64_t startedMs;
+    char counterNames[TELEMETRY_MAX_COUNTERS][TELEMETRY_NAME_LENGTH];
+    char latencyNames[TELEMETRY_MAX_LATENCIES][TELEMETRY_NAME_LENGTH];
+    char queueNames[TELEMETRY_MAX_QUEUES][TELEMETRY_NAME_LENGTH];
+};
+
+/**
+ * @struct TelemetryPage
+ * @brief Fixed layout of the shared-memory segment, for readers in any language.
+ *
+ * Offset 0: header, written once before 'magic' is set; names let a reader map the
+ * indexed arrays without compiling against this header. Offset 4096: the SeqLock's
+ * 8-byte sequence (odd while a write is in progress), TelemetryData right after it at
+ * 4104. A reader copies the data and retries until the sequence is even and unchanged.
+ */
+struct TelemetryPage
+{
+    TelemetryHeader header;
+    alignas(4096) SeqLock<TelemetryData> data;
+};
+
+static_assert(sizeof(TelemetryHeader) <= 4096, "Telemetry header must fit its page");
+static_assert(static_cast<size_t>(MetricCounter::COUNT) <= TELEMETRY_MAX_COUNTERS, "Telemetry counter slots");
+static_assert(static_cast<size_t>(MetricLatency::COUNT) <= TELEMETRY_MAX_LATENCIES, "Telemetry latency slots");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Seqlock in shared memory needs lock-free atomics");
+
+struct TelemetryConfig
+{
+    bool enabled = false;
+    std::string name = "/trading_telemetry";   // shm_open name; "Local\\..." mapping on Windows
+    uint32_t intervalMs = 100;
+};
+
+/**
+ * @class TelemetryPublisher
+ * @brief Publishes metrics and engine state into a named shared-memory page.
+ *
+ * A background thread aggregates Metrics::snapshot(), asks the owner for queue depths
+ * and trade stats, and rewrites the page under its seqlock every interval. Samplers map
+ * the segment read-only and poll it at any rate without a syscall into the engine.
+ * The segment is removed on stop(); readers that still have it mapped see running = 0.
+ */
+class TelemetryPublisher
+{
+public:
+    // Fills queueDepths, recorderDropped and the trade stats
+    using StateReader = std::function<void(TelemetryData&)>;
+
+    TelemetryPublisher() = default;
+    ~TelemetryPublisher() { stop(); }
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+
+    void configure(const TelemetryConfig& config) { config_ = config; }
+    bool enabled() const { return config_.enabled; }
+
+    bool start(StateReader readState);
+    void stop();
+
+    uint64_t publishes() const { return page_ ? page_->data.version() : 0; }
+
+private:
+    void run();
+    void publish(bool running);
+    bool map();
+    void unmap();
+
+    TelemetryConfig config_;
+    StateReader readState_;
+    TelemetryPage* page_ = nullptr;
+    void* mapping_ = nullptr;        // Windows file mapping handle
+    uint64_t startedMs_ = 0;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,133 @@
+"""Reader for the engine's shared-memory telemetry page (src/Telemetry.h).
+
+Maps the segment read-only and copies the data under the seqlock; no syscalls into
+the engine. Importable by samplers such as the performance monitor:
+
+    reader = TelemetryReader()
+    sample = reader.read()      # dict, or None until the engine has published
+
+or run directly to print one line per interval.
+"""
+import argparse
+import json
+import mmap
+import os
+import struct
+import time
+
+MAGIC = 0x4D545354
+VERSION = 1
+NAME_LENGTH = 32
+MAX_COUNTERS = 16
+MAX_LATENCIES = 8
+MAX_QUEUES = 8
+
+HEADER = struct.Struct("<8IQ")
+SEQUENCE_OFFSET = 4096
+DATA_OFFSET = SEQUENCE_OFFSET + 8
+LATENCY_FIELDS = ("count", "mean_ns", "p50_ns", "p90_ns", "p99_ns", "p999_ns", "max_ns")
+DATA = struct.Struct("<3Q%dQ%dqQ%dQ3Q4d" % (MAX_COUNTERS, MAX_QUEUES, MAX_LATENCIES * len(LATENCY_FIELDS)))
+
+
+class TelemetryReader:
+    def __init__(self, name="/trading_telemetry"):
+        if os.name == "nt":
+            self._map = mmap.mmap(-1, SEQUENCE_OFFSET + 4096, tagname="Local\\" + name.lstrip("/"),
+                                  access=mmap.ACCESS_READ)
+        else:
+            with open("/dev/shm/" + name.lstrip("/"), "rb") as f:
+                self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        self._names = None
+
+    def _read_names(self):
+        fields = HEADER.unpack_from(self._map, 0)
+        magic, version, _, pid, counters, latencies, queues = fields[:7]
+        if magic != MAGIC:
+            return False
+        if version != VERSION:
+            raise RuntimeError("telemetry page version %d, reader supports %d" % (version, VERSION))
+
+        def names(offset, count):
+            out = []
+            for i in range(count):
+                raw = self._map[offset + i * NAME_LENGTH:offset + (i + 1) * NAME_LENGTH]
+                out.append(raw.split(b"\0", 1)[0].decode())
+            return out
+
+        base = HEADER.size
+        self._names = {
+            "pid": pid,
+            "counters": names(base, counters),
+            "latencies": names(base + MAX_COUNTERS * NAME_LENGTH, latencies),
+            "queues": names(base + (MAX_COUNTERS + MAX_LATENCIES) * NAME_LENGTH, queues),
+        }
+        return True
+
+    def read(self):
+        if self._names is None and not self._read_names():
+            return None
+        while True:
+            before = struct.unpack_from("<Q", self._map, SEQUENCE_OFFSET)[0]
+            raw = self._map[DATA_OFFSET:DATA_OFFSET + DATA.size]
+            after = struct.unpack_from("<Q", self._map, SEQUENCE_OFFSET)[0]
+            if before % 2 == 0 and before == after:
+                break
+        values = DATA.unpack(raw)
+        published_ms, uptime_ms, running = values[0:3]
+        pos = 3
+        counters = values[pos:pos + MAX_COUNTERS]
+        pos += MAX_COUNTERS
+        queues = values[pos:pos + MAX_QUEUES]
+        pos += MAX_QUEUES
+        recorder_dropped = values[pos]
+        pos += 1
+        latencies = []
+        for i in range(MAX_LATENCIES):
+            latencies.append(dict(zip(LATENCY_FIELDS, values[pos:pos + len(LATENCY_FIELDS)])))
+            pos += len(LATENCY_FIELDS)
+        total, buys, sells, equity, realized, unrealized, max_drawdown = values[pos:pos + 7]
+
+        names = self._names
+        return {
+            "pid": names["pid"],
+            "published_ms": published_ms,
+            "uptime_ms": uptime_ms,
+            "running": bool(running),
+            "counters": dict(zip(names["counters"], counters)),
+            "queues": dict(zip(names["queues"], queues)),
+            "recorder_dropped": recorder_dropped,
+            "latencies": dict(zip(names["latencies"], latencies)),
+            "trades": {"total": total, "buy": buys, "sell": sells},
+            "pnl": {"equity": equity, "realized": realized, "unrealized": unrealized,
+                    "max_drawdown": max_drawdown},
+        }
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--name", type=str, default="/trading_telemetry")
+    parser.add_argument("--interval", type=float, default=1.0)
+    parser.add_argument("--once", action="store_true")
+    parser.add_argument("--json", action="store_true")
+    args = parser.parse_args()
+
+    reader = TelemetryReader(args.name)
+    while True:
+        sample = reader.read()
+        if sample is None:
+            print("waiting for the engine to publish...")
+        elif args.json:
+            print(json.dumps(sample))
+        else:
+            c = sample["counters"]
+            fill = sample["latencies"]["tick_to_fill"]
+            print("ticks %d signals %d fills %d | queues %s | tick->fill p50 %.1fus p99 %.1fus | equity %.2f"
+                  % (c["ticks_received"], c["signals"], c["fills"], sample["queues"],
+                     fill["p50_ns"] / 1e3, fill["p99_ns"] / 1e3, sample["pnl"]["equity"]))
+        if args.once or (sample is not None and not sample["running"]):
+            break
+        time.sleep(args.interval)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,269 @@
+#include "ThreadPlacement.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "pch.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+std::string FormatCpuList(const std::vector<int>& cpus)
+{
+    std::string out;
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        // Collapse runs: 0,1,2,3,6 -> 0-3,6
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+            ++j;
+        }
+        if (!out.empty()) {
+            out += ',';
+        }
+        out += std::to_string(cpus[i]);
+        if (j > i) {
+            out += '-' + std::to_string(cpus[j]);
+        }
+        i = j;
+    }
+    return out.empty() ? "-" : out;
+}
+
+// Cores removed from the general scheduler with isolcpus=; hot threads belong there
+std::vector<int> IsolatedCpus()
+{
+#ifdef __linux__
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    std::string list;
+    std::getline(file, list);
+    return ThreadPlacement::parseCpuList(list);
+#else
+    return {};
+#endif
+}
+
+} // namespace
+
+const char* threadRoleToString(ThreadRole role)
+{
+    switch (role) {
+        case ThreadRole::MAIN:     return "main";
+        case ThreadRole::STRATEGY: return "strategy";
+        case ThreadRole::INGEST:   return "ingest";
+        case ThreadRole::EXECUTOR: return "executor";
+        case ThreadRole::JOURNAL:  return "journal";
+        case ThreadRole::RECORDER: return "recorder";
+        default:                   return "unknown";
+    }
+}
+
+std::vector<int> ThreadPlacement::parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int first = 0;
+        int last = 0;
+        const int fields = std::sscanf(item.c_str(), "%d-%d", &first, &last);
+        if (fields < 1 || first < 0) {
+            continue;
+        }
+        if (fields == 1) {
+            last = first;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+ThreadPlacement::ThreadPlacement()
+{
+    // First used on the main thread during startup, before apply() has changed anything
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                processCpus_.push_back(cpu);
+            }
+        }
+    }
+#elif defined(_WIN32)
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        for (int cpu = 0; cpu < static_cast<int>(sizeof(DWORD_PTR) * 8); ++cpu) {
+            if (processMask & (DWORD_PTR(1) << cpu)) {
+                processCpus_.push_back(cpu);
+            }
+        }
+    }
+#endif
+}
+
+void ThreadPlacement::configure(ThreadRole role, const ThreadPlacementConfig& config)
+{
+    configs_[static_cast<size_t>(role)] = config;
+}
+
+void ThreadPlacement::apply(ThreadRole role)
+{
+    const size_t index = static_cast<size_t>(role);
+    const ThreadPlacementConfig& config = configs_[index];
+    Result& result = results_[index];
+    const std::string name = std::string("ts-") + threadRoleToString(role);
+
+#if defined(__linux__)
+    result.tid = static_cast<long>(syscall(SYS_gettid));
+    // The main thread keeps the process name, which is what ps/top show for the process
+    if (role != ThreadRole::MAIN) {
+        pthread_setname_np(pthread_self(), name.c_str());
+    }
+
+    // Unconfigured roles go back to the process's CPUs and policy: a thread created by a
+    // pinned SCHED_FIFO thread (the conflated strategy thread) would otherwise share its core
+    const std::vector<int>& wanted = config.cpus.empty() ? processCpus_ : config.cpus;
+    if (!wanted.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : wanted) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (rc != 0) {
+            result.error += std::string("affinity: ") + std::strerror(rc) + "; ";
+        }
+    }
+    {
+        const int policy = config.fifoPriority > 0 ? SCHED_FIFO : SCHED_OTHER;
+        sched_param param{};
+        param.sched_priority = (policy == SCHED_FIFO) ? config.fifoPriority : 0;
+        const int rc = pthread_setschedparam(pthread_self(), policy, &param);
+        if (rc != 0) {
+            result.error += std::string(policy == SCHED_FIFO ? "SCHED_FIFO: " : "SCHED_OTHER: ") +
+                            std::strerror(rc) + "; ";
+        }
+    }
+
+    // Report what the kernel actually applied, not what was asked for
+    cpu_set_t effective;
+    CPU_ZERO(&effective);
+    std::vector<int> cpus;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(effective), &effective) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &effective)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    result.cpus = FormatCpuList(cpus);
+    int policy = 0;
+    sched_param param{};
+    pthread_getschedparam(pthread_self(), &policy, &param);
+    result.policy = (policy == SCHED_FIFO) ? "SCHED_FIFO " + std::to_string(param.sched_priority) : "SCHED_OTHER";
+#elif defined(_WIN32)
+    result.tid = static_cast<long>(GetCurrentThreadId());
+    const std::vector<int>& wanted = config.cpus.empty() ? processCpus_ : config.cpus;
+    if (!wanted.empty()) {
+        DWORD_PTR mask = 0;
+        for (int cpu : wanted) {
+            if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+                mask |= DWORD_PTR(1) << cpu;
+            }
+        }
+        if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+            result.error += "affinity failed; ";
+        }
+    }
+    if (!SetThreadPriority(GetCurrentThread(),
+                           config.fifoPriority > 0 ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_NORMAL)) {
+        result.error += "priority failed; ";
+    }
+    result.cpus = FormatCpuList(wanted);
+    result.policy = config.fifoPriority > 0 ? "TIME_CRITICAL" : "NORMAL";
+#else
+    result.cpus = "-";
+    result.policy = "default";
+    if (!config.cpus.empty() || config.fifoPriority > 0) {
+        result.error = "placement not supported on this platform; ";
+    }
+#endif
+    if (result.error.size() >= 2) {
+        result.error.resize(result.error.size() - 2);    // Trailing "; "
+    }
+
+    applied_.fetch_or(1u << index, std::memory_order_release);
+}
+
+void ThreadPlacement::logReport(uint32_t expected, std::chrono::milliseconds timeout) const
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while ((applied_.load(std::memory_order_acquire) & expected) != expected &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const std::vector<int> isolated = IsolatedCpus();
+    LOG(Main) << "Thread placement (" << std::thread::hardware_concurrency() << " CPUs, isolated "
+              << FormatCpuList(isolated) << "):";
+    const uint32_t applied = applied_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < static_cast<size_t>(ThreadRole::COUNT); ++i) {
+        if ((expected & (1u << i)) == 0) {
+            continue;
+        }
+        const ThreadRole role = static_cast<ThreadRole>(i);
+        const ThreadPlacementConfig& config = configs_[i];
+        if ((applied & (1u << i)) == 0) {
+            LOG(WARN) << "  " << threadRoleToString(role) << ": thread has not started";
+            continue;
+        }
+        const Result& result = results_[i];
+
+        // A pinned hot thread on a core the scheduler also uses still gets preempted
+        bool onIsolated = !config.cpus.empty() && !isolated.empty();
+        for (int cpu : config.cpus) {
+            bool found = false;
+            for (int iso : isolated) {
+                found = found || iso == cpu;
+            }
+            onIsolated = onIsolated && found;
+        }
+        LOG(Main) << "  " << threadRoleToString(role) << ": tid " << result.tid
+                  << ", cpus " << result.cpus << (config.cpus.empty() ? " (not pinned)" : "")
+                  << (onIsolated ? " [isolated]" : "") << ", " << result.policy;
+        if (!result.error.empty()) {
+            LOG(WARN) << "  " << threadRoleToString(role) << ": " << result.error;
+        }
+        for (int cpu : config.cpus) {
+            if (cpu >= static_cast<int>(std::thread::hardware_concurrency())) {
+                LOG(WARN) << "  " << threadRoleToString(role) << ": CPU " << cpu << " does not exist";
+            }
+        }
+    }
+
+    // The strategy and executor threads spin; two of them on one core halve each other
+    const ThreadPlacementConfig& strategy = configs_[static_cast<size_t>(ThreadRole::STRATEGY)];
+    const ThreadPlacementConfig& executor = configs_[static_cast<size_t>(ThreadRole::EXECUTOR)];
+    for (int cpu : strategy.cpus) {
+        for (int other : executor.cpus) {
+            if (cpu == other) {
+                LOG(WARN) << "  strategy and executor threads share CPU " << cpu;
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef THREAD_PLACEMENT_H
+#define THREAD_PLACEMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class ThreadRole : uint8_t
+{
+    MAIN,        // Startup/monitor thread; the logger and unconfigured helpers inherit its CPUs
+    STRATEGY,    // Strategies; also socket ingest and parsing unless the feed is conflated
+    INGEST,      // Socket ingest and parsing when FEED_CONFLATION splits it off the strategy thread
+    EXECUTOR,
+    JOURNAL,
+    RECORDER,
+    COUNT
+};
+
+const char* threadRoleToString(ThreadRole role);
+
+struct ThreadPlacementConfig
+{
+    std::vector<int> cpus;       // Empty: not pinned
+    int fifoPriority = 0;        // 1-99: SCHED_FIFO at this priority; 0: default policy
+};
+
+/**
+ * @class ThreadPlacement
+ * @brief Process-wide CPU affinity, real-time priority and naming of the worker threads.
+ *
+ * Each thread calls apply() with its role as the first thing it does, so the settings
+ * land on the thread itself and threads it creates later inherit them. A role with no
+ * CPUs or priority configured is reset to the process's startup affinity and the default
+ * policy, instead of keeping whatever its creating thread had. The outcome
+ * (effective CPUs, policy, errors such as a missing CAP_SYS_NICE) is kept per role
+ * for the startup report; failures never stop the thread.
+ */
+class ThreadPlacement
+{
+public:
+    static ThreadPlacement& instance()
+    {
+        static ThreadPlacement inst;
+        return inst;
+    }
+
+    // "2", "2,3", "4-7" or "" (not pinned)
+    static std::vector<int> parseCpuList(const std::string& list);
+
+    // Startup, before the threads start
+    void configure(ThreadRole role, const ThreadPlacementConfig& config);
+
+    // Called by the thread itself
+    void apply(ThreadRole role);
+
+    // Logs one line per role in 'expected' (bit per ThreadRole), waiting up to 'timeout'
+    // for those threads to have applied their placement
+    void logReport(uint32_t expected, std::chrono::milliseconds timeout) const;
+
+private:
+    ThreadPlacement();
+
+    struct Result
+    {
+        long tid = 0;
+        std::string cpus;        // Effective affinity read back from the kernel
+        std::string policy;
+        std::string error;
+    };
+
+    std::vector<int> processCpus_;   // Affinity at startup, before any role was placed
+    ThreadPlacementConfig configs_[static_cast<size_t>(ThreadRole::COUNT)];
+    Result results_[static_cast<size_t>(ThreadRole::COUNT)];
+    std::atomic<uint32_t> applied_{0};
+};
+
+#endif // THREAD_PLACEMENT_H
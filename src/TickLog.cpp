@@ -0,0 +1,390 @@
+#include "TickLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include "pch.h"
+
+#ifdef USE_ZSTD
+    #include <zstd.h>
+#endif
+
+namespace {
+
+constexpr char TICK_LOG_MAGIC[4] = {'T', 'S', 'R', '1'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint8_t BLOCK_COMPRESSED = 0x01;
+
+struct TickLogFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t reserved[2];
+};
+
+struct TickLogBlockHeader
+{
+    uint32_t storedBytes;     // Payload bytes on disk
+    uint32_t rawBytes;        // Payload bytes after decompression
+    uint32_t tickCount;
+    uint32_t checksum;        // CRC-32 of the stored payload
+    uint8_t flags;
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(TickLogBlockHeader) == 20, "Block header layout is part of the file format");
+
+uint64_t ZigZag(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+int64_t UnZigZag(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+void PutVarint(std::vector<unsigned char>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+bool GetVarint(const unsigned char*& p, const unsigned char* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const unsigned char byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// --- Writer ---
+
+bool TickLogWriter::writeBlockUring(const void* header, uint32_t headerBytes, const void* payload, uint32_t payloadBytes)
+{
+    const int fd = fileno(file_);
+    if (!uring_.write(fd, header, headerBytes, fileBytes_, 0, true) ||
+        !uring_.write(fd, payload, payloadBytes, fileBytes_ + headerBytes, 1) ||
+        !uring_.submit(2)) {
+        return false;
+    }
+    bool ok = true;
+    IoCompletion completion;
+    for (int i = 0; i < 2; ++i) {
+        if (!uring_.next(completion)) {
+            return false;
+        }
+        ok = ok && completion.result == static_cast<int32_t>(completion.userData == 0 ? headerBytes : payloadBytes);
+    }
+    return ok;
+}
+
+bool TickLogWriter::open(const TickLogConfig& config)
+{
+    close();
+    config_ = config;
+#ifndef USE_ZSTD
+    if (config_.compress) {
+        LOG(WARN) << "Tick log: built without USE_ZSTD, writing uncompressed blocks";
+        config_.compress = false;
+    }
+#endif
+    if (!FileUtils::MakeDirectory(config_.directory)) {
+        LOG(ERROR) << "Tick log: cannot create directory " << config_.directory;
+        return false;
+    }
+    if (config_.ioUring && !uring_.init(8)) {
+        LOG(WARN) << "Tick log: writing blocks through stdio";
+    }
+    records_.reserve(BLOCK_BYTES + 64);
+    block_.reserve(BLOCK_BYTES + 1024);
+    return openNextFile();
+}
+
+bool TickLogWriter::openNextFile()
+{
+    if (file_ != nullptr) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    const long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    char name[64];
+    std::snprintf(name, sizeof(name), "/ticks-%013lld-%04u.tsr", nowMs, filesOpened_);
+    const std::string path = config_.directory + name;
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        LOG(ERROR) << "Tick log: cannot create " << path;
+        return false;
+    }
+    TickLogFileHeader header{};
+    std::memcpy(header.magic, TICK_LOG_MAGIC, sizeof(TICK_LOG_MAGIC));
+    header.version = FORMAT_VERSION;
+    std::fwrite(&header, sizeof(header), 1, file_);
+    if (uring_.ready()) {
+        // Blocks go to the descriptor at explicit offsets from here on
+        std::fflush(file_);
+    }
+    fileBytes_ = sizeof(header);
+    bytes_ += sizeof(header);
+    ++filesOpened_;
+
+    filesWritten_.push_back(path);
+    if (config_.maxFiles > 0 && filesWritten_.size() > config_.maxFiles) {
+        std::remove(filesWritten_.front().c_str());
+        filesWritten_.erase(filesWritten_.begin());
+    }
+    return true;
+}
+
+void TickLogWriter::write(const TradeData& tick)
+{
+    if (file_ == nullptr || tick.symbol_ >= MAX_SYMBOLS) {
+        return;
+    }
+    const uint64_t bit = uint64_t(1) << tick.symbol_;
+    if ((blockSymbols_ & bit) == 0) {
+        blockSymbols_ |= bit;
+        lastPrice_[tick.symbol_] = 0;
+    }
+    const PriceTicks price = SymbolTable::instance().scale(tick.symbol_).toTicks(tick.price_);
+
+    PutVarint(records_, tick.symbol_);
+    PutVarint(records_, ZigZag(tick.timestamp_ms_ - lastTimestamp_));
+    PutVarint(records_, ZigZag(price - lastPrice_[tick.symbol_]));
+    lastTimestamp_ = tick.timestamp_ms_;
+    lastPrice_[tick.symbol_] = price;
+    ++blockTicks_;
+    ++ticks_;
+
+    if (records_.size() >= BLOCK_BYTES) {
+        flush();
+    }
+}
+
+bool TickLogWriter::flush()
+{
+    if (file_ == nullptr || blockTicks_ == 0) {
+        return true;
+    }
+
+    // Dictionary of the symbols this block uses, then the tick records
+    block_.clear();
+    PutVarint(block_, static_cast<uint64_t>(__builtin_popcountll(blockSymbols_)));
+    for (uint64_t symbols = blockSymbols_; symbols != 0; symbols &= symbols - 1) {
+        const SymbolId id = static_cast<SymbolId>(__builtin_ctzll(symbols));
+        const char* name = SymbolTable::instance().name(id);
+        const size_t length = std::strlen(name);
+        PutVarint(block_, id);
+        block_.push_back(static_cast<unsigned char>(length));
+        block_.insert(block_.end(), name, name + length);
+        PutVarint(block_, static_cast<uint64_t>(SymbolTable::instance().scale(id).priceScale));
+    }
+    block_.insert(block_.end(), records_.begin(), records_.end());
+
+    TickLogBlockHeader header{};
+    header.rawBytes = static_cast<uint32_t>(block_.size());
+    header.tickCount = blockTicks_;
+    const unsigned char* payload = block_.data();
+    size_t payloadBytes = block_.size();
+#ifdef USE_ZSTD
+    if (config_.compress) {
+        stored_.resize(ZSTD_compressBound(block_.size()));
+        const size_t compressed = ZSTD_compress(stored_.data(), stored_.size(), block_.data(), block_.size(),
+                                                config_.compressionLevel);
+        if (!ZSTD_isError(compressed) && compressed < block_.size()) {
+            payload = stored_.data();
+            payloadBytes = compressed;
+            header.flags |= BLOCK_COMPRESSED;
+        }
+    }
+#endif
+    header.storedBytes = static_cast<uint32_t>(payloadBytes);
+    header.checksum = FileUtils::crc32(payload, payloadBytes);
+
+    const bool ok = uring_.ready()
+        ? writeBlockUring(&header, sizeof(header), payload, static_cast<uint32_t>(payloadBytes))
+        : std::fwrite(&header, sizeof(header), 1, file_) == 1 &&
+          std::fwrite(payload, 1, payloadBytes, file_) == payloadBytes &&
+          std::fflush(file_) == 0;
+    fileBytes_ += sizeof(header) + payloadBytes;
+    bytes_ += sizeof(header) + payloadBytes;
+
+    records_.clear();
+    blockTicks_ = 0;
+    blockSymbols_ = 0;
+    lastTimestamp_ = 0;
+
+    if (!ok) {
+        LOG(ERROR) << "Tick log: write failed";
+        return false;
+    }
+    return fileBytes_ < config_.rotateBytes || openNextFile();
+}
+
+void TickLogWriter::close()
+{
+    flush();
+    if (file_ != nullptr) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+// --- Reader ---
+
+bool TickLogReader::open(const std::string& path)
+{
+    files_.clear();
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path, ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == ".tsr") {
+                files_.push_back(entry.path().string());
+            }
+        }
+        // File names start with the creation time, so name order is recording order
+        std::sort(files_.begin(), files_.end());
+    } else {
+        files_.push_back(path);
+    }
+
+    remaining_ = 0;
+    for (fileIndex_ = 0; fileIndex_ < files_.size(); ++fileIndex_) {
+        if (openFile(fileIndex_)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TickLogReader::openFile(size_t index)
+{
+    TickLogFileHeader header{};
+    if (!file_.open(files_[index], true) || file_.size() < sizeof(header)) {
+        LOG(WARN) << "Tick log: cannot read " << files_[index];
+        return false;
+    }
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, TICK_LOG_MAGIC, sizeof(TICK_LOG_MAGIC)) != 0 || header.version != FORMAT_VERSION) {
+        LOG(WARN) << "Tick log: " << files_[index] << " is not a version " << FORMAT_VERSION << " tick log";
+        return false;
+    }
+    offset_ = sizeof(header);
+    return true;
+}
+
+bool TickLogReader::loadBlock()
+{
+    while (offset_ + sizeof(TickLogBlockHeader) <= file_.size()) {
+        TickLogBlockHeader header{};
+        std::memcpy(&header, file_.data() + offset_, sizeof(header));
+        const unsigned char* payload = reinterpret_cast<const unsigned char*>(file_.data()) + offset_ + sizeof(header);
+        if (header.storedBytes > file_.size() - offset_ - sizeof(header)) {
+            break;   // Torn tail of a file that was being written
+        }
+        offset_ += sizeof(header) + header.storedBytes;
+        if (FileUtils::crc32(payload, header.storedBytes) != header.checksum) {
+            ++corruptBlocks_;
+            continue;
+        }
+
+        // rawBytes is outside the checksum: it must agree with the payload before it bounds the decoder
+        if (header.flags & BLOCK_COMPRESSED) {
+#ifdef USE_ZSTD
+            if (ZSTD_getFrameContentSize(payload, header.storedBytes) != header.rawBytes) {
+                ++corruptBlocks_;
+                continue;
+            }
+            block_.resize(header.rawBytes);
+            const size_t raw = ZSTD_decompress(block_.data(), block_.size(), payload, header.storedBytes);
+            if (ZSTD_isError(raw) || raw != header.rawBytes) {
+                ++corruptBlocks_;
+                continue;
+            }
+            cursor_ = block_.data();
+#else
+            LOG(ERROR) << "Tick log: compressed block needs a USE_ZSTD=1 build";
+            ++corruptBlocks_;
+            continue;
+#endif
+        } else {
+            if (header.rawBytes != header.storedBytes) {
+                ++corruptBlocks_;
+                continue;
+            }
+            cursor_ = payload;   // Zero copy: decode straight from the mapping
+        }
+        end_ = cursor_ + header.rawBytes;
+
+        blockSymbols_ = 0;
+        uint64_t count = 0;
+        bool ok = GetVarint(cursor_, end_, count);
+        for (uint64_t i = 0; ok && i < count; ++i) {
+            uint64_t id = 0;
+            uint64_t scale = 0;
+            ok = GetVarint(cursor_, end_, id) && id < MAX_SYMBOLS && cursor_ < end_;
+            if (!ok) {
+                break;
+            }
+            const size_t length = *cursor_++;
+            ok = length <= static_cast<size_t>(end_ - cursor_);
+            if (ok) {
+                symbolMap_[id] = SymbolTable::instance().intern(reinterpret_cast<const char*>(cursor_), length);
+                blockSymbols_ |= uint64_t(1) << id;
+                cursor_ += length;
+                ok = GetVarint(cursor_, end_, scale) && scale > 0;
+                priceScale_[id] = static_cast<double>(scale);
+                lastPrice_[id] = 0;
+            }
+        }
+        if (!ok) {
+            ++corruptBlocks_;
+            continue;
+        }
+        lastTimestamp_ = 0;
+        remaining_ = header.tickCount;
+        return true;
+    }
+    return false;
+}
+
+bool TickLogReader::Next(TradeData& tick)
+{
+    while (true) {
+        while (remaining_ == 0) {
+            if (loadBlock()) {
+                continue;
+            }
+            do {
+                if (++fileIndex_ >= files_.size()) {
+                    return false;
+                }
+            } while (!openFile(fileIndex_));
+        }
+
+        uint64_t id = 0;
+        uint64_t timeDelta = 0;
+        uint64_t priceDelta = 0;
+        if (!GetVarint(cursor_, end_, id) || id >= MAX_SYMBOLS || ((blockSymbols_ >> id) & 1) == 0 ||
+            !GetVarint(cursor_, end_, timeDelta) || !GetVarint(cursor_, end_, priceDelta)) {
+            ++corruptBlocks_;
+            remaining_ = 0;
+            continue;
+        }
+        --remaining_;
+        lastTimestamp_ += UnZigZag(timeDelta);
+        lastPrice_[id] += UnZigZag(priceDelta);
+        if (symbolMap_[id] == INVALID_SYMBOL_ID) {
+            continue;   // Symbol table full in this process
+        }
+        tick.symbol_ = symbolMap_[id];
+        tick.timestamp_ms_ = lastTimestamp_;
+        tick.price_ = static_cast<double>(lastPrice_[id]) / priceScale_[id];
+        return true;
+    }
+}
@@ -0,0 +1,125 @@
+#include "TickParser.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// Epoch values below this are treated as seconds (MarketFetch.py sends time.time())
+constexpr double SECONDS_EPOCH_LIMIT = 1e11;
+// Far above any traded price or epoch time; keeps the fixed-point and millisecond conversions in range
+constexpr double MAX_PRICE = 1e12;
+constexpr double MAX_TIMESTAMP = 1e15;
+
+const char* SkipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+} // namespace
+
+const char* TickParser::FindValue(const char* begin, const char* end, const char* key)
+{
+    const size_t keyLen = std::strlen(key);
+    const char* p = begin;
+    while (p < end) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+        if (quote == nullptr || quote + keyLen + 2 > end) {
+            return nullptr;
+        }
+        if (quote[keyLen + 1] == '"' && std::memcmp(quote + 1, key, keyLen) == 0) {
+            const char* value = SkipSpaces(quote + keyLen + 2, end);
+            if (value < end && *value == ':') {
+                return SkipSpaces(value + 1, end);
+            }
+        }
+        p = quote + 1;
+    }
+    return nullptr;
+}
+
+bool TickParser::ParseNumber(const char* begin, const char* end, double& value)
+{
+    if (begin == nullptr || begin >= end) {
+        return false;
+    }
+    auto result = std::from_chars(begin, end, value);
+    return result.ec == std::errc();
+}
+
+bool TickParser::ParseString(const char* begin, const char* end, const char*& strBegin, size_t& strLen)
+{
+    if (begin == nullptr || begin >= end || *begin != '"') {
+        return false;
+    }
+    const char* close = static_cast<const char*>(std::memchr(begin + 1, '"', end - begin - 1));
+    if (close == nullptr) {
+        return false;
+    }
+    strBegin = begin + 1;
+    strLen = static_cast<size_t>(close - strBegin);
+    return true;
+}
+
+bool TickParser::ValidPrice(double price)
+{
+    return std::isfinite(price) && price > 0.0 && price < MAX_PRICE;
+}
+
+bool TickParser::ValidTimestamp(double timestamp)
+{
+    return std::isfinite(timestamp) && timestamp >= 0.0 && timestamp < MAX_TIMESTAMP;
+}
+
+long long TickParser::ToEpochMs(double timestamp)
+{
+    return timestamp < SECONDS_EPOCH_LIMIT ? static_cast<long long>(timestamp * 1000.0)
+                                           : static_cast<long long>(timestamp);
+}
+
+bool TickParser::Parse(const char* data, size_t len, TradeData& out)
+{
+    const char* end = data + len;
+
+    double price = 0.0;
+    double timestamp = 0.0;
+    const char* symbol = nullptr;
+    size_t symbolLen = 0;
+
+    if (!ParseNumber(FindValue(data, end, "price"), end, price) || !ValidPrice(price) ||
+        !ParseNumber(FindValue(data, end, "timestamp"), end, timestamp) || !ValidTimestamp(timestamp) ||
+        !ParseString(FindValue(data, end, "symbol"), end, symbol, symbolLen))
+    {
+        return false;
+    }
+
+    // Optional; a malformed value is an error, an absent one is not. from_chars takes
+    // "nan" and "inf", so the range checks are written to fail for NaN
+    double seq = 0.0;
+    const char* seqValue = FindValue(data, end, "seq");
+    if (seqValue != nullptr && (!ParseNumber(seqValue, end, seq) || !(seq >= 0.0 && seq <= UINT32_MAX))) {
+        return false;
+    }
+    double volume = 0.0;
+    const char* volumeValue = FindValue(data, end, "volume");
+    if (volumeValue != nullptr && (!ParseNumber(volumeValue, end, volume) || !std::isfinite(volume) || volume < 0.0)) {
+        return false;
+    }
+
+    // Last: only a message that is otherwise valid may take a new symbol id
+    const SymbolId symbolId = SymbolTable::instance().intern(symbol, symbolLen);
+    if (symbolId == INVALID_SYMBOL_ID) {
+        return false;
+    }
+
+    out.price_ = price;
+    out.timestamp_ms_ = ToEpochMs(timestamp);
+    out.symbol_ = symbolId;
+    out.seq_ = static_cast<uint32_t>(seq);
+    out.volume_ = volume;
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef TICK_PARSER_H
+#define TICK_PARSER_H
+
+#include "Types.h"
+#include <cstddef>
+
+/**
+ * @class TickParser
+ * @brief Allocation-free parser for the flat JSON tick messages sent by MarketFetch.py.
+ *
+ * Message shape: {"symbol": "BTC", "price": 29847.52, "timestamp": 1692284400.123, "seq": 42, "volume": 0.5}
+ * "seq" (per-symbol feed sequence number) is optional; without it the tick is unsequenced.
+ * "volume" (traded quantity) is optional and defaults to 0.
+ * Values are read straight out of the receive buffer; no DOM is built.
+ * The symbol is interned into the process-wide SymbolTable, only once every other field
+ * has been validated: a rejected message never takes one of the MAX_SYMBOLS ids.
+ */
+class TickParser
+{
+public:
+    /**
+     * @brief Parses one message (without the trailing newline) into a TradeData.
+     * @return false if a required field is missing or malformed, or the symbol cannot be
+     * interned; out is left untouched then.
+     */
+    static bool Parse(const char* data, size_t len, TradeData& out);
+
+    /**
+     * @brief Locates the raw value of a top-level key.
+     * @return Pointer to the first character of the value, or nullptr if the key is absent.
+     */
+    static const char* FindValue(const char* begin, const char* end, const char* key);
+
+    // Parses a JSON number starting at 'begin'
+    static bool ParseNumber(const char* begin, const char* end, double& value);
+
+    // Feed timestamps are epoch seconds (MarketFetch.py sends time.time()) or milliseconds
+    static long long ToEpochMs(double timestamp);
+
+    // Field checks, shared with the CSV reader: a finite price above zero that fits fixed point,
+    // and a finite, non-negative epoch timestamp
+    static bool ValidPrice(double price);
+    static bool ValidTimestamp(double timestamp);
+
+    // Extracts a JSON string value (without quotes) starting at 'begin'
+    static bool ParseString(const char* begin, const char* end, const char*& strBegin, size_t& strLen);
+};
+
+#endif // TICK_PARSER_H
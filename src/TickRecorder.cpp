@@ -0,0 +1,63 @@
+#include "TickRecorder.h"
+#include <chrono>
+#include "ThreadPlacement.h"
+#include "pch.h"
+
+void TickRecorder::configure(const TickRecorderConfig& config)
+{
+    config_ = config;
+    ring_.reset();
+    if (config_.enabled) {
+        ring_ = std::make_unique<SpscRing<TradeData>>(config_.ringCapacity);
+    }
+}
+
+bool TickRecorder::start()
+{
+    if (!config_.enabled || running_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (!writer_.open(config_.log)) {
+        return false;
+    }
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&TickRecorder::run, this);
+    return true;
+}
+
+void TickRecorder::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void TickRecorder::run()
+{
+    ThreadPlacement::instance().apply(ThreadRole::RECORDER);
+
+    using Clock = std::chrono::steady_clock;
+    const auto flushInterval = std::chrono::milliseconds(config_.flushIntervalMs);
+    auto flushDeadline = Clock::now();
+    TradeData tick;
+
+    while (running_.load(std::memory_order_acquire) || !ring_->empty()) {
+        bool drained = false;
+        while (ring_->tryPop(tick)) {
+            // Full blocks are written by the writer; a partial one at most flushInterval after its first tick
+            if (!writer_.pending()) {
+                flushDeadline = Clock::now() + flushInterval;
+            }
+            writer_.write(tick);
+            drained = true;
+        }
+        if (writer_.pending() && Clock::now() >= flushDeadline) {
+            writer_.flush();
+        }
+        if (!drained) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    writer_.close();
+}
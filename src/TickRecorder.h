@@ -0,0 +1,64 @@
+#ifndef TICK_RECORDER_H
+#define TICK_RECORDER_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "SpscRing.h"
+#include "TickLog.h"
+
+struct TickRecorderConfig
+{
+    bool enabled = false;
+    TickLogConfig log;
+    size_t ringCapacity = 65536;       // Ticks buffered between the feed and the recorder thread
+    uint32_t flushIntervalMs = 1000;   // A partial block is written after this much idle time
+};
+
+/**
+ * @class TickRecorder
+ * @brief Records every received tick into a TickLogWriter from a background thread.
+ *
+ * tap() is the only call on the ingest path: one push into an SPSC ring. If the
+ * recorder falls behind, ticks are dropped and counted rather than slowing the feed.
+ */
+class TickRecorder
+{
+public:
+    TickRecorder() = default;
+    ~TickRecorder() { stop(); }
+    TickRecorder(const TickRecorder&) = delete;
+    TickRecorder& operator=(const TickRecorder&) = delete;
+
+    void configure(const TickRecorderConfig& config);
+    bool enabled() const { return config_.enabled; }
+
+    bool start();
+    void stop();   // Drains the tap, writes the last block and joins
+
+    // Feed thread
+    void tap(const TradeData& tick)
+    {
+        if (ring_ && !ring_->tryPush(tick)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t recorded() const { return writer_.ticks(); }
+    uint64_t bytes() const { return writer_.bytes(); }
+    uint32_t files() const { return writer_.files(); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    size_t pending() const { return ring_ ? ring_->size() : 0; }
+
+private:
+    void run();
+
+    TickRecorderConfig config_;
+    std::unique_ptr<SpscRing<TradeData>> ring_;
+    TickLogWriter writer_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+#endif // TICK_RECORDER_H
@@ -0,0 +1,20 @@
+#include "TickSource.h"
+#include "CsvTickSource.h"
+#include "TickLog.h"
+
+std::unique_ptr<ITickSource> OpenTickSource(const std::string& path)
+{
+    const bool csv = path.size() > 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    if (csv) {
+        auto source = std::make_unique<CsvTickSource>();
+        if (source->open(path)) {
+            return source;
+        }
+    } else {
+        auto source = std::make_unique<TickLogReader>();
+        if (source->open(path)) {
+            return source;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,27 @@
+#ifndef TICK_SOURCE_H
+#define TICK_SOURCE_H
+
+#include <memory>
+#include <string>
+#include "Types.h"
+
+/**
+ * @class ITickSource
+ * @brief Pull interface for recorded market data (replay and backtests).
+ *
+ * Ticks come out in recorded order with their symbol already interned into the
+ * process-wide SymbolTable.
+ */
+class ITickSource
+{
+public:
+    virtual ~ITickSource() = default;
+
+    // Returns false once the source is exhausted
+    virtual bool Next(TradeData& tick) = 0;
+};
+
+// A .csv file (CsvTickSource), otherwise a tick log file or directory (TickLogReader); nullptr if unreadable
+std::unique_ptr<ITickSource> OpenTickSource(const std::string& path);
+
+#endif // TICK_SOURCE_H
@@ -1,66 +1,169 @@
 #include "TradeExecutor.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include "Metrics.h"
+#include "ThreadPlacement.h"
 
 // Simplified constructor implementation
 TradeExecutor::TradeExecutor(SystemContext& ctx)
-    : initialFiatBalance_(ctx.initialCash), 
-      currentFiatBalance_(ctx.initialCash),
+    : portfolio_(ctx.portfolio),
+      marks_(ctx.marks),
       actionSignalCtx_(ctx.actionSignal),
-      systemState_(ctx.state)
+      systemState_(ctx.state),
+      risk_(ctx.risk),
+      executionLog_(ctx.executionLog),
+      journal_(ctx.journal),
+      clock_(*ctx.clock),
+      exchange_(ctx.liquidity),
+      orders_(ctx.orderPoolSize, ctx.orderPoolMax),
+      slippageTicks_(ctx.slippageTicks),
+      config_(ctx.config)
 {
+    exchange_.setFillHandler([this](SymbolId symbol, const BookFill& fill) { OnFill(symbol, fill); });
+    orders_.setFillHandler([this](const Order& order, PriceTicks price, QtyLots quantity) {
+        OnOrderFill(order, price, quantity);
+    });
+    orders_.setCancelHandler([this](const Order& order) {
+        return exchange_.cancel(order.symbol, order.venueHandle, order.id);
+    });
 }
 
-bool TradeExecutor::ExecuteBuyOrder(double price, double amount)
+void TradeExecutor::OnFill(SymbolId symbol, const BookFill& fill)
 {
-    if (currentFiatBalance_ >= price * amount)
+    // Route execution reports to our orders; the synthetic market maker (id 0) has none
+    const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+    if (fill.takerId != SimulatedExchange::LIQUIDITY_ORDER_ID) {
+        orders_.applyFill(fill.takerId, fill.price, fill.quantity, scale);
+    }
+    if (fill.makerId != SimulatedExchange::LIQUIDITY_ORDER_ID) {
+        orders_.applyFill(fill.makerId, fill.price, fill.quantity, scale);
+    }
+}
+
+void TradeExecutor::OnOrderFill(const Order& order, PriceTicks price, QtyLots quantity)
+{
+    // Balances change only here; the journal record is what recovery replays
+    MetricsShard& metrics = Metrics::local();
+    metrics.add(MetricCounter::FILLS);
+    metrics.record(MetricLatency::TICK_TO_FILL, elapsedSinceStampNs(currentTickStamp_));
+    JournalOrder(JournalRecordType::FILL, order, price, quantity);
+    portfolio_.applyFill(order.symbol, order.side, price, quantity);
+    risk_.onFill(order.symbol, order.side == OrderSide::BUY ? ActionType::BUY : ActionType::SELL, quantity);
+}
+
+TradeLogEntry TradeExecutor::OrderLogEntry(TradeEvent event, const Order& order) const
+{
+    TradeLogEntry entry{};
+    entry.event_ = event;
+    entry.orderId_ = order.id;
+    entry.price_ = order.price;
+    entry.quantity_ = order.quantity;
+    entry.filled_ = order.filled;
+    entry.notional_ = order.filledNotional;
+    entry.cash_ = portfolio_.cash(order.symbol);
+    entry.position_ = portfolio_.quantity(order.symbol);
+    entry.currency_ = portfolio_.currencyName(order.symbol);
+    entry.symbol_ = order.symbol;
+    entry.type_ = (order.side == OrderSide::BUY) ? ActionType::BUY : ActionType::SELL;
+    entry.state_ = order.state;
+    return entry;
+}
+
+bool TradeExecutor::SubmitOrder(Order& order, PriceTicks referencePrice)
+{
+    exchange_.updateReference(order.symbol, referencePrice);
+    orders_.transition(order, OrderState::PENDING_NEW);
+    BookResult result = exchange_.submit(order.symbol, order.id, order.side, order.type, order.price, order.quantity);
+    orders_.applySubmitResult(order, result);
+
+    const bool executed = order.filled > 0;
+    if (executed)
     {
-        currentFiatBalance_ -= price * amount;
-        cryptoAssetAmount_ += amount;
-        totalTrades_++;
-        totalBuyAction_++;
-        LOG(Execution) << "BUY order executed: " << amount << " BTC at $" << price
-                  << ". Current Cash: $" << std::fixed << std::setprecision(2) << currentFiatBalance_
-                  << ", BTC: " << cryptoAssetAmount_ ;
-        return true;
+        portfolio_.countTrade(order.side);
     }
-    else
+    executionLog_.push(OrderLogEntry(executed ? TradeEvent::ORDER_EXECUTED : TradeEvent::NO_LIQUIDITY, order));
+    JournalOrder(JournalRecordType::ORDER, order, order.price, order.quantity);
+    orders_.releaseIfDone(order);
+    return executed;
+}
+
+bool TradeExecutor::RejectOrder(Order& order)
+{
+    orders_.transition(order, OrderState::REJECTED);
+    JournalOrder(JournalRecordType::ORDER, order, order.price, order.quantity);
+    orders_.releaseIfDone(order);
+    return false;
+}
+
+bool TradeExecutor::ExecuteBuyOrder(SymbolId symbol, const InstrumentScale& scale, PriceTicks price, QtyLots amount)
+{
+    // Marketable limit order: the limit bounds slippage and the cash that can be spent
+    const PriceTicks limitPrice = price + slippageTicks_;
+    Order* order = orders_.create(symbol, OrderSide::BUY, OrderType::IOC, limitPrice, amount, clock_.nowMs());
+    if (order == nullptr)
     {
-        LOG(Execution) << "BUY failed: Insufficient cash. Needed: $" << price * amount
-                  << ", Have: $" << currentFiatBalance_ ;
+        TradeLogEntry entry{};
+        entry.event_ = TradeEvent::POOL_EXHAUSTED;
+        entry.liveOrders_ = static_cast<uint32_t>(orders_.liveOrders());
+        entry.symbol_ = symbol;
+        entry.type_ = ActionType::BUY;
+        executionLog_.push(entry);
         return false;
     }
+    Metrics::count(MetricCounter::ORDERS);
+
+    const CashUnits maxCost = scale.notional(limitPrice, amount);
+    const CashUnits available = portfolio_.cash(symbol);
+    if (available < maxCost)
+    {
+        TradeLogEntry entry = OrderLogEntry(TradeEvent::INSUFFICIENT_CASH, *order);
+        entry.notional_ = maxCost;
+        executionLog_.push(entry);
+        return RejectOrder(*order);
+    }
+    return SubmitOrder(*order, price);
 }
 
-bool TradeExecutor::ExecuteSellOrder(double price, double amount)
+bool TradeExecutor::ExecuteSellOrder(SymbolId symbol, PriceTicks price, QtyLots amount)
 {
-    if (cryptoAssetAmount_ >= amount)
+    const PriceTicks limitPrice = price - slippageTicks_;
+    Order* order = orders_.create(symbol, OrderSide::SELL, OrderType::IOC, limitPrice, amount, clock_.nowMs());
+    if (order == nullptr)
     {
-        currentFiatBalance_ += price * amount;
-        cryptoAssetAmount_ -= amount;
-        totalTrades_++;
-        totalSellAction_++;
-        LOG(Execution) << "SELL order executed: " << amount << " BTC at $" << price
-                  << ". Current Cash: $" << std::fixed << std::setprecision(2) << currentFiatBalance_
-                  << ", BTC: " << cryptoAssetAmount_ ;
-        return true;
+        TradeLogEntry entry{};
+        entry.event_ = TradeEvent::POOL_EXHAUSTED;
+        entry.liveOrders_ = static_cast<uint32_t>(orders_.liveOrders());
+        entry.symbol_ = symbol;
+        entry.type_ = ActionType::SELL;
+        executionLog_.push(entry);
+        return false;
     }
-    else
+    Metrics::count(MetricCounter::ORDERS);
+
+    const QtyLots held = portfolio_.quantity(symbol);
+    if (held < amount)
     {
-        LOG(Execution) << "SELL failed: Insufficient BTC. Needed: " << amount
-                  << ", Have: " << cryptoAssetAmount_ ;
-        return false;
+        executionLog_.push(OrderLogEntry(TradeEvent::INSUFFICIENT_POSITION, *order));
+        return RejectOrder(*order);
     }
+    return SubmitOrder(*order, price);
 }
 
-bool TradeExecutor::HandleActionSignal(ActionType action, double price, double amount)
+bool TradeExecutor::HandleActionSignal(ActionType action, SymbolId symbol, PriceTicks price, QtyLots amount)
 {
+    const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+    // A signal can precede the symbol's first mark: check and book against its quote currency
+    portfolio_.activate(symbol);
     bool success = false;
     if (action == ActionType::BUY)
     {
-        success = ExecuteBuyOrder(price, amount);
+        success = ExecuteBuyOrder(symbol, scale, price, amount);
     }
     else if (action == ActionType::SELL)
     {
-        success = ExecuteSellOrder(price, amount);
+        success = ExecuteSellOrder(symbol, price, amount);
     }
     else
     {
@@ -70,69 +173,348 @@ bool TradeExecutor::HandleActionSignal(ActionType action, double price, double a
     return success;
 }
 
-void TradeExecutor::DisplayPortfolioStatus(double currentPrice)
+void TradeExecutor::DisplayPortfolioStatus() const
 {
-    std::lock_guard<std::mutex> lock(tradeExecutorMutex_);
-    double totalValue = CalculateTotalPortfolioValue(currentPrice);
-    double profit = CalculateProfitLoss(currentPrice);
+    const PortfolioState state = portfolio_.snapshot();
+    uint32_t unconverted = 0;
+    const CashUnits totalValue = Portfolio::valueInBase(state, &unconverted);
+    const char* base = state.currencyNames[BASE_CURRENCY_ID];
+
     LOG(Execution) << "\n--- Portfolio Status ---" ;
-    LOG(Execution) << "Current Cash: $" << std::fixed << std::setprecision(2) << currentFiatBalance_ ;
-    LOG(Execution) << "BTC Amount: " << std::fixed << std::setprecision(5) << cryptoAssetAmount_ ;
-    LOG(Execution) << "Current BTC Price: $" << std::fixed << std::setprecision(2) << currentPrice ;
-    LOG(Execution) << "Total Value: $" << std::fixed << std::setprecision(2) << totalValue ;
-    LOG(Execution) << "Initial Capital: $" << std::fixed << std::setprecision(2) << initialFiatBalance_ ;
-    LOG(Execution) << "Profit/Loss: $" << std::fixed << std::setprecision(2) << profit ;
-    LOG(Execution) << "Total Trades: " << totalTrades_ ;
-    LOG(Execution) << "Total Buy Actions: " << totalBuyAction_ ;
-    LOG(Execution) << "Total Sell Actions: " << totalSellAction_ ;
+    for (CurrencyId id = 0; id < state.currencyCount; ++id)
+    {
+        LOG(Execution) << "Cash " << state.currencyNames[id] << ": " << std::fixed << std::setprecision(2)
+                       << fromCashUnits(state.cash[id]) ;
+    }
+    for (size_t i = 0; i < MAX_SYMBOLS; ++i)
+    {
+        const PortfolioPosition& position = state.positions[i];
+        if (!position.active)
+        {
+            continue;
+        }
+        const SymbolId symbol = static_cast<SymbolId>(i);
+        const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+        LOG(Execution) << SymbolTable::instance().name(symbol) << ": " << std::fixed << std::setprecision(5)
+                       << scale.fromLots(position.quantity) << " @ " << std::setprecision(2) << scale.fromTicks(position.mark)
+                       << " " << state.currencyNames[position.currency]
+                       << " (realized " << fromCashUnits(position.realizedPnl)
+                       << ", unrealized " << fromCashUnits(position.unrealizedPnl) << ")" ;
+    }
+    LOG(Execution) << "Total Value: " << std::fixed << std::setprecision(2) << fromCashUnits(totalValue) << " " << base
+                   << (unconverted != 0 ? " (excludes currencies without an FX rate)" : "") ;
+    LOG(Execution) << "Initial Capital: " << std::fixed << std::setprecision(2) << fromCashUnits(state.initialValue) << " " << base ;
+    LOG(Execution) << "Profit/Loss: " << std::fixed << std::setprecision(2) << fromCashUnits(state.pnl.equity - state.initialValue) << " " << base
+                   << " (realized " << fromCashUnits(state.pnl.realized) << ", unrealized " << fromCashUnits(state.pnl.unrealized) << ")" ;
+    LOG(Execution) << "High-Water Mark: " << std::fixed << std::setprecision(2) << fromCashUnits(state.pnl.highWaterMark)
+                   << ", Max Drawdown: " << fromCashUnits(state.pnl.maxDrawdown) ;
+    LOG(Execution) << "Exposure: gross " << std::fixed << std::setprecision(2) << fromCashUnits(state.pnl.grossExposure)
+                   << ", net " << fromCashUnits(state.pnl.netExposure) ;
+    LOG(Execution) << "Total Trades: " << state.totalTrades ;
+    LOG(Execution) << "Total Buy Actions: " << state.buyTrades ;
+    LOG(Execution) << "Total Sell Actions: " << state.sellTrades ;
     LOG(Execution) << "------------------------\n" ;
 }
 
-double TradeExecutor::CalculateTotalPortfolioValue(double currentPrice) const
+double TradeExecutor::CalculateTotalPortfolioValue() const
+{
+    return fromCashUnits(Portfolio::valueInBase(portfolio_.snapshot()));
+}
+
+double TradeExecutor::CalculateProfitLoss() const
+{
+    const PortfolioState state = portfolio_.snapshot();
+    return fromCashUnits(state.pnl.equity - state.initialValue);
+}
+
+void TradeExecutor::JournalSignal(const ActionSignal& signal)
+{
+    if (!journal_.enabled())
+    {
+        return;
+    }
+    JournalSymbol(signal.symbol_);
+    JournalRecord record{};
+    record.type = JournalRecordType::SIGNAL;
+    record.timestampMs = signal.timestamp_ms_;
+    record.symbol = signal.symbol_;
+    record.side = static_cast<uint8_t>(signal.type_);
+    record.price = signal.price_;
+    record.quantity = signal.amount_;
+    journal_.append(record);
+}
+
+void TradeExecutor::JournalOrder(JournalRecordType type, const Order& order, PriceTicks price, QtyLots quantity)
+{
+    if (!journal_.enabled())
+    {
+        return;
+    }
+    JournalSymbol(order.symbol);
+    JournalRecord record{};
+    record.type = type;
+    record.timestampMs = clock_.nowMs();
+    record.orderId = order.id;
+    record.symbol = order.symbol;
+    record.side = static_cast<uint8_t>(order.side);
+    record.state = static_cast<uint8_t>(order.state);
+    record.price = price;
+    record.quantity = quantity;
+    record.filled = order.filled;
+    journal_.append(record);
+}
+
+void TradeExecutor::JournalSymbol(SymbolId symbol)
+{
+    // Ids depend on feed arrival order: name each one before this run first journals it
+    static_assert(MAX_SYMBOLS <= 64, "One bit per SymbolId");
+    const uint64_t bit = uint64_t(1) << symbol;
+    if ((journaledSymbols_ & bit) != 0)
+    {
+        return;
+    }
+    journaledSymbols_ |= bit;
+    JournalRecord record{};
+    record.type = JournalRecordType::SYMBOL;
+    record.timestampMs = clock_.nowMs();
+    record.symbol = symbol;
+    setJournalSymbolName(record, SymbolTable::instance().name(symbol));
+    journal_.append(record);
+}
+
+void TradeExecutor::JournalSnapshot()
+{
+    const SymbolTable& symbols = SymbolTable::instance();
+    std::memset(snapshotImage_.symbolNames, 0, sizeof(snapshotImage_.symbolNames));
+    for (size_t id = 0; id < symbols.size() && id < MAX_SYMBOLS; ++id)
+    {
+        std::strncpy(snapshotImage_.symbolNames[id], symbols.name(static_cast<SymbolId>(id)), MAX_SYMBOL_LENGTH);
+    }
+    snapshotImage_.portfolio = portfolio_.writerView();
+    journal_.snapshot(&snapshotImage_, sizeof(snapshotImage_));
+}
+
+void TradeExecutor::RestoreSnapshot(const ExecutorSnapshot& snapshot)
+{
+    // Positions move from the writing run's ids to this run's, by name
+    PortfolioState& state = snapshotImage_.portfolio;
+    state = snapshot.portfolio;
+    for (PortfolioPosition& position : state.positions)
+    {
+        position = PortfolioPosition();
+    }
+    for (size_t id = 0; id < MAX_SYMBOLS; ++id)
+    {
+        char name[MAX_SYMBOL_LENGTH + 1];
+        std::memcpy(name, snapshot.symbolNames[id], sizeof(name));
+        name[MAX_SYMBOL_LENGTH] = '\0';
+        const SymbolId current = name[0] != '\0' ? SymbolTable::instance().intern(name) : INVALID_SYMBOL_ID;
+        journalSymbolMap_[id] = current;
+        if (current != INVALID_SYMBOL_ID)
+        {
+            state.positions[current] = snapshot.portfolio.positions[id];
+        }
+        else if (snapshot.portfolio.positions[id].active)
+        {
+            LOG(WARN) << "Recovery: snapshot position of unnamed symbol id " << id << " dropped";
+        }
+    }
+    portfolio_.restore(state);
+}
+
+void TradeExecutor::ApplyJournalRecord(const JournalRecord& record)
+{
+    if (record.symbol >= MAX_SYMBOLS)
+    {
+        return;
+    }
+    if (record.type == JournalRecordType::SYMBOL)
+    {
+        char name[MAX_SYMBOL_LENGTH + 1];
+        journalSymbolName(record, name);
+        journalSymbolMap_[record.symbol] = SymbolTable::instance().intern(name);
+        return;
+    }
+
+    // Fills carry the balances; terminal orders with executions carry the trade counts
+    const OrderSide side = static_cast<OrderSide>(record.side);
+    if (record.type == JournalRecordType::FILL)
+    {
+        const SymbolId symbol = journalSymbolMap_[record.symbol];
+        if (symbol == INVALID_SYMBOL_ID)
+        {
+            LOG(WARN) << "Recovery: fill at record " << record.sequence << " names no known symbol, skipped";
+            return;
+        }
+        portfolio_.applyFill(symbol, side, record.price, record.quantity);
+    }
+    else if (record.type == JournalRecordType::ORDER && record.filled > 0)
+    {
+        portfolio_.countTrade(side);
+    }
+}
+
+bool TradeExecutor::Recover()
+{
+    if (!journal_.enabled())
+    {
+        return true;
+    }
+    static_assert(sizeof(ExecutorSnapshot) <= Journal::MAX_SNAPSHOT_BYTES, "Portfolio snapshot does not fit the journal");
+
+    // Loaded into a copy: RestoreSnapshot() rebuilds snapshotImage_ from it
+    std::unique_ptr<ExecutorSnapshot> snapshot(new ExecutorSnapshot());
+    bool snapshotLoaded = false;
+    JournalRecoveryStats stats;
+    std::fill(std::begin(journalSymbolMap_), std::end(journalSymbolMap_), INVALID_SYMBOL_ID);
+    if (!journal_.open(snapshot.get(), sizeof(ExecutorSnapshot), snapshotLoaded))
+    {
+        return false;
+    }
+    if (snapshotLoaded)
+    {
+        RestoreSnapshot(*snapshot);
+    }
+    if (!journal_.replay([this](const JournalRecord& record) { ApplyJournalRecord(record); }, stats))
+    {
+        return false;
+    }
+
+    // The risk gate tracks positions on its own
+    const PortfolioState& state = portfolio_.writerView();
+    for (size_t i = 0; i < MAX_SYMBOLS; ++i)
+    {
+        const QtyLots quantity = state.positions[i].quantity;
+        if (quantity != 0)
+        {
+            risk_.onFill(static_cast<SymbolId>(i), quantity > 0 ? ActionType::BUY : ActionType::SELL, quantity > 0 ? quantity : -quantity);
+        }
+    }
+
+    LOG(Execution) << "Recovered portfolio: snapshot at record " << stats.snapshotSequence
+                   << ", replayed " << stats.replayed << " records in " << std::fixed << std::setprecision(1)
+                   << stats.milliseconds << " ms, equity " << std::setprecision(2) << fromCashUnits(state.pnl.equity) ;
+    return true;
+}
+
+void TradeExecutor::ApplyMarks()
 {
-    return currentFiatBalance_ + cryptoAssetAmount_ * currentPrice;
+    // O(1) per symbol that ticked since the last call
+    uint64_t dirty = marks_.take();
+    while (dirty != 0)
+    {
+        const SymbolId symbol = static_cast<SymbolId>(__builtin_ctzll(dirty));
+        dirty &= dirty - 1;
+        portfolio_.mark(symbol, marks_.price(symbol));
+    }
+    risk_.updateEquity(portfolio_.writerView().pnl.equity, clock_.nowMs());
+}
+
+bool TradeExecutor::DequeueSignal(ActionSignal& signal)
+{
+    return actionSignalCtx_.queue.tryPop(signal);
+}
+
+void TradeExecutor::ProcessSignal(const ActionSignal& signal)
+{
+    Metrics::count(MetricCounter::SIGNALS_PROCESSED);
+    currentTickStamp_ = signal.tickStamp_;
+    if (journal_.enabled() && journal_.failed())
+    {
+        // Nothing it does now could be recovered: stop trading and shut the system down
+        if (!systemState_.brokenFlag.exchange(true, std::memory_order_acq_rel))
+        {
+            LOG(ERROR) << "Journal failed, trading stopped";
+            systemState_.brokenCV.notify_all();
+        }
+        return;
+    }
+    JournalSignal(signal);
+    // Formatted and written by the monitor loop, off this thread
+    TradeLogEntry entry{};
+    entry.event_ = TradeEvent::SIGNAL_RECEIVED;
+    entry.price_ = signal.price_;
+    entry.quantity_ = signal.amount_;
+    entry.symbol_ = signal.symbol_;
+    entry.type_ = signal.type_;
+    executionLog_.push(entry);
+
+    HandleActionSignal(signal.type_, signal.symbol_, signal.price_, signal.amount_);
+    // Fills are already in the gate's position; release the working quantity
+    if (signal.type_ != ActionType::HOLD)
+    {
+        risk_.onOrderDone(signal.symbol_, signal.type_, signal.amount_);
+    }
+    if (journal_.enabled() && journal_.snapshotDue())
+    {
+        JournalSnapshot();
+    }
 }
 
-double TradeExecutor::CalculateProfitLoss(double currentPrice) const
+size_t TradeExecutor::Poll()
 {
-    return CalculateTotalPortfolioValue(currentPrice) - initialFiatBalance_;
+    // Same order as the loop: marks first, then every signal the tick produced
+    ApplyMarks();
+    size_t processed = 0;
+    ActionSignal signal;
+    while (DequeueSignal(signal))
+    {
+        ProcessSignal(signal);
+        ++processed;
+    }
+    return processed;
 }
 
 void TradeExecutor::RunTradeExecutionLoop()
 {
+    ThreadPlacement::instance().apply(ThreadRole::EXECUTOR);
     LOG(Execution) << " RunTradeExecutionLoop started." ;
     // Replaced with flag inside context
     while (systemState_.runningFlag.load(std::memory_order_acquire) &&
            !systemState_.brokenFlag.load(std::memory_order_acquire))
     {
-        ActionSignal receivedActionSignal;
+        bool hasSignal = !actionSignalCtx_.queue.empty();
+        if (!hasSignal && !marks_.pending())
         {
-            // Replaced with mutex/cv inside context
-            std::unique_lock<std::mutex> lock(actionSignalCtx_.mutex); 
-            if (!actionSignalCtx_.cv.wait_for(lock, std::chrono::seconds(2),
-                                    [this] { return !actionSignalCtx_.queue.empty(); }))
+            // Nothing queued: sleep until the engine pushes a signal or publishes a mark.
+            // 'waiting' is raised before the predicate is checked; see ActionSignalContext::notify
+            std::unique_lock<std::mutex> lock(actionSignalCtx_.mutex);
+            actionSignalCtx_.waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool woken = actionSignalCtx_.cv.wait_for(lock, std::chrono::seconds(2),
+                                    [this] { return !actionSignalCtx_.queue.empty() || marks_.pending(); });
+            actionSignalCtx_.waiting.store(false, std::memory_order_relaxed);
+            if (!woken)
             {
                 LOG(Execution) << "Timeout waiting for action signal, checking flags and continuing...";
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
                 continue; 
             }
-            receivedActionSignal = actionSignalCtx_.queue.dequeue();
-            LOG(Execution) << "Received action signal: Type="
-                      << (receivedActionSignal.type_ == ActionType::BUY ? "BUY" :
-                         (receivedActionSignal.type_ == ActionType::SELL ? "SELL" : "HOLD"))
-                      << ", Price=$" << std::fixed << std::setprecision(2) << receivedActionSignal.price_
-                      << ", Amount=" << receivedActionSignal.amount_ ;
+            hasSignal = !actionSignalCtx_.queue.empty();
         }
+
+        // Mark to market before acting, so checks and P&L see the latest prices
+        ApplyMarks();
+        ActionSignal receivedActionSignal;
+        if (!hasSignal || !DequeueSignal(receivedActionSignal))
         {
-            std::lock_guard<std::mutex> lock(tradeExecutorMutex_); 
-            currentPrice_ = receivedActionSignal.price_;
-            LOG(Execution) << " Processing action signal..." ;
-            HandleActionSignal(receivedActionSignal.type_, receivedActionSignal.price_, receivedActionSignal.amount_);
-            LOG(Execution) << " Action signal processed." ;
+            continue;
         }
+        ProcessSignal(receivedActionSignal);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        LOG(Execution) << "Loop iteration complete, sleeping briefly." ;
+        const uint32_t delayMs = config_.current().executorDelayMs;
+        if (delayMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        }
     }
+    Finish();
     LOG(Execution) << "RunTradeExecutionLoop finished." ;
-}
\ No newline at end of file
+}
+
+void TradeExecutor::Finish()
+{
+    if (journal_.enabled())
+    {
+        JournalSnapshot();
+    }
+}
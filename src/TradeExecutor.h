@@ -4,26 +4,59 @@
 #include "pch.h"
 #include <iomanip>
 #include "SystemContext.h" 
+#include "OrderManager.h"
 
 constexpr double DEFAULT_CASH = 10000.0; 
 
+// Journal snapshot: the portfolio, plus the names of the SymbolIds it is indexed by
+struct ExecutorSnapshot
+{
+    char symbolNames[MAX_SYMBOLS][MAX_SYMBOL_LENGTH + 1];   // "" = id not in use
+    PortfolioState portfolio;
+};
+
 class TradeExecutor
 {
 private:
-    const double initialFiatBalance_;
-    double currentFiatBalance_;
-    double cryptoAssetAmount_ = 0.0;
-    uint32_t totalTrades_ = 0;
-    uint32_t totalBuyAction_ = 0; 
-    uint32_t totalSellAction_ = 0;
-    std::mutex tradeExecutorMutex_;
+    // Accounting is fixed point; this thread is the portfolio's only writer
+    Portfolio& portfolio_;
+    MarkBoard& marks_;
     ActionSignalContext& actionSignalCtx_;
     SystemState& systemState_;
-    double currentPrice_ = 0;
+    RiskGate& risk_;
+    TradeLog& executionLog_;
+    Journal& journal_;
+    IClock& clock_;
 
-    bool ExecuteBuyOrder(double price, double amount);
-    bool ExecuteSellOrder(double price, double amount);
-    bool HandleActionSignal(ActionType action, double price, double amount);
+    // Orders go to the in-process order book; balances only change through fills
+    SimulatedExchange exchange_;
+    OrderManager orders_;
+    const PriceTicks slippageTicks_;
+    const RuntimeConfigStore& config_;
+    uint32_t currentTickStamp_ = 0;   // Arrival stamp of the tick behind the signal in progress
+
+    // Journal: ids named in it by this run, and during recovery, its ids -> this run's ids
+    uint64_t journaledSymbols_ = 0;
+    SymbolId journalSymbolMap_[MAX_SYMBOLS];
+    ExecutorSnapshot snapshotImage_;
+
+    void OnFill(SymbolId symbol, const BookFill& fill);
+    void OnOrderFill(const Order& order, PriceTicks price, QtyLots quantity);
+    bool SubmitOrder(Order& order, PriceTicks referencePrice);
+    bool RejectOrder(Order& order);
+    TradeLogEntry OrderLogEntry(TradeEvent event, const Order& order) const;
+    void ApplyMarks();
+    bool DequeueSignal(ActionSignal& signal);
+    void ProcessSignal(const ActionSignal& signal);
+    void JournalSignal(const ActionSignal& signal);
+    void JournalOrder(JournalRecordType type, const Order& order, PriceTicks price, QtyLots quantity);
+    void JournalSymbol(SymbolId symbol);
+    void JournalSnapshot();
+    void RestoreSnapshot(const ExecutorSnapshot& snapshot);
+    void ApplyJournalRecord(const JournalRecord& record);
+    bool ExecuteBuyOrder(SymbolId symbol, const InstrumentScale& scale, PriceTicks price, QtyLots amount);
+    bool ExecuteSellOrder(SymbolId symbol, PriceTicks price, QtyLots amount);
+    bool HandleActionSignal(ActionType action, SymbolId symbol, PriceTicks price, QtyLots amount);
     std::stringstream ss;
 
 public:
@@ -31,11 +64,19 @@ public:
 
     TradeExecutor(SystemContext& ctx);
 
+    // Startup, before RunTradeExecutionLoop: rebuilds the portfolio from snapshot + journal
+    bool Recover();
     void RunTradeExecutionLoop();
-    double CalculateTotalPortfolioValue(double currentPrice) const;
-    double CalculateProfitLoss(double currentPrice) const;
-    void DisplayPortfolioStatus(double currentPrice);
-    double GetCurrentPrice(void) const { return currentPrice_; }  
+
+    // Synchronous alternative to the loop for simulated-clock replays: applies pending marks
+    // and handles every queued signal on the caller's thread; returns the signals handled
+    size_t Poll();
+    // After the last Poll(): final journal snapshot (the loop does this itself)
+    void Finish();
+    // Readers: work on a portfolio snapshot and never block the execution loop
+    double CalculateTotalPortfolioValue() const;
+    double CalculateProfitLoss() const;
+    void DisplayPortfolioStatus() const;
 };
 
-#endif // TRADEEXECUTOR_H
\ No newline at end of file
+#endif // TRADEEXECUTOR_H
@@ -0,0 +1,57 @@
+#include "TradeLog.h"
+#include <iomanip>
+#include "../util/Logger.h"
+
+TradeLog::TradeLog(size_t capacity)
+    : entries_(capacity)
+{
+}
+
+void TradeLog::write()
+{
+    TradeLogEntry entry;
+    while (entries_.tryPop(entry)) {
+        const InstrumentScale& scale = SymbolTable::instance().scale(entry.symbol_);
+        const char* symbol = SymbolTable::instance().name(entry.symbol_);
+        const char* side = (entry.type_ == ActionType::BUY) ? "BUY" : "SELL";
+        switch (entry.event_) {
+            case TradeEvent::SIGNAL_EMITTED:
+                LOG(Strategy) << " Generated signal: " << side << " " << symbol
+                              << " at price $" << std::fixed << std::setprecision(2) << scale.fromTicks(entry.price_);
+                break;
+            case TradeEvent::SIGNAL_RECEIVED:
+                LOG(Execution) << "Received action signal: Type=" << side << ", Symbol=" << symbol
+                               << ", Price=$" << std::fixed << std::setprecision(2) << scale.fromTicks(entry.price_)
+                               << ", Amount=" << scale.fromLots(entry.quantity_);
+                break;
+            case TradeEvent::ORDER_EXECUTED:
+                LOG(Execution) << side << " order executed: " << scale.fromLots(entry.filled_) << "/" << scale.fromLots(entry.quantity_)
+                               << " " << symbol
+                               << " at avg $" << fromCashUnits(entry.notional_) / scale.fromLots(entry.filled_)
+                               << " (order " << entry.orderId_ << " " << orderStateToString(entry.state_) << ")"
+                               << ". Cash: " << std::fixed << std::setprecision(2) << fromCashUnits(entry.cash_)
+                               << " " << entry.currency_ << ", " << symbol << ": " << scale.fromLots(entry.position_);
+                break;
+            case TradeEvent::NO_LIQUIDITY:
+                LOG(Execution) << side << " failed: No liquidity within limit $" << scale.fromTicks(entry.price_)
+                               << " (order " << entry.orderId_ << " " << orderStateToString(entry.state_) << ")";
+                break;
+            case TradeEvent::INSUFFICIENT_CASH:
+                LOG(Execution) << side << " failed: Insufficient cash. Needed: " << fromCashUnits(entry.notional_)
+                               << ", Have: " << fromCashUnits(entry.cash_) << " " << entry.currency_;
+                break;
+            case TradeEvent::INSUFFICIENT_POSITION:
+                LOG(Execution) << side << " failed: Insufficient " << symbol
+                               << ". Needed: " << scale.fromLots(entry.quantity_) << ", Have: " << scale.fromLots(entry.position_);
+                break;
+            case TradeEvent::POOL_EXHAUSTED:
+                LOG(Execution) << side << " rejected: order pool exhausted (" << entry.liveOrders_ << " live orders)";
+                break;
+        }
+    }
+    const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped > loggedDrops_) {
+        LOG(WARN) << "Trade log: " << (dropped - loggedDrops_) << " entries dropped";
+        loggedDrops_ = dropped;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef TRADE_LOG_H
+#define TRADE_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include "Types.h"
+#include "SpscRing.h"
+#include "OrderManager.h"
+
+enum class TradeEvent : uint8_t
+{
+    SIGNAL_EMITTED,          // Strategy -> executor queue
+    SIGNAL_RECEIVED,         // Executor took it off the queue
+    ORDER_EXECUTED,          // Filled in full or in part
+    NO_LIQUIDITY,            // Nothing within the limit price
+    INSUFFICIENT_CASH,
+    INSUFFICIENT_POSITION,
+    POOL_EXHAUSTED,
+};
+
+// One log line, captured as values on the thread that trades and formatted by the one that logs
+struct TradeLogEntry
+{
+    OrderId orderId_;
+    PriceTicks price_;        // Signal price or order limit
+    QtyLots quantity_;        // Signal amount or order quantity
+    QtyLots filled_;
+    CashUnits notional_;      // Filled notional, or the cash the order needed
+    CashUnits cash_;          // Balance in currency_ after the fill, or what was available
+    QtyLots position_;        // Position after the fill, or what was held
+    const char* currency_;    // Portfolio-owned name; set before the entry is pushed
+    uint32_t liveOrders_;
+    SymbolId symbol_;
+    ActionType type_;
+    OrderState state_;
+    TradeEvent event_;
+};
+
+/**
+ * @class TradeLog
+ * @brief Signal and order log lines, kept off the trading threads.
+ *
+ * push() copies a fixed-size entry into a preallocated ring: no formatting, no allocation
+ * and no lock on the strategy or executor thread. write() formats the queued entries
+ * into the logger from the monitor loop. A full ring drops the entry and counts it.
+ */
+class TradeLog
+{
+public:
+    explicit TradeLog(size_t capacity = 4096);
+
+    // Producer thread (one per log)
+    void push(const TradeLogEntry& entry)
+    {
+        if (!entries_.tryPush(entry)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Any thread; drains the queue into the log (single consumer)
+    void write();
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<TradeLogEntry> entries_;
+    std::atomic<uint64_t> dropped_{0};
+    uint64_t loggedDrops_ = 0;   // Consumer side
+};
+
+#endif // TRADE_LOG_H
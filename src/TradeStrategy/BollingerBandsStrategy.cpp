@@ -1,18 +1,15 @@
 #include "BollingerBandsStrategy.h"
-#include <numeric> // For std::accumulate
 #include <iostream> // For std::cerr
 #include <cmath>    // For std::sqrt (already included in header, but good practice to include where used)
 
-// Assuming DoubleDeque is a typedef for std::deque<double>
 // Helper function to calculate Simple Moving Average (SMA)
-double BollingerBandsStrategy::calculateSMA(const DoubleDeque& prices, int period) const
+double BollingerBandsStrategy::calculateSMA(const PriceWindow& prices, int period) const
 {
     if (prices.size() < static_cast<size_t>(period)) {
         return 0.0; // Not enough data
     }
     double sum = 0.0;
     // Iterate over the last 'period' elements
-    // std::deque provides direct access with [], but iterating from end - period to end is clearer
     for (int i = 0; i < period; ++i) {
         sum += prices[prices.size() - 1 - i];
     }
@@ -20,19 +17,22 @@ double BollingerBandsStrategy::calculateSMA(const DoubleDeque& prices, int perio
 }
 
 // Helper function to calculate Standard Deviation
-double BollingerBandsStrategy::calculateStandardDeviation(const DoubleDeque& prices, int period) const
+double BollingerBandsStrategy::calculateStandardDeviation(const PriceWindow& prices, int period) const
 {
     if (prices.size() < static_cast<size_t>(period)) {
         return 0.0; // Not enough data
     }
-    // Extract the relevant sub-deque for calculation (last 'period' elements)
-    // Using std::deque's iterators for range constructor
-    DoubleDeque sub_prices(prices.end() - period, prices.end());
+    // Work on the last 'period' elements in place instead of copying them out
+    const size_t first = prices.size() - period;
 
-    double mean = std::accumulate(sub_prices.begin(), sub_prices.end(), 0.0) / period;
+    double sum = 0.0;
+    for (size_t i = first; i < prices.size(); ++i) {
+        sum += prices[i];
+    }
+    double mean = sum / period;
     double sum_sq_diff = 0.0;
-    for (double price : sub_prices) {
-        sum_sq_diff += (price - mean) * (price - mean);
+    for (size_t i = first; i < prices.size(); ++i) {
+        sum_sq_diff += (prices[i] - mean) * (prices[i] - mean);
     }
     // Using period for population standard deviation, or (period - 1) for sample.
     // For technical indicators, population standard deviation is often used.
@@ -40,7 +40,7 @@ double BollingerBandsStrategy::calculateStandardDeviation(const DoubleDeque& pri
 }
 
 // Implementation of the Bollinger Bands strategy
-ActionType BollingerBandsStrategy::calculateAction(const DoubleDeque& priceHistory) const
+ActionType BollingerBandsStrategy::calculateAction(const PriceWindow& priceHistory) const
 {
     try {
         const int BB_PERIOD = 20; // Common period for Bollinger Bands (often 20-period SMA)
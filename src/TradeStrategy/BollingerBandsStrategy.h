@@ -28,18 +28,21 @@ public:
      * A SELL signal is generated if the latest price is at or above the upper band.
      * If insufficient data or no clear signal, it returns HOLD.
      *
-     * @param priceHistory A constant reference to a vector of historical prices,
-     * where the latest price is at the end of the vector.
+     * @param priceHistory A constant reference to the sliding price window,
+     * where the latest price is at the end of the window.
      * @return The recommended ActionType (BUY, SELL, or HOLD).
      */
-    ActionType calculateAction(const DoubleDeque& priceHistory) const override;
+    ActionType calculateAction(const PriceWindow& priceHistory) const override;
+
+    // Bands and the latest price are levels; skipped ticks only sample the series
+    bool conflationSafe() const override { return true; }
 
 private:
     // Helper function to calculate SMA
-    double calculateSMA(const DoubleDeque& prices, int period) const;
+    double calculateSMA(const PriceWindow& prices, int period) const;
 
     // Helper function to calculate Standard Deviation
-    double calculateStandardDeviation(const DoubleDeque& prices, int period) const;
+    double calculateStandardDeviation(const PriceWindow& prices, int period) const;
 };
 
 #endif // BOLLINGER_BANDS_STRATEGY_H
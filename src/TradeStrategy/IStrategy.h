@@ -1,7 +1,7 @@
 #ifndef ISTRATEGY_H
 #define ISTRATEGY_H
 
-#include "../Types.h" // For ActionType and DoubleDeque
+#include "../Types.h" // For ActionType and PriceWindow
 #include "../../util/Logger.h"
 #include "../../util/ErrorLogger.h" // For ErrorLogger
 
@@ -23,11 +23,39 @@ public:
 
     /**
      * @brief Calculates a trading action (BUY, SELL, or HOLD) based on historical price data.
-     * @param priceHistory A constant reference to a vector of historical prices,
-     * where the latest price is at the end of the vector.
+     * @param priceHistory A constant reference to the sliding price window,
+     * where the latest price is at the end of the window.
      * @return The recommended ActionType (BUY, SELL, or HOLD).
      */
-    virtual ActionType calculateAction(const DoubleDeque& priceHistory) const = 0;
+    virtual ActionType calculateAction(const PriceWindow& priceHistory) const = 0;
+
+    /**
+     * @brief Whether the strategy stays valid when intermediate ticks are skipped.
+     *
+     * A conflation-safe strategy may see only the latest price per symbol when the feed
+     * outruns it (see ConflationBoard); its window then holds a sampled price series.
+     * Strategies that need every tick, e.g. to accumulate per-tick moves, keep the default.
+     */
+    virtual bool conflationSafe() const { return false; }
+
+    /**
+     * @brief Bar series the strategy is evaluated on, by BarSpec name ("1m", "100t", ...).
+     *
+     * nullptr (the default) for tick strategies. Otherwise the engine builds that series
+     * from every tick and calls onBarClose() whenever one of its bars completes.
+     */
+    virtual const char* barSeries() const { return nullptr; }
+
+    /**
+     * @brief Calculates a trading action when a bar of barSeries() completes.
+     * @param bars Completed bars of the symbol, oldest first; the new bar is at the end.
+     * @return The recommended ActionType (BUY, SELL, or HOLD).
+     */
+    virtual ActionType onBarClose(const BarWindow& bars) const
+    {
+        (void)bars;
+        return ActionType::HOLD;
+    }
 };
 
 #endif // ISTRATEGY_H
\ No newline at end of file
@@ -1,34 +1,28 @@
 #include "MomentumRSIStrategy.h"
-#include <numeric> // For std::accumulate
 #include <iostream> // For std::cerr
 
 // Helper function to calculate Relative Strength Index (RSI)
-double MomentumRSIStrategy::calculateRSI(const DoubleDeque& prices, int period) const 
+double MomentumRSIStrategy::calculateRSI(const PriceWindow& prices, int period, size_t end) const 
 {
-    if (prices.size() < static_cast<size_t>(period + 1)) { // Need at least period + 1 prices to calculate changes
+    if (end > prices.size() || end < static_cast<size_t>(period + 1)) { // Need at least period + 1 prices to calculate changes
         return 0.0; // Not enough data
     }
 
-    DoubleVector gains;
-    DoubleVector losses;
-
-    // Calculate initial gains and losses for the first 'period'
-    // We need 'period' changes, so we look at 'period + 1' prices
-    // The loop should iterate over the last 'period' price changes.
-    // So, it starts from (prices.size() - period) and goes up to prices.size() - 1
-    for (size_t i = prices.size() - period; i < prices.size(); ++i) {
+    // Accumulate gains and losses over the last 'period' price changes before 'end'.
+    // Running sums replace the former gains/losses vectors, so no allocation per call.
+    double total_gain = 0.0;
+    double total_loss = 0.0;
+    for (size_t i = end - period; i < end; ++i) {
         double change = prices[i] - prices[i - 1];
         if (change > 0) {
-            gains.push_back(change);
-            losses.push_back(0.0);
+            total_gain += change;
         } else {
-            gains.push_back(0.0);
-            losses.push_back(std::abs(change));
+            total_loss += std::abs(change);
         }
     }
 
-    double avg_gain = std::accumulate(gains.begin(), gains.end(), 0.0) / period;
-    double avg_loss = std::accumulate(losses.begin(), losses.end(), 0.0) / period;
+    double avg_gain = total_gain / period;
+    double avg_loss = total_loss / period;
 
     if (avg_loss == 0.0) {
         return 100.0; // No losses, highly bullish
@@ -39,7 +33,7 @@ double MomentumRSIStrategy::calculateRSI(const DoubleDeque& prices, int period)
 }
 
 // Implementation of the Momentum (RSI-based) strategy
-ActionType MomentumRSIStrategy::calculateAction(const DoubleDeque& priceHistory) const
+ActionType MomentumRSIStrategy::calculateAction(const PriceWindow& priceHistory) const
 {
     try {
         const int RSI_PERIOD = 14; // Common RSI period
@@ -51,12 +45,12 @@ ActionType MomentumRSIStrategy::calculateAction(const DoubleDeque& priceHistory)
             return ActionType::HOLD;
         }
 
-        double currentRSI = calculateRSI(priceHistory, RSI_PERIOD);
+        const size_t latest = priceHistory.size();
+        double currentRSI = calculateRSI(priceHistory, RSI_PERIOD, latest);
 
-        // To check for crossover, we need the previous RSI value.
-        // Create a sub-vector excluding the latest price.
-        DoubleDeque prevPrices(priceHistory.begin(), priceHistory.end() - 1);
-        double prevRSI = calculateRSI(prevPrices, RSI_PERIOD);
+        // To check for crossover, we need the previous RSI value,
+        // i.e. the same window excluding the latest price.
+        double prevRSI = calculateRSI(priceHistory, RSI_PERIOD, latest - 1);
 
         ActionType action = ActionType::HOLD;
 
@@ -27,15 +27,15 @@ public:
      * A SELL signal is generated if RSI crosses below 70 (overbought threshold).
      * If insufficient data or no clear signal, it returns HOLD.
      *
-     * @param priceHistory A constant reference to a vector of historical prices,
-     * where the latest price is at the end of the vector.
+     * @param priceHistory A constant reference to the sliding price window,
+     * where the latest price is at the end of the window.
      * @return The recommended ActionType (BUY, SELL, or HOLD).
      */
-    ActionType calculateAction(const DoubleDeque& priceHistory) const override;
+    ActionType calculateAction(const PriceWindow& priceHistory) const override;
 
 private:
-    // Helper function to calculate RSI
-    double calculateRSI(const DoubleDeque& prices, int period) const;
+    // Helper function to calculate RSI over the first 'end' prices of the window
+    double calculateRSI(const PriceWindow& prices, int period, size_t end) const;
 };
 
 #endif // MOMENTUM_RSI_STRATEGY_H
@@ -4,21 +4,21 @@
 
 // Helper function to calculate Simple Moving Average (SMA)
 // This is a private helper within the strategy class.
-double SimpleMovingAverageStrategy::calculateSMA(const DoubleDeque& prices, int period) const 
+double SimpleMovingAverageStrategy::calculateSMA(const PriceWindow& prices, int period, size_t end) const 
 {
-    if (prices.size() < static_cast<size_t>(period)) {
+    if (end > prices.size() || end < static_cast<size_t>(period)) {
         return 0.0; // Not enough data, return a default value
     }
     double sum = 0.0;
-    // Sum the last 'period' elements
+    // Sum the last 'period' elements before 'end'
     for (int i = 0; i < period; ++i) {
-        sum += prices[prices.size() - 1 - i];
+        sum += prices[end - 1 - i];
     }
     return sum / period;
 }
 
 // Implementation of the SMA crossover strategy
-ActionType SimpleMovingAverageStrategy::calculateAction(const DoubleDeque& priceHistory) const
+ActionType SimpleMovingAverageStrategy::calculateAction(const PriceWindow& priceHistory) const
 {
     try
     {
@@ -31,11 +31,13 @@ ActionType SimpleMovingAverageStrategy::calculateAction(const DoubleDeque& price
             return ActionType::HOLD;
         }
 
+        const size_t latest = priceHistory.size();
+
         // Calculate short-term average (last 3 prices)
-        double shortTermMovingAverage = calculateSMA(priceHistory, 3);
+        double shortTermMovingAverage = calculateSMA(priceHistory, 3, latest);
 
         // Calculate long-term average (last 5 prices)
-        double longTermMovingAverage = calculateSMA(priceHistory, 5);
+        double longTermMovingAverage = calculateSMA(priceHistory, 5, latest);
 
         // Generate signals based on moving average crossover
         // A typical crossover strategy doesn't use a threshold, but if you need one, adjust here.
@@ -44,9 +46,9 @@ ActionType SimpleMovingAverageStrategy::calculateAction(const DoubleDeque& price
         // Buy signal: Short-term average crosses above long-term average
         // Check current and previous state for a true crossover
         if (priceHistory.size() >= 6) { // Need at least 6 prices to check previous state for 3 and 5 period SMAs
-            DoubleDeque prevPriceHistory(priceHistory.begin(), priceHistory.end() - 1);
-            double prevShortTermMovingAverage = calculateSMA(prevPriceHistory, 3);
-            double prevLongTermMovingAverage = calculateSMA(prevPriceHistory, 5);
+            // Previous state is the same window without the latest price (no copy)
+            double prevShortTermMovingAverage = calculateSMA(priceHistory, 3, latest - 1);
+            double prevLongTermMovingAverage = calculateSMA(priceHistory, 5, latest - 1);
 
             if (shortTermMovingAverage > longTermMovingAverage + movingAverageCrossoverThreshold &&
                 prevShortTermMovingAverage <= prevLongTermMovingAverage + movingAverageCrossoverThreshold)
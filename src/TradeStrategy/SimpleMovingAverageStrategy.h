@@ -26,15 +26,19 @@ public:
      * A SELL signal is generated if the short-term SMA crosses below the long-term SMA.
      * If insufficient data or no clear signal, it returns HOLD.
      *
-     * @param priceHistory A constant reference to a vector of historical prices,
-     * where the latest price is at the end of the vector.
+     * @param priceHistory A constant reference to the sliding price window,
+     * where the latest price is at the end of the window.
      * @return The recommended ActionType (BUY, SELL, or HOLD).
      */
-    ActionType calculateAction(const DoubleDeque& priceHistory) const override;
+    ActionType calculateAction(const PriceWindow& priceHistory) const override;
+
+    // Crossovers of price levels survive sampling of the series
+    bool conflationSafe() const override { return true; }
 
 private:
     // Helper function to calculate SMA (can be moved to a common utility if many strategies use it)
-    double calculateSMA(const DoubleDeque& prices, int period) const;
+    // Only the first 'end' prices are considered, so the previous bar can be evaluated without copying the window
+    double calculateSMA(const PriceWindow& prices, int period, size_t end) const;
 };
 
 #endif // SIMPLE_MOVING_AVERAGE_STRATEGY_H
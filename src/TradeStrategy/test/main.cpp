@@ -8,6 +8,16 @@
 #include "../MomentumRSIStrategy.h"
 #include "../BollingerBandsStrategy.h"
 
+// Copies a price vector (oldest first) into the fixed-size window strategies consume
+static PriceWindow toWindow(const DoubleVector& prices)
+{
+    PriceWindow window(prices.size());
+    for (double price : prices) {
+        window.push_back(price);
+    }
+    return window;
+}
+
 LevelMapping customMappings = {
     {Main,        "Main"},
     {MarketData,  "Market Data"},
@@ -74,32 +84,32 @@ int main()
     // 1. Simple Moving Average Strategy
     std::cout << "\n--- Simple Moving Average Strategy ---" << std::endl;
     SimpleMovingAverageStrategy smaStrategy;
-    ActionType actionSMA = smaStrategy.calculateAction(prices_sma);
+    ActionType actionSMA = smaStrategy.calculateAction(toWindow(prices_sma));
     std::cout << "Action for SMA: " << actionTypeToString(actionSMA) << std::endl;
 
     // 2. Momentum RSI Strategy
     std::cout << "\n--- Momentum RSI Strategy ---" << std::endl;
     MomentumRSIStrategy rsiStrategy;
-    ActionType actionRSI_buy = rsiStrategy.calculateAction(prices_rsi_buy);
+    ActionType actionRSI_buy = rsiStrategy.calculateAction(toWindow(prices_rsi_buy));
     std::cout << "Action for RSI (Buy scenario): " << actionTypeToString(actionRSI_buy) << std::endl;
-    ActionType actionRSI_sell = rsiStrategy.calculateAction(prices_rsi_sell);
+    ActionType actionRSI_sell = rsiStrategy.calculateAction(toWindow(prices_rsi_sell));
     std::cout << "Action for RSI (Sell scenario): " << actionTypeToString(actionRSI_sell) << std::endl;
 
     // 3. Bollinger Bands Strategy
     std::cout << "\n--- Bollinger Bands Strategy ---" << std::endl;
     BollingerBandsStrategy bbStrategy;
-    ActionType actionBB_buy = bbStrategy.calculateAction(prices_bb_buy);
+    ActionType actionBB_buy = bbStrategy.calculateAction(toWindow(prices_bb_buy));
     std::cout << "Action for Bollinger Bands (Buy scenario): " << actionTypeToString(actionBB_buy) << std::endl;
-    ActionType actionBB_sell = bbStrategy.calculateAction(prices_bb_sell);
+    ActionType actionBB_sell = bbStrategy.calculateAction(toWindow(prices_bb_sell));
     std::cout << "Action for Bollinger Bands (Sell scenario): " << actionTypeToString(actionBB_sell) << std::endl;
 
     // Test with insufficient data
     std::cout << "\n--- Testing with Insufficient Data ---" << std::endl;
-    ActionType actionInsufficientSMA = smaStrategy.calculateAction(prices_insufficient);
+    ActionType actionInsufficientSMA = smaStrategy.calculateAction(toWindow(prices_insufficient));
     std::cout << "Action for SMA (Insufficient Data): " << actionTypeToString(actionInsufficientSMA) << std::endl;
-    ActionType actionInsufficientRSI = rsiStrategy.calculateAction(prices_insufficient);
+    ActionType actionInsufficientRSI = rsiStrategy.calculateAction(toWindow(prices_insufficient));
     std::cout << "Action for RSI (Insufficient Data): " << actionTypeToString(actionInsufficientRSI) << std::endl;
-    ActionType actionInsufficientBB = bbStrategy.calculateAction(prices_insufficient);
+    ActionType actionInsufficientBB = bbStrategy.calculateAction(toWindow(prices_insufficient));
     std::cout << "Action for Bollinger Bands (Insufficient Data): " << actionTypeToString(actionInsufficientBB) << std::endl;
 
 
@@ -112,7 +122,7 @@ int main()
 
     for (const auto& strategy : strategies) {
         // Using prices_sma for simplicity, you can use different price data for each
-        ActionType action = strategy->calculateAction(prices_sma);
+        ActionType action = strategy->calculateAction(toWindow(prices_sma));
         std::cout << "Polymorphic Strategy Action: " << actionTypeToString(action) << std::endl;
     }
 
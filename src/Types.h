@@ -10,8 +10,11 @@
 #include <string>
 #include <vector>
 #include <deque>
+#include <type_traits>
+#include "RingBuffer.h"
+#include "SymbolTable.h"
 
-enum class ActionType
+enum class ActionType : uint8_t
 {
     BUY,
     SELL,
@@ -32,47 +35,63 @@ inline std::string actionTypeToString(ActionType action) {
     }
 }
 
-enum class SymbolType
-{
-    TEST_SYMBOL, // Example symbol
-    // TODO: Add more symbol types as needed
-};
-
+// TradeData and ActionSignal are plain fixed-size records: the symbol is an interned
+// SymbolId (see SymbolTable), so both can be memcpy'd through queues and binary files.
 struct TradeData
 {
     double price_;
+    double volume_;        // Traded quantity if the feed sends one, else 0 (used by volume bars)
     long long timestamp_ms_;
-    std::string symbol_;
-
-    TradeData(double price) : price_(price)
-    {
-        timestamp_ms_ = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                    std::chrono::system_clock::now().time_since_epoch())
-                                    .count();
-    }
-    TradeData() : price_(0.0), timestamp_ms_(0) {}
+    SymbolId symbol_;
+    uint32_t seq_;         // Per-symbol feed sequence number from 1; 0 = unsequenced source
+
+    // Timestamps come from the feed or the injected IClock, never from the wall clock here
+    TradeData(double price, long long timestampMs, SymbolId symbol = INVALID_SYMBOL_ID, uint32_t seq = 0,
+              double volume = 0.0)
+        : price_(price), volume_(volume), timestamp_ms_(timestampMs), symbol_(symbol), seq_(seq) {}
+    TradeData() : price_(0.0), volume_(0.0), timestamp_ms_(0), symbol_(INVALID_SYMBOL_ID), seq_(0) {}
 };
 
+// Price and amount are fixed-point in the symbol's InstrumentScale (see FixedPoint.h)
 struct ActionSignal
 {
-    ActionType type_;
-    double price_;
-    double amount_;
+    PriceTicks price_;
+    QtyLots amount_;
     long long timestamp_ms_;
+    SymbolId symbol_;
+    ActionType type_;
+    uint32_t tickStamp_;   // latencyStamp() of the originating tick's arrival (Metrics.h)
 
-    ActionSignal(ActionType type, double price, double amount)
-        : type_(type), price_(price), amount_(amount)
-    {
-        timestamp_ms_ = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                    std::chrono::system_clock::now().time_since_epoch())
-                                    .count();
-    }
-    ActionSignal() : type_(ActionType::HOLD), price_(0.0), amount_(0.0), timestamp_ms_(0) {}
+    ActionSignal(ActionType type, SymbolId symbol, PriceTicks price, QtyLots amount, long long timestampMs)
+        : price_(price), amount_(amount), timestamp_ms_(timestampMs), symbol_(symbol), type_(type), tickStamp_(0) {}
+    ActionSignal() : price_(0), amount_(0), timestamp_ms_(0), symbol_(INVALID_SYMBOL_ID), type_(ActionType::HOLD), tickStamp_(0) {}
 };
 
+static_assert(std::is_trivially_copyable<TradeData>::value, "TradeData must stay trivially copyable");
+static_assert(std::is_trivially_copyable<ActionSignal>::value, "ActionSignal must stay trivially copyable");
+static_assert(sizeof(TradeData) <= 32 && sizeof(ActionSignal) <= 32, "Keep tick/signal records within half a cache line");
+
 using DoubleVector = std::vector<double>;
 using TradeDataVector = std::vector<TradeData>;
 using DoubleDeque = std::deque<double>;
+// Fixed-capacity price window handed to strategies (no per-tick allocation)
+using PriceWindow = RingBuffer<double>;
+
+// One OHLCV bar, built tick by tick by BarAggregator
+struct Bar
+{
+    long long openTimeMs = 0;    // Time bars: start of the interval; otherwise the first tick
+    long long closeTimeMs = 0;   // Last tick in the bar
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double volume = 0.0;
+    uint32_t ticks = 0;
+};
+
+// Completed bars of one series, oldest first, handed to bar-based strategies
+using BarWindow = RingBuffer<Bar>;
 
 
 
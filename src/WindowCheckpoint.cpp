@@ -0,0 +1,248 @@
+#include "WindowCheckpoint.h"
+#include <algorithm>
+#include <cstring>
+#include "FileUtils.h"
+#include "SymbolTable.h"
+#include "pch.h"
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[4] = {'T', 'S', 'W', '1'};
+constexpr uint32_t FORMAT_VERSION = 1;
+
+struct CheckpointFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    long long savedAtMs;         // Wall clock, for the staleness check
+    uint32_t symbolCount;
+    uint32_t checksum;           // CRC-32 of the payload
+    uint64_t payloadBytes;
+};
+
+// Followed by 'count' doubles, oldest first; keeps the prices 8-byte aligned in the mapping
+struct CheckpointEntry
+{
+    char name[MAX_SYMBOL_LENGTH + 1];
+    uint32_t count;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(CheckpointFileHeader) % 8 == 0 && sizeof(CheckpointEntry) % 8 == 0,
+              "Checkpoint prices stay 8-byte aligned");
+
+size_t ImageCapacity(const std::vector<PriceWindow>& windows)
+{
+    size_t bytes = sizeof(CheckpointFileHeader);
+    for (size_t id = 0; id < windows.size() && id < MAX_SYMBOLS; ++id) {
+        bytes += sizeof(CheckpointEntry) + windows[id].capacity() * sizeof(double);
+    }
+    return bytes;
+}
+
+long long WallClockMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+void WindowCheckpoint::configure(const WindowCheckpointConfig& config)
+{
+    config_ = config;
+    buffer_.clear();
+    imageBytes_ = 0;
+    nextSave_ = std::chrono::steady_clock::now() + std::chrono::seconds(config_.intervalSec);
+}
+
+void WindowCheckpoint::start()
+{
+    if (!config_.enabled || running_.load(std::memory_order_acquire)) {
+        return;
+    }
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&WindowCheckpoint::run, this);
+}
+
+void WindowCheckpoint::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void WindowCheckpoint::reserve(const std::vector<PriceWindow>& windows)
+{
+    if (config_.enabled) {
+        buffer_.resize(std::max(buffer_.size(), ImageCapacity(windows)));
+    }
+}
+
+bool WindowCheckpoint::saveDue()
+{
+    if (!config_.enabled || config_.intervalSec == 0) {
+        return false;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextSave_) {
+        return false;
+    }
+    nextSave_ = now + std::chrono::seconds(config_.intervalSec);
+    return true;
+}
+
+bool WindowCheckpoint::save(const std::vector<PriceWindow>& windows)
+{
+    if (!config_.enabled) {
+        return true;
+    }
+    if (queued_.load(std::memory_order_acquire)) {
+        // The disk is slower than the interval: the next save carries newer windows anyway
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Sized by reserve() at startup; grows only if a window was given a larger capacity since
+    if (buffer_.size() < ImageCapacity(windows)) {
+        buffer_.resize(ImageCapacity(windows));
+    }
+
+    CheckpointFileHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.savedAtMs = WallClockMs();
+
+    size_t offset = sizeof(header);
+    for (size_t id = 0; id < windows.size() && id < SymbolTable::instance().size(); ++id) {
+        const PriceWindow& window = windows[id];
+        if (window.empty()) {
+            continue;
+        }
+        CheckpointEntry entry{};
+        std::strncpy(entry.name, SymbolTable::instance().name(static_cast<SymbolId>(id)), MAX_SYMBOL_LENGTH);
+        entry.count = static_cast<uint32_t>(window.size());
+
+        std::memcpy(buffer_.data() + offset, &entry, sizeof(entry));
+        char* prices = buffer_.data() + offset + sizeof(entry);
+        for (size_t i = 0; i < window.size(); ++i, prices += sizeof(double)) {
+            std::memcpy(prices, &window[i], sizeof(double));
+        }
+        offset += sizeof(entry) + window.size() * sizeof(double);
+        ++header.symbolCount;
+    }
+    header.payloadBytes = offset - sizeof(header);
+    header.checksum = FileUtils::crc32(buffer_.data() + sizeof(header), header.payloadBytes);
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+    imageBytes_ = offset;
+
+    if (!running_.load(std::memory_order_acquire)) {
+        return write();
+    }
+    queued_.store(true, std::memory_order_release);
+    return true;
+}
+
+bool WindowCheckpoint::flush()
+{
+    while (queued_.load(std::memory_order_acquire) && running_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return !failed_.load(std::memory_order_acquire);
+}
+
+bool WindowCheckpoint::write()
+{
+    const size_t headerBytes = sizeof(CheckpointFileHeader);
+    const bool ok = FileUtils::WriteFileAtomic(config_.path, buffer_.data(), headerBytes,
+                                               buffer_.data() + headerBytes, imageBytes_ - headerBytes);
+    if (!ok) {
+        LOG(ERROR) << "Checkpoint: cannot write " << config_.path;
+    }
+    failed_.store(!ok, std::memory_order_release);
+    return ok;
+}
+
+void WindowCheckpoint::run()
+{
+    // Checkpoints are seconds apart; the poll only bounds how long an image waits
+    while (running_.load(std::memory_order_acquire) || queued_.load(std::memory_order_acquire)) {
+        if (queued_.load(std::memory_order_acquire)) {
+            write();
+            queued_.store(false, std::memory_order_release);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+bool WindowCheckpoint::load(std::vector<PriceWindow>& windows, WindowCheckpointStats& stats)
+{
+    const auto started = std::chrono::steady_clock::now();
+    stats = WindowCheckpointStats();
+    if (!config_.enabled) {
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(config_.path)) {
+        return false;   // First run
+    }
+    CheckpointFileHeader header{};
+    if (file.size() < sizeof(header)) {
+        LOG(WARN) << "Checkpoint: ignoring truncated " << config_.path;
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    const char* payload = file.data() + sizeof(header);
+    if (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+        header.version != FORMAT_VERSION || header.payloadBytes != file.size() - sizeof(header) ||
+        FileUtils::crc32(payload, header.payloadBytes) != header.checksum) {
+        LOG(WARN) << "Checkpoint: ignoring invalid " << config_.path;
+        return false;
+    }
+
+    // A window from long ago would fire signals on a price jump that never happened
+    stats.ageSeconds = static_cast<double>(WallClockMs() - header.savedAtMs) / 1000.0;
+    if (config_.maxAgeSec > 0 && stats.ageSeconds > config_.maxAgeSec) {
+        stats.stale = true;
+        return false;
+    }
+
+    const char* cursor = payload;
+    const char* end = payload + header.payloadBytes;
+    for (uint32_t n = 0; n < header.symbolCount; ++n) {
+        CheckpointEntry entry{};
+        if (static_cast<size_t>(end - cursor) < sizeof(entry)) {
+            break;
+        }
+        std::memcpy(&entry, cursor, sizeof(entry));
+        cursor += sizeof(entry);
+        const size_t bytes = static_cast<size_t>(entry.count) * sizeof(double);
+        if (static_cast<size_t>(end - cursor) < bytes) {
+            break;
+        }
+        entry.name[MAX_SYMBOL_LENGTH] = '\0';
+        const SymbolId id = SymbolTable::instance().intern(entry.name);
+        if (id == INVALID_SYMBOL_ID || id >= windows.size()) {
+            cursor += bytes;
+            continue;
+        }
+
+        // Keep the newest prices if the window shrank since the checkpoint
+        PriceWindow& window = windows[id];
+        window.clear();
+        const size_t keep = std::min<size_t>(entry.count, window.capacity());
+        const char* prices = cursor + (entry.count - keep) * sizeof(double);
+        for (size_t i = 0; i < keep; ++i, prices += sizeof(double)) {
+            double price;
+            std::memcpy(&price, prices, sizeof(price));
+            window.push_back(price);
+        }
+        cursor += bytes;
+        ++stats.symbols;
+        stats.prices += keep;
+    }
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef WINDOW_CHECKPOINT_H
+#define WINDOW_CHECKPOINT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Types.h"
+
+struct WindowCheckpointConfig
+{
+    bool enabled = false;
+    std::string path = "warmstart.bin";
+    uint32_t intervalSec = 30;     // Periodic checkpoint from the engine thread (0 = only at shutdown)
+    uint32_t maxAgeSec = 300;      // Older checkpoints are ignored at startup (0 = no limit)
+};
+
+struct WindowCheckpointStats
+{
+    uint32_t symbols = 0;
+    uint64_t prices = 0;
+    double ageSeconds = 0.0;
+    double milliseconds = 0.0;
+    bool stale = false;
+};
+
+/**
+ * @class WindowCheckpoint
+ * @brief Warm start for the strategy engine: per-symbol price windows saved to a compact binary file.
+ *
+ * Strategies are pure functions of the window, so the windows are the complete indicator
+ * state. Entries are keyed by symbol name because SymbolIds are assigned in arrival order
+ * and differ between runs. The file is written atomically (tmp + rename) and mmap-loaded.
+ *
+ * save() only copies the windows into a preallocated image on the engine thread; a
+ * background thread does the write, fdatasync and rename, so a checkpoint never stalls
+ * the feed. A save that comes due while the previous image is still being written is skipped.
+ */
+class WindowCheckpoint
+{
+public:
+    WindowCheckpoint() = default;
+    ~WindowCheckpoint() { stop(); }
+    WindowCheckpoint(const WindowCheckpoint&) = delete;
+    WindowCheckpoint& operator=(const WindowCheckpoint&) = delete;
+
+    void configure(const WindowCheckpointConfig& config);
+    bool enabled() const { return config_.enabled; }
+
+    void start();   // Background writer; without it save() writes on the caller's thread
+    void stop();    // Writes a queued image and joins
+
+    // Engine thread; 'windows' is indexed by SymbolId
+    bool load(std::vector<PriceWindow>& windows, WindowCheckpointStats& stats);
+    // Sizes the image for 'windows' full to capacity, so save() never allocates
+    void reserve(const std::vector<PriceWindow>& windows);
+    // Serializes 'windows' and queues the image; false if the previous image is still queued
+    bool save(const std::vector<PriceWindow>& windows);
+    // Waits for the queued image; false if the last write failed
+    bool flush();
+
+    // True once per interval; the engine checks it between receives
+    bool saveDue();
+
+    uint64_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    bool write();
+
+    WindowCheckpointConfig config_;
+    std::vector<char> buffer_;     // File header + payload; the writer's while queued_ is set
+    size_t imageBytes_ = 0;
+    std::chrono::steady_clock::time_point nextSave_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> queued_{false};
+    std::atomic<bool> failed_{false};          // Outcome of the last write
+    std::atomic<uint64_t> skipped_{0};
+};
+
+#endif // WINDOW_CHECKPOINT_H
@@ -0,0 +1,145 @@
+// CSV ingest benchmark.
+// Writes a synthetic "symbol,price,timestamp" file (market_data.csv layout), then
+// loads it with CsvTickSource (mmap + memchr + from_chars) and with the
+// std::getline + std::stod loop it replaces, and converts it to the tick store.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "../CsvTickSource.h"
+#include "../TickLog.h"
+#include "../Types.h"
+#include "../../util/Logger.h"
+
+LevelMapping customMappings = {
+    {Main,        "Main"},
+    {MarketData,  "Market Data"},
+    {Strategy,    "Strategy"},
+    {Execution,   "Trade Executor"},
+    {DEBUG,       "DEBUG"},
+    {INFO,        "INFO"},
+    {WARN,        "WARN"},
+    {ERROR,       "ERROR"}
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void WriteCsv(const std::string& path, uint64_t rows)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        std::fprintf(stderr, "cannot create %s\n", path.c_str());
+        std::exit(1);
+    }
+    const char* symbols[] = {"BTC", "ETH", "SOL"};
+    double prices[] = {29500.0, 1800.0, 20.0};
+    double timestamp = 1692284400.0;
+    std::mt19937 rng(42);
+    std::fprintf(file, "symbol,price,timestamp\n");
+    for (uint64_t i = 0; i < rows; ++i) {
+        const int s = static_cast<int>(rng() % 3);
+        prices[s] += (static_cast<int>(rng() % 201) - 100) / 100.0;
+        timestamp += (rng() % 50) / 1000.0;
+        std::fprintf(file, "%s,%.2f,%.3f\n", symbols[s], prices[s], timestamp);
+    }
+    std::fclose(file);
+}
+
+void Report(const char* name, uint64_t rows, double checksum, size_t bytes, double seconds)
+{
+    std::printf("%-16s %llu rows in %.3f s: %.1f M rows/s, %.0f MB/s (checksum %.2f)\n", name,
+                static_cast<unsigned long long>(rows), seconds, rows / seconds / 1e6,
+                bytes / seconds / 1e6, checksum);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint64_t rows = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000ULL;
+    const std::string directory = (argc > 2) ? argv[2] : "bench_csv";
+
+    LOGINIT(customMappings);
+    std::system(("mkdir -p " + directory).c_str());
+    const std::string csvPath = directory + "/market_data.csv";
+    WriteCsv(csvPath, rows);
+
+    // Baseline: line by line with std::getline and std::stod
+    {
+        const auto start = Clock::now();
+        std::ifstream in(csvPath);
+        std::string line;
+        std::getline(in, line);
+        uint64_t count = 0;
+        double checksum = 0.0;
+        size_t bytes = line.size() + 1;
+        while (std::getline(in, line)) {
+            bytes += line.size() + 1;
+            const size_t comma1 = line.find(',');
+            const size_t comma2 = line.find(',', comma1 + 1);
+            const std::string symbol = line.substr(0, comma1);
+            checksum += std::stod(line.substr(comma1 + 1, comma2 - comma1 - 1));
+            std::stod(line.substr(comma2 + 1));
+            SymbolTable::instance().intern(symbol.c_str(), symbol.size());
+            ++count;
+        }
+        Report("getline+stod", count, checksum, bytes, SecondsSince(start));
+    }
+
+    {
+        const auto start = Clock::now();
+        CsvTickSource source;
+        source.open(csvPath);
+        TradeData tick;
+        double checksum = 0.0;
+        while (source.Next(tick)) {
+            checksum += tick.price_;
+        }
+        Report("mmap+from_chars", source.rows(), checksum, source.bytes(), SecondsSince(start));
+    }
+
+    {
+        const auto start = Clock::now();
+        CsvTickSource source;
+        source.open(csvPath);
+        TickLogConfig config;
+        config.directory = directory + "/ticks";
+        std::system(("rm -rf " + config.directory).c_str());
+        TickLogWriter writer;
+        writer.open(config);
+        TradeData tick;
+        while (source.Next(tick)) {
+            writer.write(tick);
+        }
+        writer.close();
+        const double seconds = SecondsSince(start);
+        std::printf("convert          %llu rows in %.3f s: %.1f M rows/s, %zu CSV bytes -> %llu tick log bytes (%.1fx)\n",
+                    static_cast<unsigned long long>(writer.ticks()), seconds, writer.ticks() / seconds / 1e6,
+                    source.bytes(), static_cast<unsigned long long>(writer.bytes()),
+                    static_cast<double>(source.bytes()) / writer.bytes());
+
+        const auto readStart = Clock::now();
+        TickLogReader reader;
+        reader.open(config.directory);
+        uint64_t count = 0;
+        double checksum = 0.0;
+        while (reader.Next(tick)) {
+            checksum += tick.price_;
+            ++count;
+        }
+        Report("tick log read", count, checksum, writer.bytes(), SecondsSince(readStart));
+    }
+
+    std::system(("rm -rf " + directory).c_str());
+    return 0;
+}
@@ -0,0 +1,164 @@
+// Journal write and recovery benchmark.
+// Writes N fill/order/signal records through the I/O thread (group commit with
+// fdatasync), then times a cold recovery: full replay into a Portfolio, and
+// replay of the tail after a snapshot taken at 90%.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "../Journal.h"
+#include "../Portfolio.h"
+#include "../Types.h"
+#include "../../util/Logger.h"
+
+LevelMapping customMappings = {
+    {Main,        "Main"},
+    {MarketData,  "Market Data"},
+    {Strategy,    "Strategy"},
+    {Execution,   "Trade Executor"},
+    {DEBUG,       "DEBUG"},
+    {INFO,        "INFO"},
+    {WARN,        "WARN"},
+    {ERROR,       "ERROR"}
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void ApplyRecord(Portfolio& portfolio, const JournalRecord& record)
+{
+    const OrderSide side = static_cast<OrderSide>(record.side);
+    if (record.type == JournalRecordType::FILL) {
+        portfolio.applyFill(record.symbol, side, record.price, record.quantity);
+    } else if (record.type == JournalRecordType::ORDER && record.filled > 0) {
+        portfolio.countTrade(side);
+    }
+}
+
+void RemoveJournal(const std::string& directory)
+{
+    std::remove((directory + "/journal.bin").c_str());
+    std::remove((directory + "/snapshot.bin").c_str());
+}
+
+// One signal, one fill and one terminal order record per trade, like the executor
+void WriteJournal(const std::string& directory, uint64_t events, const SymbolId* symbols, size_t symbolCount)
+{
+    RemoveJournal(directory);
+    JournalConfig config;
+    config.enabled = true;
+    config.directory = directory;
+    config.snapshotEvery = 0;
+
+    Journal journal;
+    journal.configure(config);
+    PortfolioState unused{};
+    bool loaded = false;
+    JournalRecoveryStats stats;
+    if (!journal.open(&unused, sizeof(unused), loaded) || !journal.replay([](const JournalRecord&) {}, stats) ||
+        !journal.start()) {
+        std::fprintf(stderr, "cannot open journal in %s\n", directory.c_str());
+        std::exit(1);
+    }
+
+    Portfolio portfolio;
+    portfolio.reset("USD", toCashUnits(1e9));
+    const uint64_t snapshotAt = events / 10 * 9;
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < events; ++i) {
+        JournalRecord record{};
+        record.timestampMs = static_cast<long long>(i);
+        record.orderId = (i / 3) + 1;
+        record.symbol = symbols[(i / 3) % symbolCount];
+        record.side = static_cast<uint8_t>(((i / 3) & 1) ? OrderSide::SELL : OrderSide::BUY);
+        record.price = 3000000 + static_cast<PriceTicks>((i * 7919) % 20000);
+        record.quantity = 1000000;
+        switch (i % 3) {
+            case 0: record.type = JournalRecordType::SIGNAL; break;
+            case 1: record.type = JournalRecordType::FILL; break;
+            default: record.type = JournalRecordType::ORDER; record.filled = record.quantity; break;
+        }
+        journal.append(record);
+        ApplyRecord(portfolio, record);
+        if (i + 1 == snapshotAt) {
+            journal.snapshot(&portfolio.writerView(), sizeof(PortfolioState));
+        }
+    }
+    const double appendSeconds = SecondsSince(start);
+    journal.stop();
+    const double durableSeconds = SecondsSince(start);
+
+    std::printf("write:    %llu records, append %.3f s (%.1f M/s), durable %.3f s (%.1f M/s), %llu group commits, %llu stalls\n",
+                static_cast<unsigned long long>(events), appendSeconds, events / appendSeconds / 1e6,
+                durableSeconds, events / durableSeconds / 1e6,
+                static_cast<unsigned long long>(journal.groupCommits()),
+                static_cast<unsigned long long>(journal.producerStalls()));
+    std::printf("expected: equity %.2f, trades %u\n", fromCashUnits(portfolio.writerView().pnl.equity),
+                portfolio.writerView().totalTrades);
+}
+
+void Recover(const std::string& directory, bool useSnapshot)
+{
+    if (!useSnapshot) {
+        std::rename((directory + "/snapshot.bin").c_str(), (directory + "/snapshot.bin.keep").c_str());
+    }
+
+    JournalConfig config;
+    config.enabled = true;
+    config.directory = directory;
+    Journal journal;
+    journal.configure(config);
+
+    Portfolio portfolio;
+    portfolio.reset("USD", toCashUnits(1e9));
+    PortfolioState snapshot = portfolio.writerView();
+    bool loaded = false;
+    JournalRecoveryStats stats;
+
+    const auto start = Clock::now();
+    journal.open(&snapshot, sizeof(snapshot), loaded);
+    if (loaded) {
+        portfolio.restore(snapshot);
+    }
+    journal.replay([&portfolio](const JournalRecord& record) { ApplyRecord(portfolio, record); }, stats);
+    const double seconds = SecondsSince(start);
+
+    std::printf("%s %llu records replayed after snapshot %llu in %.3f s (%.1f M/s), equity %.2f, trades %u\n",
+                useSnapshot ? "snapshot:" : "full:    ",
+                static_cast<unsigned long long>(stats.replayed), static_cast<unsigned long long>(stats.snapshotSequence),
+                seconds, stats.replayed / seconds / 1e6,
+                fromCashUnits(portfolio.writerView().pnl.equity), portfolio.writerView().totalTrades);
+
+    if (!useSnapshot) {
+        std::rename((directory + "/snapshot.bin.keep").c_str(), (directory + "/snapshot.bin").c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint64_t events = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000ULL;
+    const std::string directory = (argc > 2) ? argv[2] : "bench_journal";
+
+    LOGINIT(customMappings);
+    const SymbolId symbols[] = {
+        SymbolTable::instance().intern("BTC"),
+        SymbolTable::instance().intern("ETH"),
+        SymbolTable::instance().intern("SOL"),
+        SymbolTable::instance().intern("BTC-EUR"),
+    };
+
+    WriteJournal(directory, events, symbols, sizeof(symbols) / sizeof(symbols[0]));
+    Recover(directory, false);
+    Recover(directory, true);
+    RemoveJournal(directory);
+    return 0;
+}
@@ -0,0 +1,485 @@
+// Closed-loop end-to-end load generator for a running trading_system.
+// Connects to the feed port as the market data client and offers ticks at a rate that
+// grows by --factor per step. After each step it waits for the engine to drain, then
+// reads the engine's own counters and latency histograms from the metrics endpoint
+// (METRICS_PORT), so every step starts from an empty pipeline and is measured by the
+// engine itself. Stops at the first saturated step and writes a JSON report.
+//
+// Per step: offered / sent / processed ticks/s, backlog, unprocessed and late ticks,
+// tick-to-signal and tick-to-fill percentiles.
+//
+// With --multicast GROUP it publishes the same ticks as UDP datagrams of up to
+// --datagram-bytes to GROUP:--port through --interface (loopback by default), for an
+// engine running with FEED_TRANSPORT=udp. UDP has no back-pressure: ticks the engine
+// cannot keep up with are lost and reported as sequence gaps (lost_ticks).
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    std::string host = "127.0.0.1";
+    int feedPort = 9999;
+    int metricsPort = 9464;
+    double startRate = 1000.0;        // Ticks/s of the first step
+    double maxRate = 2000000.0;
+    double factor = 2.0;
+    double stepSeconds = 5.0;
+    double drainSeconds = 10.0;       // Longest wait for the engine to catch up after a step
+    double lateUs = 1000.0;           // Tick processing slower than this counts as late
+    double saturation = 0.90;         // Saturated when processed < this fraction of offered
+    int symbols = 3;
+    std::string output = "e2e_report.json";
+    std::string label;                // Free text, e.g. the commit under test
+    std::string multicastGroup;       // Non-empty: publish over UDP multicast instead of TCP
+    std::string multicastInterface = "127.0.0.1";
+    size_t datagramBytes = 1400;      // Stays within a standard Ethernet MTU
+};
+
+// One scrape of the Prometheus endpoint: "name{labels}" -> value
+using Scrape = std::map<std::string, double>;
+
+struct Quantiles
+{
+    uint64_t count = 0;
+    double p50Us = 0, p90Us = 0, p99Us = 0, p999Us = 0, maxUs = 0;
+};
+
+struct Step
+{
+    double offered = 0, sent = 0, processed = 0;
+    uint64_t ticksSent = 0, ticksProcessed = 0, parseErrors = 0;
+    uint64_t backlogAtEnd = 0, unprocessed = 0, late = 0;
+    uint64_t signals = 0, fills = 0, lost = 0;
+    double drainSeconds = 0;
+    bool saturated = false;
+    Quantiles processing, toSignal, toFill;
+};
+
+int Connect(const std::string& host, int port)
+{
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    inet_pton(AF_INET, host.c_str(), &addr.sin_addr);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+bool ScrapeMetrics(const Options& options, Scrape& out)
+{
+    const int fd = Connect(options.host, options.metricsPort);
+    if (fd < 0) {
+        return false;
+    }
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    send(fd, request, sizeof(request) - 1, MSG_NOSIGNAL);
+    std::string response;
+    char buffer[16384];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    close(fd);
+
+    const size_t body = response.find("\r\n\r\n");
+    if (body == std::string::npos) {
+        return false;
+    }
+    out.clear();
+    size_t pos = body + 4;
+    while (pos < response.size()) {
+        size_t end = response.find('\n', pos);
+        if (end == std::string::npos) {
+            end = response.size();
+        }
+        if (response[pos] != '#') {
+            const size_t space = response.rfind(' ', end);
+            if (space != std::string::npos && space > pos) {
+                out[response.substr(pos, space - pos)] = std::strtod(response.c_str() + space + 1, nullptr);
+            }
+        }
+        pos = end + 1;
+    }
+    return true;
+}
+
+double Value(const Scrape& scrape, const std::string& name)
+{
+    const auto it = scrape.find(name);
+    return it == scrape.end() ? 0.0 : it->second;
+}
+
+// Feed messages the engine has taken off the socket, parsed or not
+double Consumed(const Scrape& scrape)
+{
+    return Value(scrape, "trading_ticks_received_total") + Value(scrape, "trading_parse_errors_total");
+}
+
+// Histogram buckets of 'name' as (upper bound seconds, cumulative count), +Inf last
+std::vector<std::pair<double, double>> Buckets(const Scrape& scrape, const std::string& name)
+{
+    std::vector<std::pair<double, double>> buckets;
+    const std::string prefix = name + "_bucket{le=\"";
+    for (auto it = scrape.lower_bound(prefix); it != scrape.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        const std::string bound = it->first.substr(prefix.size());
+        const double le = (bound.compare(0, 4, "+Inf") == 0) ? INFINITY : std::strtod(bound.c_str(), nullptr);
+        buckets.emplace_back(le, it->second);
+    }
+    std::sort(buckets.begin(), buckets.end());
+    return buckets;
+}
+
+// Distribution of the samples recorded between two scrapes; values are bucket upper bounds
+Quantiles Delta(const Scrape& before, const Scrape& after, const std::string& name, double lateSeconds,
+                uint64_t* late = nullptr)
+{
+    const auto b = Buckets(before, name);
+    const auto a = Buckets(after, name);
+    Quantiles q;
+    if (a.empty() || a.size() != b.size()) {
+        return q;
+    }
+    std::vector<double> counts(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        counts[i] = a[i].second - b[i].second;   // Cumulative
+    }
+    q.count = static_cast<uint64_t>(counts.back());
+    if (late != nullptr) {
+        // Buckets entirely above the threshold: every sample in them was late
+        *late = 0;
+        for (size_t i = 1; i < a.size(); ++i) {
+            if (a[i - 1].first >= lateSeconds) {
+                *late = static_cast<uint64_t>(counts.back() - counts[i - 1]);
+                break;
+            }
+        }
+    }
+    if (q.count == 0) {
+        return q;
+    }
+    auto quantile = [&](double p) {
+        const double rank = std::max(1.0, std::ceil(p * counts.back()));
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (counts[i] >= rank) {
+                // +Inf bucket: report twice the last finite bound
+                const double bound = std::isinf(a[i].first) ? a[i - 1].first * 2 : a[i].first;
+                return bound * 1e6;
+            }
+        }
+        return 0.0;
+    };
+    q.p50Us = quantile(0.50);
+    q.p90Us = quantile(0.90);
+    q.p99Us = quantile(0.99);
+    q.p999Us = quantile(0.999);
+    q.maxUs = quantile(1.0);
+    return q;
+}
+
+int OpenMulticast(const Options& options)
+{
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in group{};
+    group.sin_family = AF_INET;
+    group.sin_port = htons(static_cast<uint16_t>(options.feedPort));
+    in_addr interface{};
+    const unsigned char loop = 1;
+    const unsigned char ttl = 1;
+    if (fd < 0 || inet_pton(AF_INET, options.multicastGroup.c_str(), &group.sin_addr) != 1 ||
+        inet_pton(AF_INET, options.multicastInterface.c_str(), &interface) != 1 ||
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+        connect(fd, reinterpret_cast<sockaddr*>(&group), sizeof(group)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+double NowSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Sends 'batch' as datagrams of whole lines, each at most options.datagramBytes
+bool SendDatagrams(int fd, const Options& options, const std::string& batch)
+{
+    size_t start = 0;
+    while (start < batch.size()) {
+        size_t end = start;
+        for (;;) {
+            const size_t newline = batch.find('\n', end);
+            const size_t next = newline == std::string::npos ? batch.size() : newline + 1;
+            if (end > start && next - start > options.datagramBytes) {
+                break;
+            }
+            end = next;
+            if (end == batch.size()) {
+                break;
+            }
+        }
+        if (send(fd, batch.data() + start, end - start, 0) < 0 && errno != ENOBUFS && errno != EAGAIN) {
+            return false;
+        }
+        start = end;
+    }
+    return true;
+}
+
+// Paced sender: every millisecond, the ticks that are due go out in one send()
+uint64_t SendAtRate(int fd, const Options& options, double rate, double seconds, std::vector<double>& prices,
+                    std::vector<uint32_t>& sequences)
+{
+    static const char* SYMBOLS[] = {"BTC", "ETH", "SOL", "XRP", "ADA", "DOGE", "DOT", "LTC"};
+    const int symbols = std::min(std::max(options.symbols, 1), 8);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    uint64_t sent = 0;
+    std::string batch;
+    char line[128];
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    for (auto now = start; now < end; now = Clock::now()) {
+        const uint64_t due = static_cast<uint64_t>(rate * std::chrono::duration<double>(now - start).count());
+        if (due <= sent) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+        batch.clear();
+        const double timestamp = NowSeconds();
+        for (; sent < due; ++sent) {
+            const int s = static_cast<int>(sent % static_cast<uint64_t>(symbols));
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            prices[s] *= 1.0 + (static_cast<int>((state >> 33) % 201) - 100) * 1e-5;
+            const int len = std::snprintf(line, sizeof(line),
+                                          "{\"symbol\": \"%s\", \"price\": %.2f, \"timestamp\": %.3f, \"seq\": %u}\n",
+                                          SYMBOLS[s], prices[s], timestamp, ++sequences[s]);
+            batch.append(line, static_cast<size_t>(len));
+        }
+        if (!options.multicastGroup.empty()) {
+            if (!SendDatagrams(fd, options, batch)) {
+                return sent;
+            }
+            continue;
+        }
+        // Blocks when the engine's socket buffer is full: the sent rate then falls behind the offer
+        size_t off = 0;
+        while (off < batch.size()) {
+            const ssize_t n = send(fd, batch.data() + off, batch.size() - off, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return sent;
+            }
+            off += static_cast<size_t>(n);
+        }
+    }
+    return sent;
+}
+
+void PrintQuantiles(std::FILE* file, const char* name, const Quantiles& q, bool last)
+{
+    std::fprintf(file, "\"%s\": {\"count\": %llu, \"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, "
+                       "\"p999_us\": %.3f, \"max_us\": %.3f}%s",
+                 name, static_cast<unsigned long long>(q.count), q.p50Us, q.p90Us, q.p99Us, q.p999Us, q.maxUs,
+                 last ? "" : ", ");
+}
+
+void WriteReport(const Options& options, const std::vector<Step>& steps)
+{
+    std::FILE* file = std::fopen(options.output.c_str(), "w");
+    if (file == nullptr) {
+        std::fprintf(stderr, "cannot write %s\n", options.output.c_str());
+        return;
+    }
+    double sustained = 0.0;
+    double peak = 0.0;
+    for (const Step& step : steps) {
+        peak = std::max(peak, step.processed);
+        if (!step.saturated) {
+            sustained = std::max(sustained, step.processed);
+        }
+    }
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    std::fprintf(file, "{\n  \"label\": \"%s\",\n  \"date\": \"%s\",\n  \"hardware_threads\": %u,\n", options.label.c_str(),
+                 date, std::thread::hardware_concurrency());
+    std::fprintf(file, "  \"transport\": \"%s\",\n", options.multicastGroup.empty() ? "tcp" : "udp");
+    std::fprintf(file, "  \"step_seconds\": %.1f,\n  \"symbols\": %d,\n  \"late_us\": %.1f,\n", options.stepSeconds,
+                 options.symbols, options.lateUs);
+    std::fprintf(file, "  \"max_sustained_ticks_per_s\": %.0f,\n  \"peak_processed_ticks_per_s\": %.0f,\n", sustained, peak);
+    std::fprintf(file, "  \"saturated\": %s,\n  \"steps\": [\n", (!steps.empty() && steps.back().saturated) ? "true" : "false");
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const Step& s = steps[i];
+        std::fprintf(file, "    {\"offered_tps\": %.0f, \"sent_tps\": %.0f, \"processed_tps\": %.0f, "
+                           "\"ticks_sent\": %llu, \"ticks_processed\": %llu, \"parse_errors\": %llu, "
+                           "\"backlog_at_end\": %llu, \"unprocessed\": %llu, \"late\": %llu, \"drain_s\": %.2f, "
+                           "\"signals\": %llu, \"fills\": %llu, \"lost_ticks\": %llu, \"saturated\": %s, ",
+                     s.offered, s.sent, s.processed, static_cast<unsigned long long>(s.ticksSent),
+                     static_cast<unsigned long long>(s.ticksProcessed), static_cast<unsigned long long>(s.parseErrors),
+                     static_cast<unsigned long long>(s.backlogAtEnd), static_cast<unsigned long long>(s.unprocessed),
+                     static_cast<unsigned long long>(s.late), s.drainSeconds, static_cast<unsigned long long>(s.signals),
+                     static_cast<unsigned long long>(s.fills), static_cast<unsigned long long>(s.lost),
+                     s.saturated ? "true" : "false");
+        PrintQuantiles(file, "tick_processing", s.processing, false);
+        PrintQuantiles(file, "tick_to_signal", s.toSignal, false);
+        PrintQuantiles(file, "tick_to_fill", s.toFill, true);
+        std::fprintf(file, "}%s\n", (i + 1 < steps.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+    std::printf("Max sustained %.0f ticks/s, peak processed %.0f ticks/s; report written to %s\n", sustained, peak,
+                options.output.c_str());
+}
+
+Options ParseOptions(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key = argv[i];
+        const char* value = argv[i + 1];
+        if (key == "--host") o.host = value;
+        else if (key == "--port") o.feedPort = std::atoi(value);
+        else if (key == "--metrics-port") o.metricsPort = std::atoi(value);
+        else if (key == "--start-rate") o.startRate = std::atof(value);
+        else if (key == "--max-rate") o.maxRate = std::atof(value);
+        else if (key == "--factor") o.factor = std::atof(value);
+        else if (key == "--step-seconds") o.stepSeconds = std::atof(value);
+        else if (key == "--drain-seconds") o.drainSeconds = std::atof(value);
+        else if (key == "--late-us") o.lateUs = std::atof(value);
+        else if (key == "--saturation") o.saturation = std::atof(value);
+        else if (key == "--symbols") o.symbols = std::atoi(value);
+        else if (key == "--output") o.output = value;
+        else if (key == "--label") o.label = value;
+        else if (key == "--multicast") o.multicastGroup = value;
+        else if (key == "--interface") o.multicastInterface = value;
+        else if (key == "--datagram-bytes") o.datagramBytes = static_cast<size_t>(std::atoi(value));
+        else std::fprintf(stderr, "unknown option %s\n", key.c_str());
+    }
+    return o;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Options options = ParseOptions(argc, argv);
+
+    // The engine may still be starting up
+    int fd = -1;
+    Scrape before;
+    for (int attempt = 0; attempt < 100 && (fd < 0 || !ScrapeMetrics(options, before)); ++attempt) {
+        if (fd < 0) {
+            fd = options.multicastGroup.empty() ? Connect(options.host, options.feedPort) : OpenMulticast(options);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (fd < 0 || before.empty()) {
+        std::fprintf(stderr, "cannot reach the engine at %s:%d (feed) / %d (metrics)\n", options.host.c_str(),
+                     options.feedPort, options.metricsPort);
+        return 1;
+    }
+    if (options.multicastGroup.empty()) {
+        const int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    std::vector<double> prices = {29500.0, 1800.0, 20.0, 0.5, 0.3, 0.07, 5.0, 70.0};
+    std::vector<uint32_t> sequences(prices.size(), 0);   // Per-symbol feed sequence numbers
+    std::vector<Step> steps;
+    std::printf("%10s %10s %10s %9s %8s %10s %10s %10s\n", "offered", "sent", "processed", "backlog", "late",
+                "sig p99us", "fill p99us", "drain s");
+    for (double rate = options.startRate; rate <= options.maxRate; rate *= options.factor) {
+        Step step;
+        step.offered = rate;
+        const auto start = Clock::now();
+        step.ticksSent = SendAtRate(fd, options, rate, options.stepSeconds, prices, sequences);
+        const double sendSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        step.sent = step.ticksSent / sendSeconds;
+
+        Scrape atEnd;
+        ScrapeMetrics(options, atEnd);
+        const double accepted = Consumed(atEnd) - Consumed(before);
+        step.processed = (Value(atEnd, "trading_ticks_received_total") - Value(before, "trading_ticks_received_total")) / sendSeconds;
+        step.backlogAtEnd = step.ticksSent > accepted ? static_cast<uint64_t>(step.ticksSent - accepted) : 0;
+
+        // Closed loop: the next step starts only once feed and executor have caught up (or stalled)
+        Scrape after = atEnd;
+        const auto drainStart = Clock::now();
+        double lastProgressValue = -1.0;
+        auto lastProgress = drainStart;
+        for (;;) {
+            ScrapeMetrics(options, after);
+            // Over UDP, ticks lost in a gap will never arrive
+            const double seen = Consumed(after) - Consumed(before) +
+                Value(after, "trading_feed_missing_ticks_total") - Value(before, "trading_feed_missing_ticks_total");
+            const double pendingSignals = Value(after, "trading_signals_total") - Value(after, "trading_signals_processed_total");
+            const double progress = seen + Value(after, "trading_signals_processed_total");
+            const auto now = Clock::now();
+            if ((seen >= static_cast<double>(step.ticksSent) && pendingSignals <= 0) ||
+                std::chrono::duration<double>(now - drainStart).count() > options.drainSeconds ||
+                (progress == lastProgressValue && now - lastProgress > std::chrono::seconds(2))) {
+                step.unprocessed = seen < step.ticksSent ? static_cast<uint64_t>(step.ticksSent - seen) : 0;
+                break;
+            }
+            if (progress != lastProgressValue) {
+                lastProgressValue = progress;
+                lastProgress = now;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        step.drainSeconds = std::chrono::duration<double>(Clock::now() - drainStart).count();
+
+        step.ticksProcessed = static_cast<uint64_t>(Value(after, "trading_ticks_received_total") -
+                                                    Value(before, "trading_ticks_received_total"));
+        step.parseErrors = static_cast<uint64_t>(Value(after, "trading_parse_errors_total") -
+                                                 Value(before, "trading_parse_errors_total"));
+        step.signals = static_cast<uint64_t>(Value(after, "trading_signals_total") - Value(before, "trading_signals_total"));
+        step.fills = static_cast<uint64_t>(Value(after, "trading_fills_total") - Value(before, "trading_fills_total"));
+        step.lost = static_cast<uint64_t>(Value(after, "trading_feed_missing_ticks_total") -
+                                          Value(before, "trading_feed_missing_ticks_total"));
+        step.processing = Delta(before, after, "trading_tick_processing_seconds", options.lateUs * 1e-6, &step.late);
+        step.toSignal = Delta(before, after, "trading_tick_to_signal_seconds", 0);
+        step.toFill = Delta(before, after, "trading_tick_to_fill_seconds", 0);
+        step.saturated = step.processed < options.saturation * rate || step.unprocessed > 0 || step.lost > 0;
+        steps.push_back(step);
+        before = after;
+
+        std::printf("%10.0f %10.0f %10.0f %9llu %8llu %10.1f %10.1f %10.2f%s\n", step.offered, step.sent, step.processed,
+                    static_cast<unsigned long long>(step.backlogAtEnd), static_cast<unsigned long long>(step.late),
+                    step.toSignal.p99Us, step.toFill.p99Us, step.drainSeconds, step.saturated ? "  saturated" : "");
+        if (step.saturated) {
+            break;
+        }
+    }
+    close(fd);
+    WriteReport(options, steps);
+    return 0;
+}
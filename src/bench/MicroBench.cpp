@@ -0,0 +1,278 @@
+// Microbenchmarks for the per-tick building blocks, written as JSON for run-to-run comparison.
+//   strategy/<name>   window.push_back + IStrategy::calculateAction, window sizes 10..10k
+//   tick_parse        TickParser::Parse, the work inside StrategyEngine::HandleMessage
+//   safe_queue/<N>p   SafeQueue enqueue + dequeue, N producer threads and one consumer
+//   spsc_ring         SpscRing push + pop between two threads, for reference
+//   executor/signal   signal queued + TradeExecutor::Poll (risk, order, book, fill, portfolio)
+// Every case is repeated; the JSON has the median and best ns/op of the repetitions.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../SpscRing.h"
+#include "../TickParser.h"
+#include "../TradeExecutor.h"
+#include "../TradeStrategy/BollingerBandsStrategy.h"
+#include "../TradeStrategy/MomentumRSIStrategy.h"
+#include "../TradeStrategy/SimpleMovingAverageStrategy.h"
+#include "../../util/Logger.h"
+#include "../../util/SafeQueue.h"
+
+LevelMapping customMappings = {
+    {Main,        "Main"},
+    {MarketData,  "Market Data"},
+    {Strategy,    "Strategy"},
+    {Execution,   "Trade Executor"},
+    {DEBUG,       "DEBUG"},
+    {INFO,        "INFO"},
+    {WARN,        "WARN"},
+    {ERROR,       "ERROR"}
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int REPETITIONS = 5;
+
+// Keeps results alive so the optimizer cannot drop the measured work
+volatile uint64_t g_sink = 0;
+
+struct Result
+{
+    std::string name;
+    uint64_t param;
+    uint64_t ops;
+    double medianNs;
+    double bestNs;
+};
+
+std::vector<Result> g_results;
+
+void Record(const std::string& name, uint64_t param, uint64_t ops, std::vector<double> nsPerOp)
+{
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+    const Result result{name, param, ops, nsPerOp[nsPerOp.size() / 2], nsPerOp.front()};
+    std::printf("%-28s %8llu %12.1f ns/op (best %.1f)\n", name.c_str(), static_cast<unsigned long long>(param),
+                result.medianNs, result.bestNs);
+    g_results.push_back(result);
+}
+
+// Runs 'batch' (which performs 'opsPerBatch' operations) until minTime has passed, REPETITIONS times
+void Measure(const std::string& name, uint64_t param, uint64_t opsPerBatch, std::chrono::milliseconds minTime,
+             const std::function<void()>& batch)
+{
+    batch();   // Warm-up: caches, branch predictors, lazy initialization
+    std::vector<double> nsPerOp;
+    uint64_t ops = 0;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        uint64_t repOps = 0;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        do {
+            batch();
+            repOps += opsPerBatch;
+            elapsed = Clock::now() - start;
+        } while (elapsed < minTime);
+        nsPerOp.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(repOps));
+        ops += repOps;
+    }
+    Record(name, param, ops, nsPerOp);
+}
+
+std::vector<double> RandomWalk(size_t count)
+{
+    std::vector<double> prices(count);
+    double price = 29500.0;
+    uint64_t state = 42;
+    for (double& p : prices) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        price += (static_cast<int>((state >> 33) % 201) - 100) / 100.0;
+        p = price;
+    }
+    return prices;
+}
+
+void BenchStrategies(std::chrono::milliseconds minTime)
+{
+    SimpleMovingAverageStrategy sma;
+    MomentumRSIStrategy rsi;
+    BollingerBandsStrategy bb;
+    const std::pair<const char*, const IStrategy*> strategies[] = {
+        {"strategy/sma", &sma}, {"strategy/momentum_rsi", &rsi}, {"strategy/bollinger", &bb}};
+    const std::vector<double> prices = RandomWalk(1 << 16);
+
+    for (size_t windowSize : {10, 100, 1000, 10000}) {
+        for (const auto& strategy : strategies) {
+            PriceWindow window(windowSize);
+            size_t next = 0;
+            for (size_t i = 0; i < windowSize; ++i) {
+                window.push_back(prices[next++ & (prices.size() - 1)]);
+            }
+            constexpr uint64_t BATCH = 256;
+            Measure(strategy.first, windowSize, BATCH, minTime, [&] {
+                uint64_t actions = 0;
+                for (uint64_t i = 0; i < BATCH; ++i) {
+                    window.push_back(prices[next++ & (prices.size() - 1)]);
+                    actions += static_cast<uint64_t>(strategy.second->calculateAction(window));
+                }
+                g_sink = g_sink + actions;
+            });
+        }
+    }
+}
+
+void BenchParse(std::chrono::milliseconds minTime)
+{
+    const std::vector<double> prices = RandomWalk(4096);
+    std::vector<std::string> messages;
+    char line[128];
+    for (size_t i = 0; i < prices.size(); ++i) {
+        std::snprintf(line, sizeof(line), "{\"symbol\": \"%s\", \"price\": %.2f, \"timestamp\": %.3f}",
+                      (i % 3 == 0) ? "BTC" : (i % 3 == 1) ? "ETH" : "SOL", prices[i], 1692284400.0 + i * 0.5);
+        messages.emplace_back(line);
+    }
+    TradeData tick;
+    Measure("tick_parse", 0, messages.size(), minTime, [&] {
+        uint64_t parsed = 0;
+        for (const std::string& message : messages) {
+            parsed += TickParser::Parse(message.data(), message.size(), tick) ? 1 : 0;
+        }
+        g_sink = g_sink + parsed;
+    });
+}
+
+// One consumer drains while 'producers' threads each enqueue 'perProducer' items; ns per item
+void BenchSafeQueue(std::chrono::milliseconds minTime, uint32_t producers)
+{
+    constexpr uint64_t PER_PRODUCER = 100000;
+    SafeQueue<ActionSignal> queue;
+    Measure("safe_queue/" + std::to_string(producers) + "p", producers, PER_PRODUCER * producers, minTime, [&] {
+        std::vector<std::thread> threads;
+        for (uint32_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue] {
+                ActionSignal signal(ActionType::BUY, 0, 1, 1, 0);
+                for (uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                    queue.enqueue(signal);
+                }
+            });
+        }
+        uint64_t received = 0;
+        int64_t checksum = 0;
+        while (received < PER_PRODUCER * producers) {
+            if (!queue.empty()) {
+                checksum += queue.dequeue().amount_;
+                ++received;
+            }
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        g_sink = g_sink + static_cast<uint64_t>(checksum);
+    });
+}
+
+void BenchSpscRing(std::chrono::milliseconds minTime)
+{
+    constexpr uint64_t ITEMS = 1000000;
+    SpscRing<ActionSignal> ring(4096);
+    Measure("spsc_ring", 1, ITEMS, minTime, [&] {
+        std::thread producer([&ring] {
+            ActionSignal signal(ActionType::BUY, 0, 1, 1, 0);
+            for (uint64_t i = 0; i < ITEMS; ++i) {
+                while (!ring.tryPush(signal)) {
+                }
+            }
+        });
+        ActionSignal signal;
+        int64_t checksum = 0;
+        for (uint64_t received = 0; received < ITEMS;) {
+            if (ring.tryPop(signal)) {
+                checksum += signal.amount_;
+                ++received;
+            }
+        }
+        producer.join();
+        g_sink = g_sink + static_cast<uint64_t>(checksum);
+    });
+}
+
+// Alternating BUY/SELL signals through the full executor path, journal disabled
+void BenchExecutor(std::chrono::milliseconds minTime)
+{
+    SystemContext ctx;
+    ctx.portfolio.reset("USD", toCashUnits(1e9));
+    const SymbolId symbol = SymbolTable::instance().intern("BTC");
+    const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+    const PriceTicks price = scale.toTicks(29500.0);
+    const QtyLots amount = scale.toLots(0.01);
+    TradeExecutor executor(ctx);
+
+    constexpr uint64_t BATCH = 64;
+    uint64_t sequence = 0;
+    Measure("executor/signal", 0, BATCH, minTime, [&] {
+        uint64_t handled = 0;
+        for (uint64_t i = 0; i < BATCH; ++i, ++sequence) {
+            ctx.marks.publish(symbol, price);
+            ActionSignal signal((sequence & 1) ? ActionType::SELL : ActionType::BUY, symbol, price, amount, 0);
+            ctx.actionSignal.queue.tryPush(signal);
+            handled += executor.Poll();
+        }
+        g_sink = g_sink + handled;
+    });
+}
+
+void WriteJson(const std::string& path, std::chrono::milliseconds minTime)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        std::fprintf(stderr, "cannot write %s\n", path.c_str());
+        return;
+    }
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    std::fprintf(file, "{\n  \"date\": \"%s\",\n  \"compiler\": \"%s\",\n  \"hardware_threads\": %u,\n"
+                       "  \"min_time_ms\": %lld,\n  \"repetitions\": %d,\n  \"results\": [\n",
+                 date, __VERSION__, std::thread::hardware_concurrency(),
+                 static_cast<long long>(minTime.count()), REPETITIONS);
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const Result& r = g_results[i];
+        std::fprintf(file, "    {\"name\": \"%s\", \"param\": %llu, \"ops\": %llu, \"ns_per_op\": %.2f, \"best_ns_per_op\": %.2f}%s\n",
+                     r.name.c_str(), static_cast<unsigned long long>(r.param), static_cast<unsigned long long>(r.ops),
+                     r.medianNs, r.bestNs, (i + 1 < g_results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+    std::printf("Results written to %s\n", path.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string output = (argc > 1) ? argv[1] : "micro_bench.json";
+    const std::chrono::milliseconds minTime((argc > 2) ? std::atoi(argv[2]) : 200);
+
+    LOGINIT(customMappings);
+    Logger::getInstance().setLevel(CustomerLogLevel::ERROR);
+
+    BenchStrategies(minTime);
+    BenchParse(minTime);
+    for (uint32_t producers : {1u, 2u, 4u}) {
+        BenchSafeQueue(minTime, producers);
+    }
+    BenchSpscRing(minTime);
+    BenchExecutor(minTime);
+
+    WriteJson(output, minTime);
+    return 0;
+}
@@ -1,12 +1,23 @@
 #include <iostream>
 #include <thread>
 #include <memory>
+#include <vector>
 #include <csignal>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
 
 #include "StrategyEngine.h"
 #include "TradeExecutor.h"
 #include "ConfigManager.h"
+#include "RuntimeConfig.h"
 #include "SystemContext.h"
+#include "TickLog.h"
+#include "CsvTickSource.h"
+#include "ThreadPlacement.h"
+#include "Metrics.h"
+#include "MetricsServer.h"
+#include "Telemetry.h"
 #include "../util/PlatformUtils.h"
 
 // Thread function declarations
@@ -45,6 +56,11 @@ class SystemManager {
 public:
     SystemManager() : stopFilePath_("./stop"){}
 
+    // Replay mode: recorded ticks instead of the socket feed (set before startUp)
+    void setReplayPath(const std::string& path) { replayPath_ = path; }
+    // Loaded in order, later files override earlier keys; default ../config/config.cfg
+    void addConfigPath(const std::string& path) { configPaths_.push_back(path); }
+
     bool checkStopFile() const 
     {
         PlatformUtils::flushConsole(); // Cross-platform flush output
@@ -66,11 +82,148 @@ public:
     void startUp() 
     {
         auto& config = ConfigManager::instance();
-        config.load("../config/config.cfg");
+        if (configPaths_.empty()) {
+            configPaths_.push_back("../config/config.cfg");
+        }
+        for (const std::string& path : configPaths_) {
+            if (!config.load(path)) {
+                std::cerr << "[CONFIG] Cannot read " << path << ", using defaults for its keys" << std::endl;
+            }
+        }
+
+        // History sizes, trade size, throttles and risk limits: parsed once into a snapshot
+        // the engine reads per tick, replaced as a whole by the config watcher
+        const RuntimeConfig& runtime = ctx_.config.publish(RuntimeConfig::parse(config));
+        reloadConfig_ = config.get("CONFIG_RELOAD", 0) != 0;
 
         ctx_.initialCash = config.get("DEFAULT_CASH", 10000.0);
-        ctx_.maxHistory = static_cast<uint32_t>(config.get("MAX_HISTORY", 70));
-        ctx_.minHistory = static_cast<uint32_t>(config.get("MIN_HISTORY", 10));
+        const std::string baseCurrency = config.getString("BASE_CURRENCY", "USD");
+        ctx_.portfolio.reset(baseCurrency.c_str(), toCashUnits(ctx_.initialCash));
+
+        // Live feed sequence gaps: ask the feeder for a replay, or rebuild the symbol's window
+        ctx_.feedSequencing.policy = config.getString("FEED_GAP_POLICY", "replay") == "rebuild"
+            ? FeedGapPolicy::REBUILD : FeedGapPolicy::REPLAY;
+        ctx_.feedSequencing.replayTimeoutMs = static_cast<uint32_t>(config.get("FEED_REPLAY_TIMEOUT_MS", 1000));
+        ctx_.feedConflation = config.get("FEED_CONFLATION", 0) != 0;
+        ctx_.feedBatch = config.get("FEED_BATCH", 0) != 0;
+        ctx_.feedBatchPerTick = config.getString("FEED_BATCH_EVAL", "symbol") == "tick";
+
+        // I/O backend of the feed socket, journal and tick recorder; each falls back to its
+        // POSIX path if io_uring is not built in (USE_IO_URING=1) or the kernel refuses it
+        ctx_.ioUring = config.getString("IO_BACKEND", "posix") == "uring";
+
+        // UDP multicast instead of the TCP listener; there is no channel back to the publisher
+        ctx_.feedMulticast = config.getString("FEED_TRANSPORT", "tcp") == "udp";
+        ctx_.multicastFeed.group = config.getString("FEED_MULTICAST_GROUP", "239.255.0.1");
+        ctx_.multicastFeed.port = static_cast<uint16_t>(config.get("FEED_MULTICAST_PORT", 9999));
+        ctx_.multicastFeed.interfaceAddress = config.getString("FEED_MULTICAST_INTERFACE", "127.0.0.1");
+        ctx_.multicastFeed.batch = static_cast<uint32_t>(config.get("FEED_MULTICAST_BATCH", 64));
+        ctx_.multicastFeed.datagramBytes = static_cast<uint32_t>(config.get("FEED_MULTICAST_DATAGRAM_BYTES", 2048));
+        ctx_.multicastFeed.receiveBufferBytes = static_cast<uint32_t>(config.get("FEED_MULTICAST_RCVBUF", 4194304));
+        ctx_.multicastFeed.ioUring = ctx_.ioUring;
+        if (ctx_.feedMulticast && ctx_.feedSequencing.policy == FeedGapPolicy::REPLAY) {
+            // Lost datagrams cannot be requested again: rebuild the symbol's window on a gap
+            ctx_.feedSequencing.policy = FeedGapPolicy::REBUILD;
+        }
+
+        // OHLCV bar series per symbol, e.g. "1s,1m,5m,100t,10v"; a bar strategy adds its own
+        std::vector<BarSpec> barSpecs;
+        std::stringstream barList(config.getString("BAR_SERIES", ""));
+        std::string barName;
+        while (std::getline(barList, barName, ',')) {
+            BarSpec spec;
+            if (BarSpec::parse(barName, spec)) {
+                barSpecs.push_back(spec);
+            } else if (!barName.empty()) {
+                std::cerr << "[WARN] BAR_SERIES: ignoring \"" << barName << "\"\n";
+            }
+        }
+        ctx_.bars.configure(barSpecs, static_cast<size_t>(config.get("BAR_HISTORY", 500)));
+
+        // Fixed-point scales for execution/accounting (units per 1.0 of price / quantity)
+        InstrumentScale defaultScale;
+        defaultScale.priceScale = static_cast<int64_t>(config.get("PRICE_SCALE", 100));
+        defaultScale.qtyScale = static_cast<int64_t>(config.get("QTY_SCALE", 100000000));
+        SymbolTable::instance().setDefaultScale(defaultScale);
+
+        // Simulated exchange: synthetic depth around each signal price
+        ctx_.liquidity.levels = static_cast<uint32_t>(config.get("SIM_BOOK_LEVELS", 10));
+        ctx_.liquidity.spreadTicks = static_cast<PriceTicks>(config.get("SIM_SPREAD_TICKS", 2));
+        ctx_.liquidity.depthPerLevel = config.get("SIM_DEPTH_PER_LEVEL", 0.05);
+        ctx_.slippageTicks = static_cast<PriceTicks>(config.get("SIM_SLIPPAGE_TICKS", 5));
+        ctx_.orderPoolSize = static_cast<uint32_t>(config.get("ORDER_POOL_SIZE", 8192));
+        ctx_.orderPoolMax = static_cast<uint32_t>(config.get("ORDER_POOL_MAX", 65536));
+
+        // Pre-trade risk limits (0 disables a check); converted to fixed point here and on reloads
+        ctx_.risk.configure(runtime.risk);
+
+        // Write-ahead journal; recovery runs below once the executor exists
+        JournalConfig journalConfig;
+        journalConfig.enabled = config.get("JOURNAL_ENABLED", 0) != 0;
+        journalConfig.directory = config.getString("JOURNAL_DIR", "journal");
+        journalConfig.sync = config.get("JOURNAL_FSYNC", 1) != 0;
+        journalConfig.snapshotEvery = static_cast<uint64_t>(config.get("JOURNAL_SNAPSHOT_EVERY", 10000));
+        journalConfig.ioUring = ctx_.ioUring;
+        ctx_.journal.configure(journalConfig);
+
+        // Warm start of the strategy windows; loaded below once the engine exists
+        WindowCheckpointConfig checkpointConfig;
+        checkpointConfig.enabled = config.get("WARM_START_ENABLED", 0) != 0;
+        checkpointConfig.path = config.getString("WARM_START_FILE", "warmstart.bin");
+        checkpointConfig.intervalSec = static_cast<uint32_t>(config.get("WARM_START_INTERVAL_SEC", 30));
+        checkpointConfig.maxAgeSec = static_cast<uint32_t>(config.get("WARM_START_MAX_AGE_SEC", 300));
+        ctx_.checkpoint.configure(checkpointConfig);
+
+        // Tick recorder on the ingest path
+        TickRecorderConfig recorderConfig;
+        recorderConfig.enabled = config.get("TICK_RECORD_ENABLED", 0) != 0;
+        recorderConfig.log.directory = config.getString("TICK_RECORD_DIR", "ticks");
+        recorderConfig.log.rotateBytes = static_cast<uint64_t>(config.get("TICK_RECORD_ROTATE_MB", 64)) << 20;
+        recorderConfig.log.maxFiles = static_cast<uint32_t>(config.get("TICK_RECORD_MAX_FILES", 0));
+        recorderConfig.log.compress = config.get("TICK_RECORD_ZSTD", 0) != 0;
+        recorderConfig.log.compressionLevel = static_cast<int>(config.get("TICK_RECORD_ZSTD_LEVEL", 3));
+        recorderConfig.log.ioUring = ctx_.ioUring;
+        ctx_.recorder.configure(recorderConfig);
+
+        // Prometheus endpoint; counters and histograms are always kept, this only serves them
+        MetricsServerConfig metricsConfig;
+        metricsConfig.port = static_cast<uint16_t>(config.get("METRICS_PORT", 0));
+        metricsConfig.bindAddress = config.getString("METRICS_BIND", "127.0.0.1");
+        metricsServer_.configure(metricsConfig);
+
+        // Shared-memory telemetry page for external samplers
+        TelemetryConfig telemetryConfig;
+        telemetryConfig.enabled = config.get("TELEMETRY_ENABLED", 0) != 0;
+        telemetryConfig.name = config.getString("TELEMETRY_SHM_NAME", "/trading_telemetry");
+        telemetryConfig.intervalMs = static_cast<uint32_t>(config.get("TELEMETRY_INTERVAL_MS", 100));
+        telemetry_.configure(telemetryConfig);
+
+        // A replay is a backtest: it must neither extend the live journal and
+        // checkpoint nor re-record the ticks it reads
+        if (!replayPath_.empty()) {
+            ctx_.journal.configure(JournalConfig());
+            ctx_.checkpoint.configure(WindowCheckpointConfig());
+            ctx_.recorder.configure(TickRecorderConfig());
+            reloadConfig_ = false;   // Same parameters from the first tick to the last
+
+            // Replays run on tick time: flat out (0) or paced at REPLAY_SPEED x the recorded rate
+            const double replaySpeed = config.get("REPLAY_SPEED", 0.0);
+            if (replaySpeed > 0.0) {
+                ctx_.clock = std::make_unique<AcceleratedClock>(replaySpeed);
+            } else {
+                ctx_.clock = std::make_unique<SimulatedClock>();
+            }
+        }
+
+        // CPU placement per thread role. The main thread applies its own before the logger
+        // starts, so the logger and other threads without a role inherit the housekeeping CPUs
+        configurePlacement(ThreadRole::MAIN, "THREAD_MAIN");
+        configurePlacement(ThreadRole::STRATEGY, "THREAD_STRATEGY");
+        configurePlacement(ThreadRole::INGEST, "THREAD_INGEST");
+        configurePlacement(ThreadRole::EXECUTOR, "THREAD_EXECUTOR");
+        configurePlacement(ThreadRole::JOURNAL, "THREAD_JOURNAL");
+        configurePlacement(ThreadRole::RECORDER, "THREAD_RECORDER");
+        ThreadPlacement::instance().apply(ThreadRole::MAIN);
 
         int levelInt = static_cast<int>(config.get("LOG_LEVEL", 0));
         CustomerLogLevel selectedLevel = static_cast<CustomerLogLevel>(levelInt);
@@ -78,22 +231,55 @@ public:
         // 2. Initialize logs
         LOGINIT(customMappings);
         Logger::getInstance().setLevel(selectedLevel);
+        // Formats into one pre-sized string instead of a std::stringstream per message
         Logger::getInstance().setFormatter([](const LogMessage& msg) {
-          std::stringstream ss;
-          ss << msg.levelName << " :: " << msg.message;
-          return ss.str();
-        });
-        
-        Logger::getInstance().setFormatter([](const LogMessage& msg) {
-          std::stringstream ss;
+          char timeBuf[32];
           auto now_c = std::chrono::system_clock::to_time_t(msg.timestamp);
-          ss << std::put_time(std::localtime(&now_c), "%Y-%m-%d %H:%M:%S") << " :: ";
-          ss << msg.levelName << " :: " << msg.message;
-          return ss.str();
+          size_t timeLen = std::strftime(timeBuf, sizeof(timeBuf), "%Y-%m-%d %H:%M:%S", std::localtime(&now_c));
+
+          std::string out;
+          out.reserve(timeLen + msg.levelName.size() + msg.message.size() + 8);
+          out.append(timeBuf, timeLen).append(" :: ");
+          out.append(msg.levelName).append(" :: ").append(msg.message);
+          return out;
         });
 
         strategyEngine_ = std::make_shared<StrategyEngine>(ctx_);
+        strategyEngine_->WarmStart();
+        ctx_.checkpoint.start();
         tradeExecutor_  = std::make_shared<TradeExecutor>(ctx_);
+        if (!tradeExecutor_->Recover() || !ctx_.journal.start()) {
+            LOG(ERROR) << "Journal recovery failed, starting without a journal";
+            ctx_.journal.configure(JournalConfig());
+        }
+
+        if (!ctx_.recorder.start()) {
+            LOG(ERROR) << "Tick recorder failed to start, ticks will not be recorded";
+            ctx_.recorder.configure(TickRecorderConfig());
+        }
+
+        registerGauges();
+        if (!metricsServer_.start()) {
+            LOG(ERROR) << "Metrics: cannot listen on " << metricsConfig.bindAddress << ":" << metricsConfig.port
+                       << ", metrics will not be served";
+        }
+        if (!telemetry_.start([this](TelemetryData& data) { readTelemetryState(data); })) {
+            LOG(ERROR) << "Telemetry: cannot create shared memory " << telemetryConfig.name
+                       << ", telemetry will not be published";
+        }
+
+        if (reloadConfig_) {
+            configWatcher_.start(configPaths_, config, ctx_.config);
+        }
+
+        if (!replayPath_.empty()) {
+            replaySource_ = OpenTickSource(replayPath_);
+            if (!replaySource_) {
+                LOG(ERROR) << "Replay: no readable tick log or CSV at " << replayPath_;
+                ctx_.state.brokenFlag.store(true, std::memory_order_release);
+            }
+            LOG(Main) << "Replay mode: " << replayPath_;
+        }
 
         removeStopFile();
         LOG(Main) << "SystemManager: StartUp complete.";
@@ -103,15 +289,43 @@ public:
     void run() 
     {
         // Assign threads to member variables so shutDown can access them at any time
-        strategyThread_ = std::thread(&StrategyEngine::ProcessMarketDataAndGenerateSignals, strategyEngine_.get());
-        tradeThread_ = std::thread(&TradeExecutor::RunTradeExecutionLoop, tradeExecutor_.get());
+        if (replaySource_) {
+            // Deterministic: the executor is polled after every tick on the replay thread,
+            // so marks, risk checks and fills see exactly the same sequence on every run
+            TradeExecutor* executor = tradeExecutor_.get();
+            strategyThread_ = std::thread([this, executor] {
+                ThreadPlacement::instance().apply(ThreadRole::STRATEGY);
+                strategyEngine_->ReplayTicks(*replaySource_, [executor] { executor->Poll(); });
+                executor->Finish();
+            });
+        } else {
+            strategyThread_ = std::thread(&StrategyEngine::ProcessMarketDataAndGenerateSignals, strategyEngine_.get());
+            tradeThread_ = std::thread(&TradeExecutor::RunTradeExecutionLoop, tradeExecutor_.get());
+        }
+
+        uint32_t placed = (1u << static_cast<uint32_t>(ThreadRole::MAIN)) |
+                          (1u << static_cast<uint32_t>(ThreadRole::STRATEGY));
+        if (!replaySource_) {
+            placed |= 1u << static_cast<uint32_t>(ThreadRole::EXECUTOR);
+            if (strategyEngine_->conflating()) {
+                placed |= 1u << static_cast<uint32_t>(ThreadRole::INGEST);
+            }
+        }
+        if (ctx_.journal.enabled()) {
+            placed |= 1u << static_cast<uint32_t>(ThreadRole::JOURNAL);
+        }
+        if (ctx_.recorder.enabled()) {
+            placed |= 1u << static_cast<uint32_t>(ThreadRole::RECORDER);
+        }
+        ThreadPlacement::instance().logReport(placed, std::chrono::milliseconds(1000));
 
         LOG(Main) << "Threads started. Entering monitoring loop...";
+        auto lastPnlReport = std::chrono::steady_clock::now();
 
         {
             std::unique_lock<std::mutex> lock(ctx_.state.brokenMutex);
             // Monitoring loop: Until time is up, external stop, or system crash
-            while (!ctx_.state.brokenFlag.load() && !g_external_stop.load()) {
+            while (!ctx_.state.brokenFlag.load() && !g_external_stop.load() && !ctx_.state.feedFinished.load()) {
                 if (checkStopFile()) {
                     LOG(Main) << "Stop file detected: " << stopFilePath_;
                     std::cout << "[DEBUG] run: Stop file detected!" << std::endl;
@@ -119,6 +333,15 @@ public:
                 }
 
                 ctx_.state.brokenCV.wait_for(lock, std::chrono::milliseconds(500));
+                ctx_.risk.logRejections();
+                logTrades();
+                // Interval from the current snapshot, so a reload applies to the next report
+                const std::chrono::seconds pnlInterval(ctx_.config.current().pnlReportIntervalSec);
+                const auto now = std::chrono::steady_clock::now();
+                if (pnlInterval.count() > 0 && now >= lastPnlReport + pnlInterval) {
+                    logPnl();
+                    lastPnlReport = now;
+                }
             }
         }
         
@@ -152,14 +375,150 @@ public:
             LOG(Main) << "StrategyEngine thread joined.";
         }
 
-        double price = tradeExecutor_->GetCurrentPrice();
-        tradeExecutor_->DisplayPortfolioStatus(price);
+        // 5. The feed is closed: write out the last price windows and recorded ticks
+        ctx_.checkpoint.stop();
+        if (ctx_.checkpoint.skipped() > 0) {
+            LOG(WARN) << "Checkpoint: " << ctx_.checkpoint.skipped() << " saves skipped behind a slow write";
+        }
+        if (ctx_.recorder.enabled()) {
+            ctx_.recorder.stop();
+            LOG(Main) << "Tick recorder: " << ctx_.recorder.recorded() << " ticks in " << ctx_.recorder.bytes()
+                      << " bytes over " << ctx_.recorder.files() << " files, " << ctx_.recorder.dropped() << " dropped";
+        }
+
+        // 6. The executor has written its final snapshot: drain and sync the journal
+        if (ctx_.journal.enabled()) {
+            ctx_.journal.stop();
+            LOG(Main) << "Journal closed at record " << ctx_.journal.durableSequence()
+                      << " (" << ctx_.journal.groupCommits() << " group commits, "
+                      << ctx_.journal.producerStalls() << " producer stalls)";
+        }
+
+        configWatcher_.stop();
+        metricsServer_.stop();
+        telemetry_.stop();
+
+        logTrades();
+        tradeExecutor_->DisplayPortfolioStatus();
+        logRiskSummary();
         removeStopFile();
         LOG(Main) << "SystemManager: ShutDown complete.";
         PlatformUtils::flushConsole();
     }
 
 private:
+    // <prefix>_CPUS ("2", "2,3", "4-7"; empty: not pinned) and <prefix>_FIFO_PRIORITY (0: default policy)
+    static void configurePlacement(ThreadRole role, const std::string& prefix)
+    {
+        auto& config = ConfigManager::instance();
+        ThreadPlacementConfig placement;
+        placement.cpus = ThreadPlacement::parseCpuList(config.getString(prefix + "_CPUS", ""));
+        if (!config.getString(prefix + "_FIFO_PRIORITY", "").empty()) {
+            placement.fifoPriority = static_cast<int>(config.get(prefix + "_FIFO_PRIORITY", 0));
+        }
+        ThreadPlacement::instance().configure(role, placement);
+    }
+
+    // Queued = emitted - processed. The counters are summed one after the other while both
+    // threads run, so a signal taken in between can put processed ahead: clamp, never wrap
+    static int64_t signalQueueDepth(uint64_t signals, uint64_t processed)
+    {
+        return signals > processed ? static_cast<int64_t>(signals - processed) : 0;
+    }
+
+    // Scrape-time values next to the per-thread counters; all reads are lock-free
+    void registerGauges()
+    {
+        Metrics& metrics = Metrics::instance();
+        metrics.addGauge("signal_queue_depth", "Signals queued and not yet taken by the executor",
+                         [](const MetricsSnapshot& snap) {
+                             return static_cast<double>(signalQueueDepth(snap.counter(MetricCounter::SIGNALS),
+                                                                         snap.counter(MetricCounter::SIGNALS_PROCESSED)));
+                         });
+        metrics.addGauge("journal_queue_depth", "Journal records not yet written",
+                         [this](const MetricsSnapshot&) { return static_cast<double>(ctx_.journal.pending()); });
+        metrics.addGauge("tick_recorder_queue_depth", "Ticks waiting for the recorder thread",
+                         [this](const MetricsSnapshot&) { return static_cast<double>(ctx_.recorder.pending()); });
+        metrics.addGauge("tick_recorder_dropped", "Ticks the recorder dropped because its queue was full",
+                         [this](const MetricsSnapshot&) { return static_cast<double>(ctx_.recorder.dropped()); });
+
+        // P&L in the base currency, as maintained by the portfolio on every fill and mark
+        struct PnlGauge
+        {
+            const char* name;
+            const char* help;
+            CashUnits PnlSummary::*field;
+        };
+        static const PnlGauge pnlGauges[] = {
+            {"equity", "Portfolio equity in the base currency", &PnlSummary::equity},
+            {"realized_pnl", "Realized P&L in the base currency", &PnlSummary::realized},
+            {"unrealized_pnl", "Unrealized P&L at the marks, in the base currency", &PnlSummary::unrealized},
+            {"high_water_mark", "Highest equity so far", &PnlSummary::highWaterMark},
+            {"drawdown", "High-water mark minus equity", &PnlSummary::drawdown},
+            {"max_drawdown", "Largest drawdown so far", &PnlSummary::maxDrawdown},
+            {"gross_exposure", "Sum of absolute position notionals at the marks", &PnlSummary::grossExposure},
+        };
+        for (const PnlGauge& gauge : pnlGauges) {
+            metrics.addGauge(gauge.name, gauge.help, [this, field = gauge.field](const MetricsSnapshot&) {
+                return fromCashUnits(ctx_.portfolio.snapshot().pnl.*field);
+            });
+        }
+    }
+
+    // Telemetry publisher thread; counters are already filled in
+    void readTelemetryState(TelemetryData& data)
+    {
+        const size_t signalCounter = static_cast<size_t>(MetricCounter::SIGNALS);
+        const size_t processedCounter = static_cast<size_t>(MetricCounter::SIGNALS_PROCESSED);
+        data.queueDepths[static_cast<size_t>(TelemetryQueue::SIGNAL)] =
+            signalQueueDepth(data.counters[signalCounter], data.counters[processedCounter]);
+        data.queueDepths[static_cast<size_t>(TelemetryQueue::JOURNAL)] = static_cast<int64_t>(ctx_.journal.pending());
+        data.queueDepths[static_cast<size_t>(TelemetryQueue::RECORDER)] = static_cast<int64_t>(ctx_.recorder.pending());
+        data.recorderDropped = ctx_.recorder.dropped();
+
+        const PortfolioState state = ctx_.portfolio.snapshot();
+        data.totalTrades = state.totalTrades;
+        data.buyTrades = state.buyTrades;
+        data.sellTrades = state.sellTrades;
+        data.equity = fromCashUnits(state.pnl.equity);
+        data.realizedPnl = fromCashUnits(state.pnl.realized);
+        data.unrealizedPnl = fromCashUnits(state.pnl.unrealized);
+        data.maxDrawdown = fromCashUnits(state.pnl.maxDrawdown);
+    }
+
+    // Live P&L from the portfolio snapshot; already maintained per tick, nothing is recomputed
+    void logPnl()
+    {
+        const PnlSummary pnl = ctx_.portfolio.snapshot().pnl;
+        LOG(Main) << "P&L: equity " << std::fixed << std::setprecision(2) << fromCashUnits(pnl.equity)
+                  << " realized " << fromCashUnits(pnl.realized)
+                  << " unrealized " << fromCashUnits(pnl.unrealized)
+                  << " hwm " << fromCashUnits(pnl.highWaterMark)
+                  << " drawdown " << fromCashUnits(pnl.drawdown)
+                  << " maxDD " << fromCashUnits(pnl.maxDrawdown)
+                  << " exposure " << fromCashUnits(pnl.grossExposure)
+                  << " marks " << pnl.markUpdates;
+    }
+
+    // Signal and order lines queued by the strategy and executor threads
+    void logTrades()
+    {
+        ctx_.signalLog.write();
+        ctx_.executionLog.write();
+    }
+
+    void logRiskSummary()
+    {
+        ctx_.risk.logRejections();
+        LOG(Main) << "Risk: accepted " << ctx_.risk.accepted()
+                  << ", rejected killSwitch=" << ctx_.risk.rejected(RiskReason::KILL_SWITCH)
+                  << " collar=" << ctx_.risk.rejected(RiskReason::PRICE_COLLAR)
+                  << " notional=" << ctx_.risk.rejected(RiskReason::ORDER_NOTIONAL)
+                  << " position=" << ctx_.risk.rejected(RiskReason::POSITION_LIMIT)
+                  << " throttle=" << ctx_.risk.rejected(RiskReason::THROTTLE)
+                  << (ctx_.risk.killed() ? " [KILL SWITCH ACTIVE]" : "");
+    }
+
     SystemContext ctx_;
     std::shared_ptr<StrategyEngine> strategyEngine_;
     std::shared_ptr<TradeExecutor> tradeExecutor_;
@@ -167,15 +526,88 @@ private:
     // Defined as member variables to solve local scope access issues
     std::thread strategyThread_;
     std::thread tradeThread_;
+    MetricsServer metricsServer_;
+    TelemetryPublisher telemetry_;
+    ConfigWatcher configWatcher_;
     
     std::string stopFilePath_;
+    std::string replayPath_;
+    std::vector<std::string> configPaths_;
+    std::unique_ptr<ITickSource> replaySource_;
+    bool reloadConfig_ = false;   // CONFIG_RELOAD: watch configPaths_ and publish changes
 };
 
+/**
+ * @brief Offline conversion of a CSV file or tick log into the binary tick store; no trading
+ * Prices are quantized with the configured PRICE_SCALE, as the recorder does; the config
+ * files are the same as the engine's (--config, default ../config/config.cfg).
+ */
+int convertTicks(const std::string& input, const std::string& outputDir, const std::vector<std::string>& configPaths)
+{
+    auto& config = ConfigManager::instance();
+    for (const std::string& path : configPaths) {
+        config.load(path);
+    }
+    InstrumentScale defaultScale;
+    defaultScale.priceScale = static_cast<int64_t>(config.get("PRICE_SCALE", 100));
+    defaultScale.qtyScale = static_cast<int64_t>(config.get("QTY_SCALE", 100000000));
+    SymbolTable::instance().setDefaultScale(defaultScale);
+    LOGINIT(customMappings);
+
+    std::unique_ptr<ITickSource> source = OpenTickSource(input);
+    TickLogConfig logConfig;
+    logConfig.directory = outputDir;
+    logConfig.rotateBytes = static_cast<uint64_t>(config.get("TICK_RECORD_ROTATE_MB", 64)) << 20;
+    logConfig.compress = config.get("TICK_RECORD_ZSTD", 0) != 0;
+    logConfig.compressionLevel = static_cast<int>(config.get("TICK_RECORD_ZSTD_LEVEL", 3));
+    TickLogWriter writer;
+    if (!source || !writer.open(logConfig)) {
+        LOG(ERROR) << "Convert: cannot read " << input << " or write " << outputDir;
+        return 1;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    TradeData tick;
+    while (source->Next(tick)) {
+        writer.write(tick);
+    }
+    writer.close();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    const auto* csv = dynamic_cast<const CsvTickSource*>(source.get());
+    LOG(Main) << "Converted " << writer.ticks() << " ticks into " << writer.bytes() << " bytes ("
+              << writer.files() << " files) in " << std::fixed << std::setprecision(3) << seconds << " s"
+              << (csv ? ", skipped " + std::to_string(csv->malformedRows()) + " malformed rows" : std::string());
+    return 0;
+}
+
 // --- Main Function ---
 
-int main() 
+int main(int argc, char* argv[])
 {
     SystemManager manager;
+
+    // --replay <.csv file, tick log, or directory of tick logs>
+    // --convert <.csv file or tick log> <output directory>
+    // --config <file>, repeatable: later files override earlier ones
+    std::vector<std::string> configPaths;
+    int convertAt = 0;
+    for (int i = 1; i + 1 < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--replay") {
+            manager.setReplayPath(argv[i + 1]);
+        } else if (arg == "--config") {
+            manager.addConfigPath(argv[i + 1]);
+            configPaths.push_back(argv[i + 1]);
+        } else if (arg == "--convert" && i + 2 < argc && convertAt == 0) {
+            convertAt = i;
+        }
+    }
+    if (convertAt != 0) {
+        if (configPaths.empty()) {
+            configPaths.push_back("../config/config.cfg");
+        }
+        return convertTicks(argv[convertAt + 1], argv[convertAt + 2], configPaths);
+    }
     
     // Register signal handler
     signal(SIGINT, signalHandler); 
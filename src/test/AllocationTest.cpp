@@ -0,0 +1,253 @@
+// Allocation-counting harness for the steady-state tick path.
+// Global operator new is replaced so every heap allocation made while a tick
+// is processed is counted. Ticks run through the production path, as in a
+// replay: parser, StrategyEngine (bars, risk gate, marks, strategy), the signal
+// ring, and TradeExecutor::Poll (order manager, order book, portfolio). The run
+// fails if a tick that raises no signal allocates at all. Ticks with signals are
+// only reported: their log lines go through the util Logger, outside the harness.
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../TickParser.h"
+#include "../TickSource.h"
+#include "../StrategyEngine.h"
+#include "../TradeExecutor.h"
+#include "../TradeStrategy/MomentumRSIStrategy.h"
+#include "../TradeStrategy/BollingerBandsStrategy.h"
+
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+LevelMapping customMappings = {
+    {Main,        "Main"},
+    {MarketData,  "Market Data"},
+    {Strategy,    "Strategy"},
+    {Execution,   "Trade Executor"},
+    {DEBUG,       "DEBUG"},
+    {INFO,        "INFO"},
+    {WARN,        "WARN"},
+    {ERROR,       "ERROR"}
+};
+
+namespace {
+
+constexpr size_t MAX_HISTORY = 70;
+constexpr size_t WARMUP_TICKS = 200;
+constexpr size_t MEASURED_TICKS = 20000;
+
+// Two overlapping waves so every strategy crosses its thresholds regularly
+double PriceAt(size_t i)
+{
+    return 29500.0 + 150.0 * std::sin(i * 0.21) + 60.0 * std::sin(i * 0.05);
+}
+
+// Same wire format MarketFetch.py produces; built before measurement starts
+std::vector<std::string> BuildMessages(size_t count)
+{
+    std::vector<std::string> messages;
+    messages.reserve(count);
+    char line[128];
+    for (size_t i = 0; i < count; ++i) {
+        std::snprintf(line, sizeof(line),
+                      "{\"symbol\": \"BTC\", \"price\": %.2f, \"volume\": %.2f, \"timestamp\": %.3f}",
+                      PriceAt(i), 0.25 + (i % 4) * 0.5, 1692284400.0 + i * 0.5);
+        messages.emplace_back(line);
+    }
+    return messages;
+}
+
+bool CheckParser()
+{
+    TradeData data;
+    const std::string good = "{\"symbol\": \"BTC\", \"price\": 29847.52, \"timestamp\": 1692284400.123}";
+    if (!TickParser::Parse(good.data(), good.size(), data) ||
+        data.price_ != 29847.52 || data.timestamp_ms_ != 1692284400123LL || data.symbol_ != SymbolTable::instance().find("BTC", 3))
+    {
+        std::printf("FAIL: parser did not decode a well-formed message\n");
+        return false;
+    }
+    const std::string bad = "{\"symbol\": \"BTC\", \"price\": \"n/a\"}";
+    if (TickParser::Parse(bad.data(), bad.size(), data)) {
+        std::printf("FAIL: parser accepted a malformed message\n");
+        return false;
+    }
+    return true;
+}
+
+// Feed messages parsed the way the socket path parses them
+class MessageSource : public ITickSource
+{
+public:
+    MessageSource(const std::vector<std::string>& messages, size_t begin, size_t end)
+        : messages_(messages), next_(begin), end_(end)
+    {
+    }
+
+    bool Next(TradeData& tick) override
+    {
+        while (next_ < end_) {
+            const std::string& message = messages_[next_++];
+            if (TickParser::Parse(message.data(), message.size(), tick)) {
+                return true;
+            }
+            ++failures_;
+        }
+        return false;
+    }
+
+    size_t failures() const { return failures_; }
+
+private:
+    const std::vector<std::string>& messages_;
+    size_t next_;
+    const size_t end_;
+    size_t failures_ = 0;
+};
+
+} // namespace
+
+int main()
+{
+    LOGINIT(customMappings);
+    Logger::getInstance().setLevel(CustomerLogLevel::ERROR);
+
+    if (!CheckParser()) {
+        return 1;
+    }
+
+    const std::vector<std::string> messages = BuildMessages(WARMUP_TICKS + MEASURED_TICKS);
+
+    SystemContext ctx;
+    ctx.initialCash = 1e6;
+    ctx.portfolio.reset("USD", toCashUnits(ctx.initialCash));
+    RuntimeConfig config;
+    config.maxHistory = MAX_HISTORY;
+    ctx.config.publish(config);
+
+    // Every tick also feeds time, tick and volume bars; their series exist after warm-up
+    std::vector<BarSpec> barSpecs;
+    for (const char* name : {"1s", "1m", "20t", "5v"}) {
+        barSpecs.emplace_back();
+        BarSpec::parse(name, barSpecs.back());
+    }
+    ctx.bars.configure(barSpecs, 100);
+    size_t barsClosed = 0;
+    for (size_t i = 0; i < barSpecs.size(); ++i) {
+        ctx.bars.subscribe(i, [&barsClosed](SymbolId, const BarSeries&) { ++barsClosed; });
+    }
+
+    StrategyEngine engine(ctx);
+    TradeExecutor executor(ctx);
+
+    // Allocations since the previous tick, split by whether the tick raised signals.
+    // Warm-up fills the window and creates the symbol's book, bars and order pool slabs.
+    // The trade logs are written out between ticks, as the monitor loop does, and not counted
+    size_t ticks = 0;
+    size_t mark = 0;
+    size_t quietTicks = 0;
+    size_t quietAllocations = 0;
+    size_t signals = 0;
+    size_t signalAllocations = 0;
+    auto afterTick = [&] {
+        const size_t handled = executor.Poll();
+        const size_t now = g_allocations.load();
+        if (++ticks == WARMUP_TICKS) {
+            barsClosed = 0;
+        } else if (ticks > WARMUP_TICKS) {
+            if (handled == 0) {
+                ++quietTicks;
+                quietAllocations += now - mark;
+            } else {
+                signals += handled;
+                signalAllocations += now - mark;
+            }
+        }
+        ctx.signalLog.write();
+        ctx.executionLog.write();
+        mark = g_allocations.load();
+    };
+
+    // Keep the replay's log lines off the report
+    std::cout.setstate(std::ios_base::badbit);
+    MessageSource source(messages, 0, messages.size());
+    engine.ReplayTicks(source, afterTick);
+    std::cout.clear();
+
+    // Strategies the wrapper does not select, on the same prices
+    PriceWindow window(MAX_HISTORY);
+    MomentumRSIStrategy rsi;
+    BollingerBandsStrategy bb;
+    const IStrategy* strategies[] = {&rsi, &bb};
+    size_t strategySignals = 0;
+    size_t beforeStrategies = 0;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        if (i == WARMUP_TICKS) {
+            beforeStrategies = g_allocations.load();
+        }
+        window.push_back(PriceAt(i));
+        for (const IStrategy* strategy : strategies) {
+            strategySignals += strategy->calculateAction(window) != ActionType::HOLD ? 1 : 0;
+        }
+    }
+    const size_t strategyAllocations = g_allocations.load() - beforeStrategies;
+
+    const PortfolioState& portfolio = ctx.portfolio.writerView();
+    std::printf("Ticks measured:        %zu\n", MEASURED_TICKS);
+    std::printf("Signals executed:      %zu (%u trades)\n", signals, static_cast<unsigned>(portfolio.totalTrades));
+    std::printf("Bars closed:           %zu\n", barsClosed);
+    std::printf("Parse failures:        %zu\n", source.failures());
+    std::printf("Allocations:           %zu on %zu ticks without a signal (%.4f per tick)\n",
+                quietAllocations, quietTicks, quietTicks ? static_cast<double>(quietAllocations) / quietTicks : 0.0);
+    std::printf("                       %zu on ticks with signals (%.4f per signal)\n",
+                signalAllocations, signals ? static_cast<double>(signalAllocations) / signals : 0.0);
+    std::printf("                       %zu in RSI/Bollinger (%zu signals)\n", strategyAllocations, strategySignals);
+
+    if (source.failures() != 0 || signals == 0 || portfolio.totalTrades == 0 ||
+        barsClosed == 0 || quietTicks == 0 || strategySignals == 0)
+    {
+        std::printf("FAIL: harness did not exercise the signal path\n");
+        return 1;
+    }
+    if (quietAllocations != 0 || signalAllocations != 0 || strategyAllocations != 0 ||
+        ctx.signalLog.dropped() != 0 || ctx.executionLog.dropped() != 0) {
+        std::printf("FAIL: steady-state tick path allocates\n");
+        return 1;
+    }
+    std::printf("PASS: steady-state tick path is allocation-free\n");
+    return 0;
+}
@@ -0,0 +1,44 @@
+// BarAggregator checks: bar spec parsing and the OHLCV bars built from a few ticks.
+#include <cstdio>
+#include <vector>
+
+#include "../BarAggregator.h"
+
+namespace {
+
+bool CheckBars()
+{
+    std::vector<BarSpec> specs(2);
+    if (!BarSpec::parse("1s", specs[0]) || !BarSpec::parse("3t", specs[1]) || BarSpec::parse("5x", specs[1])) {
+        std::printf("FAIL: bar specs not parsed\n");
+        return false;
+    }
+    BarAggregator bars;
+    bars.configure(specs, 4);
+    const double prices[] = {10.0, 12.0, 9.0, 11.0, 13.0};
+    for (size_t i = 0; i < 5; ++i) {
+        // 400 ms apart: the 1s bars are [0, 800] and [1200, 1600]
+        bars.onTick(TradeData(prices[i], 1692284400000LL + i * 400, 0, 0, 1.0));
+    }
+    const BarWindow& seconds = bars.series(0, 0)->closed();
+    const BarWindow& ticks = bars.series(0, 1)->closed();
+    if (seconds.size() != 1 || seconds.back().open != 10.0 || seconds.back().high != 12.0 ||
+        seconds.back().low != 9.0 || seconds.back().close != 9.0 || seconds.back().ticks != 3 ||
+        ticks.size() != 1 || ticks.back().volume != 3.0 || bars.series(0, 1)->open().close != 13.0)
+    {
+        std::printf("FAIL: bar aggregator built wrong bars\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    if (!CheckBars()) {
+        return 1;
+    }
+    std::printf("PASS: bar aggregator\n");
+    return 0;
+}
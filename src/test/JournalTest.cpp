@@ -0,0 +1,291 @@
+// Journal round trip through TradeExecutor: trade with the journal on, "crash"
+// (no final snapshot, a corrupt record and a torn write at the tail), recover
+// into a fresh executor, trade on and recover again. Also recovers a snapshot that
+// is ahead of its journal, and a journal whose writer numbered its symbols
+// differently from this process.
+#include <cstdio>
+#include <string>
+
+#include "../TradeExecutor.h"
+#include "TestUtil.h"
+
+LevelMapping customMappings = {
+    {Main,        "Main"},
+    {MarketData,  "Market Data"},
+    {Strategy,    "Strategy"},
+    {Execution,   "Trade Executor"},
+    {DEBUG,       "DEBUG"},
+    {INFO,        "INFO"},
+    {WARN,        "WARN"},
+    {ERROR,       "ERROR"}
+};
+
+namespace {
+
+const char* const JOURNAL_DIR = "output/journal_recovery";
+const char* const AHEAD_JOURNAL_DIR = "output/journal_ahead";
+const char* const FOREIGN_JOURNAL_DIR = "output/journal_foreign";
+
+void RemoveJournal(const std::string& directory)
+{
+    std::remove((directory + "/journal.bin").c_str());
+    std::remove((directory + "/snapshot.bin").c_str());
+}
+
+long long JournalSize(const std::string& directory)
+{
+    std::FILE* file = std::fopen((directory + "/journal.bin").c_str(), "rb");
+    if (file == nullptr) {
+        return -1;
+    }
+    const long long size = FileUtils::FileSize(file);
+    std::fclose(file);
+    return size;
+}
+
+// One engine process: context, journal and executor
+struct Session
+{
+    SystemContext ctx;
+    TradeExecutor executor;
+
+    // The executor only keeps references: the journal is configured before Recover() reads it
+    explicit Session(const char* directory, uint64_t snapshotEvery = 8)
+        : executor(ctx)
+    {
+        ctx.initialCash = 100000.0;
+        ctx.portfolio.reset("USD", toCashUnits(ctx.initialCash));
+        JournalConfig config;
+        config.enabled = true;
+        config.directory = directory;
+        config.sync = false;
+        config.snapshotEvery = snapshotEvery;
+        ctx.journal.configure(config);
+    }
+
+    bool recover() { return executor.Recover() && ctx.journal.start(); }
+
+    void trade(SymbolId symbol, ActionType action, double price)
+    {
+        const InstrumentScale& scale = SymbolTable::instance().scale(symbol);
+        ctx.marks.publish(symbol, scale.toTicks(price));
+        ctx.actionSignal.queue.tryPush(ActionSignal(action, symbol, scale.toTicks(price), scale.toLots(0.01), 0));
+        executor.Poll();
+    }
+
+    // Stops without the final snapshot Finish() would write
+    void crash() { ctx.journal.stop(); }
+
+    // Clean stop: the final snapshot covers every record
+    void shutdown()
+    {
+        executor.Finish();
+        ctx.journal.stop();
+    }
+};
+
+bool SameBooks(const PortfolioState& expected, const PortfolioState& actual, SymbolId symbol)
+{
+    const PortfolioPosition& a = expected.positions[symbol];
+    const PortfolioPosition& b = actual.positions[symbol];
+    return expected.cash[BASE_CURRENCY_ID] == actual.cash[BASE_CURRENCY_ID] && a.quantity == b.quantity &&
+           a.costBasis == b.costBasis && a.realizedPnl == b.realizedPnl &&
+           expected.pnl.realized == actual.pnl.realized && expected.totalTrades == actual.totalTrades &&
+           expected.buyTrades == actual.buyTrades && expected.sellTrades == actual.sellTrades;
+}
+
+bool CheckCrashRecovery()
+{
+    RemoveJournal(JOURNAL_DIR);
+    const SymbolId btc = SymbolTable::instance().intern("BTC");
+    const SymbolId eth = SymbolTable::instance().intern("ETH");
+
+    // First run: enough records for snapshots, and more after the last one
+    PortfolioState beforeCrash;
+    uint64_t lastSequence = 0;
+    {
+        Session session(JOURNAL_DIR);
+        if (!Expect(session.recover(), "empty journal not opened")) {
+            return false;
+        }
+        const double prices[] = {29500.0, 29450.0, 29600.0, 29550.0, 29700.0, 29400.0, 29650.0};
+        for (size_t i = 0; i < 7; ++i) {
+            session.trade(btc, (i % 3 == 2) ? ActionType::SELL : ActionType::BUY, prices[i]);
+        }
+        session.trade(eth, ActionType::BUY, 1850.0);
+        session.crash();
+        beforeCrash = session.ctx.portfolio.snapshot();
+        lastSequence = session.ctx.journal.lastSequence();
+        if (!Expect(beforeCrash.totalTrades == 8 && lastSequence > 16 && session.ctx.journal.durableSequence() == lastSequence,
+                    "first run did not trade or journal")) {
+            return false;
+        }
+    }
+
+    // The crash left a record with a bad checksum and half a record behind
+    const long long intactSize = JournalSize(JOURNAL_DIR);
+    std::FILE* file = std::fopen((std::string(JOURNAL_DIR) + "/journal.bin").c_str(), "ab");
+    JournalRecord corrupt{};
+    corrupt.sequence = lastSequence + 1;
+    corrupt.type = JournalRecordType::FILL;
+    corrupt.quantity = 1000000;
+    corrupt.checksum = 0xDEADBEEF;
+    const bool written = file != nullptr && std::fwrite(&corrupt, sizeof(corrupt), 1, file) == 1 &&
+                         std::fwrite(&corrupt, sizeof(corrupt) / 2, 1, file) == 1;
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+    if (!Expect(written && JournalSize(JOURNAL_DIR) == intactSize + static_cast<long long>(sizeof(corrupt) * 3 / 2),
+                "corrupt tail not written")) {
+        return false;
+    }
+
+    // Second run: the same books, the tail cut off, and new records right after the old ones
+    PortfolioState afterRestart;
+    uint64_t restartSequence = 0;
+    {
+        Session session(JOURNAL_DIR);
+        if (!Expect(session.recover(), "journal not recovered")) {
+            return false;
+        }
+        const PortfolioState recovered = session.ctx.portfolio.snapshot();
+        if (!Expect(SameBooks(beforeCrash, recovered, btc) && SameBooks(beforeCrash, recovered, eth),
+                    "recovered portfolio differs from the one before the crash") ||
+            !Expect(JournalSize(JOURNAL_DIR) == intactSize && session.ctx.journal.lastSequence() == lastSequence,
+                    "corrupt tail not discarded")) {
+            return false;
+        }
+        session.trade(btc, ActionType::SELL, 29800.0);
+        session.crash();
+        afterRestart = session.ctx.portfolio.snapshot();
+        restartSequence = session.ctx.journal.lastSequence();
+    }
+
+    // Third run: every record of both runs replays
+    Session session(JOURNAL_DIR);
+    return Expect(session.recover(), "journal not recovered after the restart") &&
+           Expect(SameBooks(afterRestart, session.ctx.portfolio.snapshot(), btc) &&
+                  session.ctx.journal.lastSequence() == restartSequence && restartSequence > lastSequence,
+                  "records written after recovery not replayed");
+}
+
+bool CheckSnapshotAhead()
+{
+    RemoveJournal(AHEAD_JOURNAL_DIR);
+    const SymbolId btc = SymbolTable::instance().intern("BTC");
+
+    PortfolioState beforeCrash;
+    uint64_t snapshotSequence = 0;
+    {
+        Session session(AHEAD_JOURNAL_DIR, 0);
+        if (!Expect(session.recover(), "empty journal not opened")) {
+            return false;
+        }
+        session.trade(btc, ActionType::BUY, 29500.0);
+        session.trade(btc, ActionType::BUY, 29450.0);
+        session.shutdown();
+        beforeCrash = session.ctx.portfolio.snapshot();
+        snapshotSequence = session.ctx.journal.lastSequence();
+    }
+
+    // An OS crash kept the snapshot but lost all but the first two unsynced records
+    const long long recordBytes = static_cast<long long>(sizeof(JournalRecord));
+    const long long headerBytes = JournalSize(AHEAD_JOURNAL_DIR) - static_cast<long long>(snapshotSequence) * recordBytes;
+    std::FILE* file = std::fopen((std::string(AHEAD_JOURNAL_DIR) + "/journal.bin").c_str(), "r+b");
+    const bool truncated = file != nullptr && FileUtils::TruncateFile(file, headerBytes + 2 * recordBytes);
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+    if (!Expect(truncated && snapshotSequence > 2, "journal not cut short")) {
+        return false;
+    }
+
+    // The snapshot restores the books; the stale records are dropped so new ones sit at their offsets
+    PortfolioState afterRestart;
+    uint64_t restartSequence = 0;
+    {
+        Session session(AHEAD_JOURNAL_DIR, 0);
+        if (!Expect(session.recover(), "journal behind its snapshot not recovered")) {
+            return false;
+        }
+        if (!Expect(SameBooks(beforeCrash, session.ctx.portfolio.snapshot(), btc) &&
+                    session.ctx.journal.lastSequence() == snapshotSequence && JournalSize(AHEAD_JOURNAL_DIR) == headerBytes,
+                    "journal behind its snapshot not restarted after it")) {
+            return false;
+        }
+        session.trade(btc, ActionType::SELL, 29600.0);
+        session.crash();
+        afterRestart = session.ctx.portfolio.snapshot();
+        restartSequence = session.ctx.journal.lastSequence();
+    }
+
+    Session session(AHEAD_JOURNAL_DIR, 0);
+    return Expect(session.recover(), "restarted journal not recovered") &&
+           Expect(SameBooks(afterRestart, session.ctx.portfolio.snapshot(), btc) &&
+                  session.ctx.journal.lastSequence() == restartSequence && restartSequence > snapshotSequence,
+                  "records written after the snapshot not replayed");
+}
+
+bool CheckForeignSymbolIds()
+{
+    // Written by a process that had seen more symbols: its id 40 is XRP
+    RemoveJournal(FOREIGN_JOURNAL_DIR);
+    const SymbolId foreignId = 40;
+    const QtyLots quantity = 5000000;
+    {
+        Journal journal;
+        JournalConfig config;
+        config.enabled = true;
+        config.directory = FOREIGN_JOURNAL_DIR;
+        config.sync = false;
+        journal.configure(config);
+        ExecutorSnapshot snapshot;
+        bool loaded = false;
+        JournalRecoveryStats stats;
+        if (!Expect(journal.open(&snapshot, sizeof(snapshot), loaded) &&
+                    journal.replay([](const JournalRecord&) {}, stats) && journal.start(), "journal not created")) {
+            return false;
+        }
+        JournalRecord name{};
+        name.type = JournalRecordType::SYMBOL;
+        name.symbol = foreignId;
+        setJournalSymbolName(name, "XRP");
+        journal.append(name);
+        JournalRecord fill{};
+        fill.type = JournalRecordType::FILL;
+        fill.symbol = foreignId;
+        fill.side = static_cast<uint8_t>(OrderSide::BUY);
+        fill.price = 5200;
+        fill.quantity = quantity;
+        journal.append(fill);
+        JournalRecord order = fill;
+        order.type = JournalRecordType::ORDER;
+        order.filled = quantity;
+        journal.append(order);
+        journal.stop();
+    }
+
+    Session session(FOREIGN_JOURNAL_DIR, 0);
+    if (!Expect(session.recover(), "foreign journal not recovered")) {
+        return false;
+    }
+    const SymbolId xrp = SymbolTable::instance().find("XRP", 3);
+    const PortfolioState& state = session.ctx.portfolio.writerView();
+    return Expect(xrp != INVALID_SYMBOL_ID && xrp != foreignId && state.positions[xrp].quantity == quantity &&
+                  state.positions[foreignId].quantity == 0 && state.totalTrades == 1,
+                  "fill not mapped to this process's id by symbol name");
+}
+
+} // namespace
+
+int main()
+{
+    LOGINIT(customMappings);
+    Logger::getInstance().setLevel(CustomerLogLevel::ERROR);
+
+    if (!CheckCrashRecovery() || !CheckSnapshotAhead() || !CheckForeignSymbolIds()) {
+        return 1;
+    }
+    std::printf("PASS: journal recovery\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+// OrderBook checks: price-time priority, partial fills, resting remainders,
+// MARKET/IOC remainders and cancels by handle.
+#include <cstdio>
+#include <vector>
+
+#include "../OrderBook.h"
+#include "TestUtil.h"
+
+namespace {
+
+struct Fixture
+{
+    OrderBook book{64, 16};
+    std::vector<BookFill> fills;
+
+    Fixture()
+    {
+        book.recenter(1000);
+        book.setFillHandler([this](const BookFill& fill) { fills.push_back(fill); });
+    }
+};
+
+bool CheckPriceTimePriority()
+{
+    Fixture f;
+    f.book.submit(1, OrderSide::SELL, OrderType::LIMIT, 1001, 5);
+    f.book.submit(2, OrderSide::SELL, OrderType::LIMIT, 1001, 3);
+    f.book.submit(3, OrderSide::SELL, OrderType::LIMIT, 1000, 4);
+    if (!Expect(f.fills.empty() && f.book.restingOrders() == 3 && f.book.bestAsk() == 1000 &&
+                f.book.depthAt(OrderSide::SELL, 1001) == 8, "non-crossing orders did not rest")) {
+        return false;
+    }
+
+    // Best price first (3 at 1000), then 1 before 2 at 1001; 2 is left with 2 lots
+    const BookResult result = f.book.submit(10, OrderSide::BUY, OrderType::LIMIT, 1001, 10);
+    return Expect(result.filled == 10 && result.resting == 0 && result.cancelled == 0 &&
+                  result.handle == INVALID_ORDER_HANDLE, "crossing order not filled in full") &&
+           Expect(f.fills.size() == 3 &&
+                  f.fills[0].makerId == 3 && f.fills[0].price == 1000 && f.fills[0].quantity == 4 &&
+                  f.fills[1].makerId == 1 && f.fills[1].price == 1001 && f.fills[1].quantity == 5 &&
+                  f.fills[2].makerId == 2 && f.fills[2].price == 1001 && f.fills[2].quantity == 1 &&
+                  f.fills[0].takerId == 10 && f.fills[0].takerSide == OrderSide::BUY,
+                  "fills not in price-time priority") &&
+           Expect(f.book.restingOrders() == 1 && f.book.depthAt(OrderSide::SELL, 1001) == 2,
+                  "partially filled maker lost its remainder");
+}
+
+bool CheckPartialFillRests()
+{
+    Fixture f;
+    f.book.submit(1, OrderSide::SELL, OrderType::LIMIT, 1002, 2);
+
+    // 2 of 5 trade at the maker's price; the other 3 rest at the limit
+    const BookResult result = f.book.submit(2, OrderSide::BUY, OrderType::LIMIT, 1003, 5);
+    if (!Expect(result.filled == 2 && result.resting == 3 && result.handle != INVALID_ORDER_HANDLE &&
+                f.fills.size() == 1 && f.fills[0].price == 1002, "partial fill did not rest the remainder") ||
+        !Expect(!f.book.hasAsk() && f.book.hasBid() && f.book.bestBid() == 1003 &&
+                f.book.depthAt(OrderSide::BUY, 1003) == 3, "book does not show the resting remainder")) {
+        return false;
+    }
+
+    // The remainder keeps its place: a later bid at the same price fills after it
+    f.book.submit(3, OrderSide::BUY, OrderType::LIMIT, 1003, 4);
+    f.fills.clear();
+    const BookResult sell = f.book.submit(4, OrderSide::SELL, OrderType::LIMIT, 1003, 5);
+    return Expect(sell.filled == 5 && f.fills.size() == 2 &&
+                  f.fills[0].makerId == 2 && f.fills[0].quantity == 3 &&
+                  f.fills[1].makerId == 3 && f.fills[1].quantity == 2, "resting remainder lost its priority") &&
+           Expect(f.book.depthAt(OrderSide::BUY, 1003) == 2, "second bid not partially filled");
+}
+
+bool CheckMarketAndIoc()
+{
+    Fixture f;
+    const BookResult empty = f.book.submit(1, OrderSide::BUY, OrderType::MARKET, 0, 3);
+    if (!Expect(empty.filled == 0 && empty.cancelled == 3 && f.book.restingOrders() == 0,
+                "MARKET order on an empty book did not cancel")) {
+        return false;
+    }
+
+    f.book.submit(2, OrderSide::SELL, OrderType::LIMIT, 1001, 2);
+    f.book.submit(3, OrderSide::SELL, OrderType::LIMIT, 1004, 2);
+    // IOC takes what is within its limit and cancels the rest instead of resting it
+    const BookResult ioc = f.book.submit(4, OrderSide::BUY, OrderType::IOC, 1002, 5);
+    if (!Expect(ioc.filled == 2 && ioc.cancelled == 3 && ioc.resting == 0 && !f.book.hasBid(),
+                "IOC remainder rested or was filled through its limit")) {
+        return false;
+    }
+    // MARKET ignores the price
+    const BookResult market = f.book.submit(5, OrderSide::BUY, OrderType::MARKET, 0, 3);
+    return Expect(market.filled == 2 && market.cancelled == 1 && f.fills.back().price == 1004,
+                  "MARKET order did not sweep the book");
+}
+
+bool CheckCancel()
+{
+    Fixture f;
+    const BookResult first = f.book.submit(1, OrderSide::BUY, OrderType::LIMIT, 999, 4);
+    const BookResult second = f.book.submit(2, OrderSide::BUY, OrderType::LIMIT, 999, 6);
+    if (!Expect(!f.book.cancel(first.handle, 2), "cancel accepted the wrong order id") ||
+        !Expect(f.book.cancel(first.handle, 1) && f.book.depthAt(OrderSide::BUY, 999) == 6 &&
+                f.book.restingOrders() == 1, "cancel did not remove the order") ||
+        !Expect(!f.book.cancel(first.handle, 1), "order cancelled twice")) {
+        return false;
+    }
+
+    // A filled order's handle is freed; the next resting order may reuse it
+    f.book.submit(3, OrderSide::SELL, OrderType::LIMIT, 999, 6);
+    const BookResult reuse = f.book.submit(4, OrderSide::BUY, OrderType::LIMIT, 998, 1);
+    return Expect(!f.book.cancel(second.handle, 2) && f.book.restingOrders() == 1 &&
+                  f.book.cancel(reuse.handle, 4), "cancel of a filled order touched another order");
+}
+
+} // namespace
+
+int main()
+{
+    if (!CheckPriceTimePriority() || !CheckPartialFillRests() || !CheckMarketAndIoc() || !CheckCancel()) {
+        return 1;
+    }
+    std::printf("PASS: order book\n");
+    return 0;
+}
@@ -0,0 +1,182 @@
+// OrderManager checks: the lifecycle state machine, fills, cancels through the
+// venue, and ids that go stale once their pool slot is recycled.
+#include <cstdio>
+
+#include "../OrderManager.h"
+#include "../SimulatedExchange.h"
+#include "TestUtil.h"
+
+namespace {
+
+struct Fixture
+{
+    OrderManager orders{16, 64};
+    InstrumentScale scale;
+    int fills = 0;
+    QtyLots filledLots = 0;
+
+    Fixture()
+    {
+        orders.setFillHandler([this](const Order&, PriceTicks, QtyLots quantity) {
+            ++fills;
+            filledLots += quantity;
+        });
+    }
+
+    Order& create(QtyLots quantity)
+    {
+        return *orders.create(0, OrderSide::BUY, OrderType::LIMIT, 2950000, quantity, 0);
+    }
+};
+
+bool CheckLifecycle()
+{
+    Fixture f;
+    Order& order = f.create(10);
+    const OrderId id = order.id;
+    if (!Expect(id != INVALID_ORDER_ID && order.state == OrderState::NEW && f.orders.find(id) == &order,
+                "new order not created") ||
+        !Expect(!f.orders.transition(order, OrderState::ACKNOWLEDGED) && order.state == OrderState::NEW &&
+                f.orders.rejectedTransitions() == 1, "NEW -> ACKNOWLEDGED allowed")) {
+        return false;
+    }
+
+    // Sent, 4 filled while matching, the rest resting
+    BookResult result;
+    result.filled = 4;
+    result.resting = 6;
+    result.handle = 7;
+    if (!Expect(f.orders.transition(order, OrderState::PENDING_NEW), "NEW -> PENDING_NEW rejected") ||
+        !Expect(f.orders.applyFill(id, 2950000, 4, f.scale) && order.state == OrderState::PARTIALLY_FILLED &&
+                order.filled == 4 && order.filledNotional == f.scale.notional(2950000, 4) && f.fills == 1,
+                "partial fill not applied")) {
+        return false;
+    }
+    f.orders.applySubmitResult(order, result);
+    if (!Expect(order.state == OrderState::PARTIALLY_FILLED && order.venueHandle == 7,
+                "resting remainder changed the state or lost its handle")) {
+        return false;
+    }
+
+    // More than what remains is refused; the rest fills the order
+    if (!Expect(!f.orders.applyFill(id, 2950000, 7, f.scale) && order.filled == 4 && f.fills == 1,
+                "overfill applied") ||
+        !Expect(f.orders.applyFill(id, 2950000, 6, f.scale) && order.state == OrderState::FILLED &&
+                order.remaining() == 0 && f.filledLots == 10, "final fill not applied") ||
+        !Expect(!f.orders.transition(order, OrderState::CANCELLED) && order.state == OrderState::FILLED,
+                "FILLED -> CANCELLED allowed")) {
+        return false;
+    }
+    f.orders.releaseIfDone(order);
+    return Expect(f.orders.find(id) == nullptr && f.orders.liveOrders() == 0, "filled order not released");
+}
+
+bool CheckCancelledRemainder()
+{
+    Fixture f;
+    Order& order = f.create(5);
+    f.orders.transition(order, OrderState::PENDING_NEW);
+    BookResult result;
+    result.cancelled = 5;
+    f.orders.applySubmitResult(order, result);
+    if (!Expect(order.state == OrderState::CANCELLED, "unfilled IOC not cancelled")) {
+        return false;
+    }
+
+    // A live order stays put
+    Order& live = f.create(5);
+    f.orders.transition(live, OrderState::PENDING_NEW);
+    f.orders.releaseIfDone(live);
+    return Expect(f.orders.find(live.id) == &live && f.orders.liveOrders() == 2, "live order released");
+}
+
+bool CheckCancel()
+{
+    // Resting orders on an in-process venue, wired the way TradeExecutor wires them
+    Fixture f;
+    SimulatedExchange exchange;
+    exchange.setFillHandler([&f](SymbolId, const BookFill& fill) {
+        f.orders.applyFill(fill.takerId, fill.price, fill.quantity, f.scale);
+        f.orders.applyFill(fill.makerId, fill.price, fill.quantity, f.scale);
+    });
+    f.orders.setCancelHandler([&exchange](const Order& order) {
+        return exchange.cancel(order.symbol, order.venueHandle, order.id);
+    });
+    auto submit = [&](Order& order) {
+        f.orders.transition(order, OrderState::PENDING_NEW);
+        f.orders.applySubmitResult(order, exchange.submit(order.symbol, order.id, order.side, order.type,
+                                                          order.price, order.quantity));
+    };
+
+    exchange.book(0).recenter(2950000);
+
+    Order& order = f.create(10);
+    const OrderId id = order.id;
+    if (!Expect(!f.orders.cancel(id) && order.state == OrderState::NEW, "unsent order cancelled")) {
+        return false;
+    }
+    submit(order);
+    if (!Expect(order.state == OrderState::ACKNOWLEDGED && exchange.book(0).restingOrders() == 1,
+                "resting order not acknowledged") ||
+        !Expect(f.orders.cancel(id) && order.state == OrderState::CANCELLED &&
+                exchange.book(0).restingOrders() == 0, "acknowledged order not cancelled on the venue") ||
+        !Expect(!f.orders.cancel(id), "cancelled order cancelled twice")) {
+        return false;
+    }
+    f.orders.releaseIfDone(order);
+
+    // 4 of 10 taken by a crossing order, then the remainder is pulled
+    Order& partial = f.create(10);
+    submit(partial);
+    Order& taker = *f.orders.create(0, OrderSide::SELL, OrderType::IOC, 2950000, 4, 0);
+    submit(taker);
+    if (!Expect(taker.state == OrderState::FILLED && partial.state == OrderState::PARTIALLY_FILLED &&
+                partial.filled == 4, "resting order not partially filled") ||
+        !Expect(f.orders.cancel(partial.id) && partial.state == OrderState::CANCELLED && partial.filled == 4 &&
+                exchange.book(0).restingOrders() == 0, "partially filled order not cancelled")) {
+        return false;
+    }
+
+    // The venue no longer has it: the cancel waits for the execution report
+    Order& gone = f.create(10);
+    submit(gone);
+    exchange.cancel(0, gone.venueHandle, gone.id);
+    return Expect(!f.orders.cancel(gone.id) && gone.state == OrderState::PENDING_CANCEL,
+                  "refused cancel left PENDING_CANCEL") &&
+           Expect(f.orders.applyFill(gone.id, 2950000, 10, f.scale) && gone.state == OrderState::FILLED,
+                  "fill after a refused cancel not applied");
+}
+
+bool CheckStaleIds()
+{
+    Fixture f;
+    Order& first = f.create(10);
+    const OrderId staleId = first.id;
+    f.orders.transition(first, OrderState::PENDING_NEW);
+    f.orders.transition(first, OrderState::REJECTED);
+    f.orders.releaseIfDone(first);
+
+    // The freed slot is handed out again under a new id
+    Order& second = f.create(10);
+    if (!Expect(&second == &first && second.id != staleId, "recycled slot kept the old id") ||
+        !Expect(f.orders.find(staleId) == nullptr && f.orders.find(second.id) == &second,
+                "stale id resolved to the new order")) {
+        return false;
+    }
+    f.orders.transition(second, OrderState::PENDING_NEW);
+    return Expect(!f.orders.applyFill(staleId, 2950000, 10, f.scale) && second.filled == 0 &&
+                  second.state == OrderState::PENDING_NEW && f.fills == 0, "fill for a stale id applied") &&
+           Expect(f.orders.find(INVALID_ORDER_ID) == nullptr && f.orders.find((OrderId(1) << 32) | 0xFFFF) == nullptr,
+                  "invalid or out-of-range id resolved");
+}
+
+} // namespace
+
+int main()
+{
+    if (!CheckLifecycle() || !CheckCancelledRemainder() || !CheckCancel() || !CheckStaleIds()) {
+        return 1;
+    }
+    std::printf("PASS: order manager\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Portfolio checks: cash, average-cost realized P&L, unrealized P&L at the marks,
+// drawdown, and positions quoted in another currency.
+#include <cstdio>
+#include <cstring>
+
+#include "../Portfolio.h"
+#include "TestUtil.h"
+
+namespace {
+
+bool CheckPnl()
+{
+    const SymbolId btc = SymbolTable::instance().intern("BTC");
+    const InstrumentScale& scale = SymbolTable::instance().scale(btc);
+    Portfolio portfolio;
+    portfolio.reset("USD", toCashUnits(10000.0));
+    const PortfolioState& state = portfolio.writerView();
+    const PortfolioPosition& position = state.positions[btc];
+
+    // Long 1 at 100, marked at 110
+    portfolio.applyFill(btc, OrderSide::BUY, scale.toTicks(100.0), scale.toLots(1.0));
+    portfolio.mark(btc, scale.toTicks(110.0));
+    if (!Expect(portfolio.cash(btc) == toCashUnits(9900.0) && position.costBasis == toCashUnits(100.0) &&
+                position.unrealizedPnl == toCashUnits(10.0) && state.pnl.realized == 0 &&
+                state.pnl.equity == toCashUnits(10010.0), "opening fill or mark not valued")) {
+        return false;
+    }
+
+    // Sell 0.4 at 120: realized against the average cost, the rest stays at the mark
+    portfolio.applyFill(btc, OrderSide::SELL, scale.toTicks(120.0), scale.toLots(0.4));
+    if (!Expect(position.quantity == scale.toLots(0.6) && position.realizedPnl == toCashUnits(8.0) &&
+                position.costBasis == toCashUnits(60.0) && position.unrealizedPnl == toCashUnits(6.0) &&
+                state.pnl.realized == toCashUnits(8.0) && state.pnl.unrealized == toCashUnits(6.0) &&
+                state.pnl.equity == toCashUnits(10014.0) && portfolio.cash(btc) == toCashUnits(9948.0),
+                "reducing fill not realized at the average cost")) {
+        return false;
+    }
+
+    // Sell 1 at 90: closes 0.6 at a loss of 6, opens a 0.4 short at 90
+    portfolio.applyFill(btc, OrderSide::SELL, scale.toTicks(90.0), scale.toLots(1.0));
+    if (!Expect(position.quantity == scale.toLots(-0.4) && position.realizedPnl == toCashUnits(2.0) &&
+                position.costBasis == toCashUnits(-36.0) && position.unrealizedPnl == toCashUnits(-8.0) &&
+                state.pnl.equity == toCashUnits(9994.0), "flip not split into close and open")) {
+        return false;
+    }
+    if (!Expect(state.pnl.highWaterMark == toCashUnits(10014.0) && state.pnl.drawdown == toCashUnits(20.0) &&
+                state.pnl.maxDrawdown == toCashUnits(20.0), "drawdown not tracked")) {
+        return false;
+    }
+
+    // The short gains as the price falls; equity agrees with cash + positions at the marks
+    portfolio.mark(btc, scale.toTicks(80.0));
+    const PortfolioState snapshot = portfolio.snapshot();
+    return Expect(position.unrealizedPnl == toCashUnits(4.0) && state.pnl.unrealized == toCashUnits(4.0) &&
+                  state.pnl.equity == toCashUnits(10006.0) && state.pnl.drawdown == toCashUnits(8.0) &&
+                  state.pnl.maxDrawdown == toCashUnits(20.0), "short not marked") &&
+           Expect(Portfolio::valueInBase(snapshot) == snapshot.pnl.equity &&
+                  snapshot.pnl.grossExposure == toCashUnits(32.0) && snapshot.pnl.netExposure == toCashUnits(-32.0),
+                  "equity does not match the valuation");
+}
+
+bool CheckQuoteCurrency()
+{
+    const SymbolId eth = SymbolTable::instance().intern("ETH-EUR");
+    const SymbolId eurUsd = SymbolTable::instance().intern("EUR-USD");
+    const InstrumentScale& scale = SymbolTable::instance().scale(eth);
+    Portfolio portfolio;
+    portfolio.reset("USD", toCashUnits(10000.0));
+    const PortfolioState& state = portfolio.writerView();
+
+    // Booked in EUR; without an EUR rate the P&L cannot be converted yet
+    portfolio.applyFill(eth, OrderSide::BUY, scale.toTicks(2000.0), scale.toLots(1.0));
+    portfolio.mark(eth, scale.toTicks(2100.0));
+    if (!Expect(std::strcmp(portfolio.currencyName(eth), "EUR") == 0 && portfolio.cash(eth) == toCashUnits(-2000.0) &&
+                state.positions[eth].unrealizedPnl == toCashUnits(100.0) && state.pnl.unrealized == 0,
+                "position not booked in its quote currency")) {
+        return false;
+    }
+
+    // The EUR-USD mark sets the rate and converts the EUR P&L
+    portfolio.mark(eurUsd, SymbolTable::instance().scale(eurUsd).toTicks(1.10));
+    uint32_t unconverted = 0;
+    const CashUnits value = Portfolio::valueInBase(portfolio.snapshot(), &unconverted);
+    if (!Expect(state.fxToBase[state.positions[eth].currency] == FX_SCALE / 10 * 11 &&
+                state.pnl.unrealized == toCashUnits(110.0) && state.pnl.equity == toCashUnits(10110.0),
+                "FX mark did not convert the quote currency P&L") ||
+        !Expect(unconverted == 0 && value == state.pnl.equity, "converted valuation does not match equity")) {
+        return false;
+    }
+
+    // Realized in EUR, so held as EUR cash: it follows the rate like the open P&L does
+    portfolio.applyFill(eth, OrderSide::SELL, scale.toTicks(2200.0), scale.toLots(1.0));
+    if (!Expect(state.positions[eth].realizedPnl == toCashUnits(200.0) && state.pnl.realized == toCashUnits(220.0) &&
+                state.pnl.unrealized == 0 && state.pnl.equity == toCashUnits(10220.0), "EUR P&L not realized")) {
+        return false;
+    }
+    portfolio.mark(eurUsd, SymbolTable::instance().scale(eurUsd).toTicks(1.20));
+    return Expect(state.pnl.realized == toCashUnits(240.0) && state.pnl.equity == toCashUnits(10240.0) &&
+                  Portfolio::valueInBase(portfolio.snapshot()) == state.pnl.equity,
+                  "realized P&L not revalued at the new FX rate");
+}
+
+bool CheckUnmarkedQuoteCurrency()
+{
+    const SymbolId sol = SymbolTable::instance().intern("SOL-GBP");
+    Portfolio portfolio;
+    portfolio.reset("USD", toCashUnits(10000.0));
+
+    // Before any fill or mark the executor sees the symbol's own, unfunded currency
+    const CurrencyId currency = portfolio.activate(sol);
+    const PortfolioState& state = portfolio.writerView();
+    return Expect(currency != BASE_CURRENCY_ID && state.positions[sol].currency == currency &&
+                  std::strcmp(portfolio.currencyName(sol), "GBP") == 0 && portfolio.cash(sol) == 0 &&
+                  state.cash[BASE_CURRENCY_ID] == toCashUnits(10000.0) && portfolio.activate(sol) == currency,
+                  "unmarked symbol answered for the base currency");
+}
+
+} // namespace
+
+int main()
+{
+    if (!CheckPnl() || !CheckQuoteCurrency() || !CheckUnmarkedQuoteCurrency()) {
+        return 1;
+    }
+    std::printf("PASS: portfolio\n");
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdio>
+
+// Prints "FAIL: <what>" when the check does not hold; returns the condition so checks chain with ||
+inline bool Expect(bool condition, const char* what)
+{
+    if (!condition) {
+        std::printf("FAIL: %s\n", what);
+    }
+    return condition;
+}
+
+#endif // TEST_UTIL_H
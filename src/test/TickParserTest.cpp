@@ -0,0 +1,72 @@
+// TickParser checks: a well-formed message, fields that must be rejected, and
+// rejected messages that must not use up a symbol id.
+#include <cstdio>
+#include <cstring>
+
+#include "../TickParser.h"
+#include "TestUtil.h"
+
+namespace {
+
+bool Parse(const char* message, TradeData& tick)
+{
+    return TickParser::Parse(message, std::strlen(message), tick);
+}
+
+bool CheckValidMessage()
+{
+    TradeData tick;
+    return Expect(Parse(R"({"symbol": "BTC", "price": 29847.52, "timestamp": 1692284400.123, "seq": 42, "volume": 0.5})", tick) &&
+                  tick.symbol_ == SymbolTable::instance().find("BTC", 3) && tick.price_ == 29847.52 &&
+                  tick.timestamp_ms_ == 1692284400123LL && tick.seq_ == 42 && tick.volume_ == 0.5,
+                  "valid message not parsed");
+}
+
+bool CheckRejectedFields()
+{
+    const char* const rejected[] = {
+        R"({"symbol": "BTC", "price": nan, "timestamp": 1692284400})",
+        R"({"symbol": "BTC", "price": inf, "timestamp": 1692284400})",
+        R"({"symbol": "BTC", "price": -5, "timestamp": 1692284400})",
+        R"({"symbol": "BTC", "price": 0, "timestamp": 1692284400})",
+        R"({"symbol": "BTC", "price": 100, "timestamp": nan})",
+        R"({"symbol": "BTC", "price": 100, "timestamp": -1})",
+        R"({"symbol": "BTC", "price": 100, "timestamp": 1692284400, "seq": nan})",
+        R"({"symbol": "BTC", "price": 100, "timestamp": 1692284400, "seq": -1})",
+        R"({"symbol": "BTC", "price": 100, "timestamp": 1692284400, "volume": nan})",
+        R"({"symbol": "BTC", "price": 100, "timestamp": 1692284400, "volume": x})",
+    };
+    for (const char* message : rejected) {
+        TradeData tick;
+        tick.price_ = 1.0;
+        if (!Parse(message, tick) && tick.price_ == 1.0) {
+            continue;
+        }
+        std::printf("FAIL: accepted %s\n", message);
+        return false;
+    }
+    return true;
+}
+
+bool CheckNoInternOnReject()
+{
+    // Each rejected message names a new symbol; none of them may be interned
+    const size_t symbols = SymbolTable::instance().size();
+    TradeData tick;
+    Parse(R"({"symbol": "BAD1", "price": nan, "timestamp": 1692284400})", tick);
+    Parse(R"({"symbol": "BAD2", "price": 100, "timestamp": 1692284400, "seq": "x"})", tick);
+    Parse(R"({"symbol": "BAD3", "price": 100, "timestamp": 1692284400, "volume": -1})", tick);
+    return Expect(SymbolTable::instance().size() == symbols && SymbolTable::instance().find("BAD2", 4) == INVALID_SYMBOL_ID,
+                  "rejected message interned its symbol");
+}
+
+} // namespace
+
+int main()
+{
+    if (!CheckValidMessage() || !CheckRejectedFields() || !CheckNoInternOnReject()) {
+        return 1;
+    }
+    std::printf("PASS: tick parser\n");
+    return 0;
+}